@@ -19,6 +19,7 @@
 #include "CWiiRemoteManager.h"
 #include "CWiiRemoteProfile.h"
 #include "Motions\BaseMotion.h"
+#include "Motions\GestureRecognizer.h"
 
 // Crysis files
 #include "Game.h"
@@ -30,6 +31,20 @@
 #include "Fists.h"
 #include "Binocular.h"
 
+// Calibration read from each remote, so reconnects don't wait on it
+#define CALIBRATION_CACHE_FILE ("%USER%/wiicalibration.txt")
+
+// Double-tapping the lock view button forces the lock while held
+#define FORCELOCK_COMBO ("ForceLockView")
+#define FORCELOCK_TAP_WINDOW (0.25f)
+
+// Profile layer names of each state, i.e. <layer name="LandVehicle"> in the profile
+static char const* szStateLayerNames[STATE_MAX] =
+{
+	"Player", "NanoSuitMenu", "Binoculars", "WeaponMenu",
+	"LandVehicle", "SeaVehicle", "HeliVehicle", "VTOLVehicle",
+};
+
 ////////////////////////////////////////////////////
 // GetPlayer
 //
@@ -40,6 +55,24 @@ CPlayer* GetPlayer(void)
 	return static_cast<CPlayer*>(g_pGame->GetIGameFramework()->GetClientActor());
 }
 
+////////////////////////////////////////////////////
+// GetForceLockCombo
+//
+// Purpose: Get the combo that forces lock view
+//
+// In:	nButton - Lock view button, without the
+//			nunchuk bit
+////////////////////////////////////////////////////
+SWR_WiiButton_Combo GetForceLockCombo(unsigned int nButton)
+{
+	SWR_WiiButton_Combo combo;
+	combo.nType = WR_COMBO_TAP;
+	combo.nButtons[0] = nButton;
+	combo.nCount = 2;
+	combo.fWindow = FORCELOCK_TAP_WINDOW;
+	return combo;
+}
+
 ////////////////////////////////////////////////////
 // UsingIRSensor
 //
@@ -113,7 +146,7 @@ struct SWiiRemoteHIDListener : public IWR_HIDControllerListener
 	virtual void OnRemoteInitialized(IWR_WiiRemote* pRemote, RemoteID nID)
 	{
 		CryLogAlways("[WiiRemoteManager] Wii Remote Initialized!");
-		pRemote->AddListener(&g_WiiRemoteListener);
+		pRemote->AddListener(&g_WiiRemoteListener, WR_REMOTEEVENT_DEFAULT&~WR_REMOTEEVENT_REPORTCHANGED);
 		pRemote->SetConnectionTimeout(5.0f);
 
 		pManager->SetRemote(pRemote);
@@ -133,12 +166,14 @@ struct SWiiInputListener : public IWR_WiiExtensionListener, public IWR_WiiButton
 	bool bInGesture;
 	int nState;
 	int nEndLifetime, nExtensionEndLifetime;
+	bool bCommitted, bExtensionCommitted;
 
 	SWiiInputListener(void)
 	{
 		bInGesture = false;
 		nState = STATE_PLAYER;
 		nEndLifetime = nExtensionEndLifetime = 0;
+		bCommitted = bExtensionCommitted = false;
 	}
 
 	// IWR_WiiButtonsListener
@@ -147,18 +182,22 @@ struct SWiiInputListener : public IWR_WiiExtensionListener, public IWR_WiiButton
 
 	// IWR_WiiMotionListener
 	virtual void OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion);
-	virtual void OnMotionStart(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion);
+	virtual void OnMotionStart(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& onset);
 	virtual void OnMotionUpdate(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion);
 	virtual void OnMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion);
+	virtual void OnMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion);
+	virtual void OnMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& motions);
 
 	// IWR_WiiExtensionListener
 	virtual void OnExtensionButton(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, unsigned int nButton, int nStatus, bool bDown);
 	virtual void OnExtensionAction(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, char const* szAction, ActionID nActionID, int nStatus, bool bDown);
 	virtual void OnExtensionSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion);
-	virtual void OnExtensionMotionStart(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion);
+	virtual void OnExtensionMotionStart(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& onset);
 	virtual void OnExtensionMotionUpdate(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion);
 	virtual void OnExtensionMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion);
+	virtual void OnExtensionMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion);
 	virtual void OnExtensionAnalogUpdate(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, int nStickID, float fX, float fY);
+	virtual void OnExtensionMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& motions);
 
 	// IWR_WiiSensorListener
 	virtual void OnEnterScreen(IWR_WiiRemote *pRemote, IWR_WiiSensor *pSensor, float fX, float fY);
@@ -168,6 +207,51 @@ struct SWiiInputListener : public IWR_WiiExtensionListener, public IWR_WiiButton
 	virtual void OnCommonButton(IWR_WiiRemote *pRemote, unsigned int nButton, int nStatus, bool bDown, bool bExtension);
 } g_WiiInputListener;
 
+// Input read from the remote at the start of the frame
+static SInputSnapshot g_WiiInput;
+
+////////////////////////////////////////////////////
+// Game State Listener
+////////////////////////////////////////////////////
+struct SWiiGameStateListener : public IItemSystemListener
+{
+	CWiiRemoteManager *pManager;
+	bool bRegistered;
+
+	SWiiGameStateListener(void)
+	{
+		bRegistered = false;
+	}
+
+	// IItemSystemListener
+	virtual void OnSetActorItem(IActor *pActor, IItem *pItem) { OnActorItemChanged(pActor); }
+	virtual void OnDropActorItem(IActor *pActor, IItem *pItem) { OnActorItemChanged(pActor); }
+	virtual void OnSetActorAccessory(IActor *pActor, IItem *pItem) {}
+	virtual void OnDropActorAccessory(IActor *pActor, IItem *pItem) {}
+
+	void OnActorItemChanged(IActor *pActor)
+	{
+		// Only the client's item matters, i.e. raising the binoculars
+		if (NULL != pActor && pActor == g_pGame->GetIGameFramework()->GetClientActor())
+			pManager->InvalidateState();
+	}
+} g_WiiGameStateListener;
+
+////////////////////////////////////////////////////
+// Profile State Listener
+////////////////////////////////////////////////////
+struct SWiiProfileStateListener : public IWiiRemoteStateListener
+{
+	CWiiRemoteManager *pManager;
+
+	virtual void OnStateChanged(int nOldState, int nNewState)
+	{
+		// Use the profile layer of the new state
+		g_WiiRemoteProfile->SelectLayer(pManager->m_nStateLayers[nNewState]);
+		pManager->RegisterForceLockCombo();
+	}
+} g_WiiProfileStateListener;
+
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
@@ -190,15 +274,28 @@ CWiiRemoteManager::CWiiRemoteManager(CGame *pGame)
 	g_WiiRemoteListener.pManager = this;
 	g_WiiRemoteHIDListener.pManager = this;
 	g_WiiInputListener.pManager = this;
+	g_WiiGameStateListener.pManager = this;
+	g_WiiProfileStateListener.pManager = this;
 
 	m_bSprint = false;
 	m_bLockView = false;
 	m_bLockedNPC = false;
 	m_bForceLockView = false;
+	m_nForceLockButton = 0;
 	m_pLockedEntity = 0;
-	m_fLastLockRelease = 0;
 	m_fFreezeMovement = 0;
+	for (int i = 0; i < STATE_MAX; i++)
+		m_nStateLayers[i] = 0;
 	m_vLockedEntityOffset.Set(0,0,0);
+	m_bIRCursorLive = false;
+	m_nLockRaySeq = 0;
+	m_bLockRayPending = m_bLockRayReady = m_bLockRayInFlight = false;
+	m_vLockRayPos.Set(0,0,0);
+	m_vLockRayDir.Set(0,0,0);
+
+	m_bStateDirty = true;
+	m_nStatePlayerId = m_nStateItemId = 0;
+	AddStateListener(&g_WiiProfileStateListener);
 }
 
 ////////////////////////////////////////////////////
@@ -254,7 +351,9 @@ void CWiiRemoteManager::Initialize(void)
 		pUI->GetTextureSize(m_nIRDotTexture, m_fIRDotWidth, m_fIRDotHeight);
 	}
 
-	// Create profile
+	// Create profile, with a layer for each state
+	for (int i = 0; i < STATE_MAX; i++)
+		m_nStateLayers[i] = g_WiiRemoteProfile->RegisterLayer(szStateLayerNames[i]);
 	g_WiiRemoteProfile->SetToDefault();
 	if (false == g_WiiRemoteProfile->LoadCFG())
 	{
@@ -262,6 +361,20 @@ void CWiiRemoteManager::Initialize(void)
 		if (false == g_WiiRemoteProfile->SaveCFG())
 			CryWarning(VALIDATOR_MODULE_GAME, VALIDATOR_ERROR, "Failed to save Wiisis Remote Configuration");
 	}
+	g_WiiRemoteProfile->SelectLayer(m_nStateLayers[g_WiiInputListener.nState]);
+	g_WiiRemoteProfile->StartWatching();
+
+	// Detect the state again when the client switches items
+	if (IItemSystem *pItemSystem = m_pGame->GetIGameFramework()->GetIItemSystem())
+	{
+		pItemSystem->RegisterListener(&g_WiiGameStateListener);
+		g_WiiGameStateListener.bRegistered = true;
+	}
+	InvalidateState();
+
+	// Lock view rays are queued, results come back as logged events
+	gEnv->pPhysicalWorld->AddEventClient(EventPhysRWIResult::id, OnLockRayResult, 1);
+	m_TargetSelector.Initialize();
 
 	// Add error listener
 	m_pWR->AddErrorListener(&g_WiiRemoteErrorListener);
@@ -275,6 +388,14 @@ void CWiiRemoteManager::Initialize(void)
 		CryError("[WiiRemoteManager] Failed to initialize core files!");
 		return;
 	}
+	if (true == CHECK_PROFILE_BOOL(ThreadedInput) && false == m_pWR->SetThreadedInput(true))
+		CryLogAlways("[WiiRemoteManager] Failed to start the input thread, updating the remote on the game thread");
+
+	// Load cached calibration
+	char path[_MAX_PATH];
+	const char* szAdjustedPath = gEnv->pCryPak->AdjustFileName(CALIBRATION_CACHE_FILE,path,(ICryPak::FLAGS_NO_MASTER_FOLDER_MAPPING|ICryPak::FLAGS_FOR_WRITING));
+	m_pWR->pCalibrationCache->Load(szAdjustedPath);
+
 	// Find a remote
 	CryLogAlways("[WiiRemoteManager] Pooling for Wii Remote devices...");
 	m_pWR->pHIDController->ClearFoundRemotes();
@@ -294,6 +415,10 @@ void CWiiRemoteManager::Initialize(void)
 		}
 		p = p->m_pNext;
 	}
+
+	// Load recorded gestures for the template motions
+	CGestureRecognizer::GetInstance(WIIMOTE)->LoadTemplates(GESTURE_TEMPLATE_FILE);
+	CGestureRecognizer::GetInstance(NUNCHUK)->LoadTemplates(GESTURE_TEMPLATE_FILE);
 }
 
 ////////////////////////////////////////////////////
@@ -302,6 +427,17 @@ void CWiiRemoteManager::Shutdown(void)
 	EditorResetGame(false);
 
 	// Cleanup
+	g_WiiRemoteProfile->StopWatching();
+	if (true == g_WiiGameStateListener.bRegistered)
+	{
+		if (IItemSystem *pItemSystem = m_pGame->GetIGameFramework()->GetIItemSystem())
+			pItemSystem->UnregisterListener(&g_WiiGameStateListener);
+		g_WiiGameStateListener.bRegistered = false;
+	}
+	CancelLockRays();
+	m_TargetSelector.Shutdown();
+	if (NULL != gEnv->pPhysicalWorld)
+		gEnv->pPhysicalWorld->RemoveEventClient(EventPhysRWIResult::id, OnLockRayResult, 1);
 	CryLogAlways("[WiiRemoteManager] Shutting down Core files...");
 	m_pWR->pHIDController->RemoveListener(&g_WiiRemoteHIDListener);
 	m_pWR->Shutdown();
@@ -314,15 +450,28 @@ void CWiiRemoteManager::Shutdown(void)
 		SAFE_DELETE(*itMotion);
 	m_WiimoteMotions.clear();
 	m_NunchukMotions.clear();
+	CGestureRecognizer::GetInstance(WIIMOTE)->ClearTemplates();
+	CGestureRecognizer::GetInstance(NUNCHUK)->ClearTemplates();
 }
 
 ////////////////////////////////////////////////////
 void CWiiRemoteManager::Update(bool bHaveFocus, int nUpdateFlags)
 {
+	// Apply a reloaded profile before anything reads it this frame
+	if (true == g_WiiRemoteProfile->Update() && NULL != m_pRemote)
+	{
+		ApplyProfileSettings(m_pRemote);
+		RegisterForceLockCombo();
+	}
+
 	// Update the core
 	m_pWR->Update();
 	float fCurrTime = m_pWR->pTimer->GetCurrTime();
 
+	// Take the remote's input for this frame, the input thread may already be parsing the next
+	if (NULL == m_pRemote || false == m_pRemote->GetSnapshot(g_WiiInput))
+		memset(&g_WiiInput, 0, sizeof(SInputSnapshot));
+
 	// Don't continue if master disabled
 	if (false == IsMasterEnabled()) return;
 
@@ -353,73 +502,25 @@ void CWiiRemoteManager::Update(bool bHaveFocus, int nUpdateFlags)
 	CPlayer *pPlayer = GetPlayer();
 	if (NULL == pPlayer) return;
 
-	// Check which state we are in
-	int nNewState = -1;
-	int nOpenedMenu = (m_pGame->GetHUD() ? m_pGame->GetHUD()->GetOpenedMenu() : CHUD::MENU_NONE);
+	// Check which state we are in, the events that change it mark it dirty
 	CItem *pCurrentItem = (CItem*)pPlayer->GetCurrentItem();
-	if (nOpenedMenu == CHUD::MENU_NANOSUIT)
+	EntityId nCurrentItemId = (NULL != pCurrentItem ? pCurrentItem->GetEntityId() : 0);
+	if (pPlayer->GetEntityId() != m_nStatePlayerId || nCurrentItemId != m_nStateItemId)
+		m_bStateDirty = true;
+	if (true == m_bStateDirty)
 	{
-		// In nano suit menu
-		nNewState = STATE_NANOSUITMENU;
-	}
-	else if (nOpenedMenu == CHUD::MENU_WEAPON)
-	{
-		// In weapon menu
-		nNewState = STATE_WEAPONMENU;
-	}
-	else
-	{
-		// Check if they have binoculars up
-		if (NULL != pCurrentItem)
+		int nNewState = DetectState(pPlayer, pCurrentItem);
+		if (-1 == nNewState)
 		{
-			CBinocular *pBinoculars = static_cast<CBinocular*>(pPlayer->GetItemByClass(CItem::sBinocularsClass));
-			if (NULL != pBinoculars && pCurrentItem->GetEntityId() == pBinoculars->GetEntityId())
-				nNewState = STATE_BINOCULARS;
-		}
-		if (nNewState == -1)
-		{
-			// Check if in vehicle
-			if (pPlayer->GetLinkedVehicle())
-			{
-				// Check type
-				IVehicleMovement *pMovement = pPlayer->GetLinkedVehicle()->GetMovement();
-				switch (pMovement->GetMovementType())
-				{
-					case IVehicleMovement::eVMT_Land:
-						nNewState = STATE_LANDVEHICLE;
-					break;
-
-					case IVehicleMovement::eVMT_Sea:
-					case IVehicleMovement::eVMT_Amphibious:
-						nNewState = STATE_SEAVEHICLE;
-					break;
-
-					case IVehicleMovement::eVMT_Air:
-					{
-						// Test if it is VTOL or not
-						CVehicleMovementHelicopter *pHeli = (CVehicleMovementHelicopter*)(pMovement);
-						nNewState = (false==pHeli->IsVTOL()?STATE_HELIVEHICLE:STATE_VTOLVEHICLE);
-					}
-					break;
-
-					case IVehicleMovement::eVMT_Other:
-					default:
-					{
-						// Kill movement controls
-						SetMasterEnabled(false);
-						return;
-					};
-					break;
-				}
-			}
-			else
-			{
-				// No state yet found, so must just be a player
-				nNewState = STATE_PLAYER;
-			}
+			// Kill movement controls
+			SetMasterEnabled(false);
+			return;
 		}
+		m_bStateDirty = false;
+		m_nStatePlayerId = pPlayer->GetEntityId();
+		m_nStateItemId = nCurrentItemId;
+		SetState(nNewState);
 	}
-	g_WiiInputListener.nState = nNewState;
 
 	if (true == bHaveFocus)
 	{
@@ -487,6 +588,102 @@ void CWiiRemoteManager::OnWeaponShoot(unsigned int nShooterId)
 	Rumble(RUMBLE_FIRE_WEAPON_TIMER);
 }
 
+////////////////////////////////////////////////////
+void CWiiRemoteManager::InvalidateState(void)
+{
+	m_bStateDirty = true;
+}
+
+////////////////////////////////////////////////////
+int CWiiRemoteManager::GetState(void) const
+{
+	return g_WiiInputListener.nState;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteManager::AddStateListener(IWiiRemoteStateListener *pListener)
+{
+	if (NULL == pListener) return;
+	m_StateListeners.remove(pListener);
+	m_StateListeners.push_back(pListener);
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteManager::RemoveStateListener(IWiiRemoteStateListener *pListener)
+{
+	m_StateListeners.remove(pListener);
+}
+
+////////////////////////////////////////////////////
+int CWiiRemoteManager::DetectState(CPlayer *pPlayer, CItem *pCurrentItem) const
+{
+	int nOpenedMenu = (m_pGame->GetHUD() ? m_pGame->GetHUD()->GetOpenedMenu() : CHUD::MENU_NONE);
+	if (nOpenedMenu == CHUD::MENU_NANOSUIT)
+	{
+		// In nano suit menu
+		return STATE_NANOSUITMENU;
+	}
+	if (nOpenedMenu == CHUD::MENU_WEAPON)
+	{
+		// In weapon menu
+		return STATE_WEAPONMENU;
+	}
+
+	// Check if they have binoculars up
+	if (NULL != pCurrentItem)
+	{
+		CBinocular *pBinoculars = static_cast<CBinocular*>(pPlayer->GetItemByClass(CItem::sBinocularsClass));
+		if (NULL != pBinoculars && pCurrentItem->GetEntityId() == pBinoculars->GetEntityId())
+			return STATE_BINOCULARS;
+	}
+
+	// Check if in vehicle
+	IVehicle *pVehicle = pPlayer->GetLinkedVehicle();
+	if (NULL == pVehicle)
+	{
+		// No state yet found, so must just be a player
+		return STATE_PLAYER;
+	}
+
+	// Check type
+	IVehicleMovement *pMovement = pVehicle->GetMovement();
+	switch (pMovement->GetMovementType())
+	{
+		case IVehicleMovement::eVMT_Land:
+			return STATE_LANDVEHICLE;
+
+		case IVehicleMovement::eVMT_Sea:
+		case IVehicleMovement::eVMT_Amphibious:
+			return STATE_SEAVEHICLE;
+
+		case IVehicleMovement::eVMT_Air:
+		{
+			// Test if it is VTOL or not
+			CVehicleMovementHelicopter *pHeli = (CVehicleMovementHelicopter*)(pMovement);
+			return (false==pHeli->IsVTOL()?STATE_HELIVEHICLE:STATE_VTOLVEHICLE);
+		}
+	}
+
+	// Remote can't drive it
+	return -1;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteManager::SetState(int nNewState)
+{
+	int nOldState = g_WiiInputListener.nState;
+	g_WiiInputListener.nState = nNewState;
+	if (nNewState == nOldState) return;
+
+	// Step past each listener first so it may remove itself
+	StateListenerList::iterator itListener = m_StateListeners.begin();
+	while (itListener != m_StateListeners.end())
+	{
+		IWiiRemoteStateListener *pListener = *itListener++;
+		pListener->OnStateChanged(nOldState, nNewState);
+	}
+}
+
 ////////////////////////////////////////////////////
 void CWiiRemoteManager::UpdateHUD(CHUD *pHUD)
 {
@@ -502,6 +699,7 @@ void CWiiRemoteManager::UpdateHUD(CHUD *pHUD)
 			if (NULL != pH && true == pH->IRIsEnabled())
 			{
 				Vec3 vPos = pH->IRGetCursorPos();
+				PredictCursor(vPos);
 				vPos.x *= 800.f;
 				vPos.y *= 600.f;
 				pUI->DrawImageCentered(m_nIRDotTexture, vPos.x/*-m_fIRDotWidth*0.5f*/, vPos.y/*-m_fIRDotHeight*0.5f*/,
@@ -543,6 +741,8 @@ void CWiiRemoteManager::UpdateHUD(CHUD *pHUD)
 ////////////////////////////////////////////////////
 void CWiiRemoteManager::EditorResetGame(bool bStart)
 {
+	// Keep the input thread off the remote while we poke it
+	m_pWR->LockInput();
 	if (false == bStart)
 	{
 		// If we have the remote, turn its LEDs off
@@ -561,6 +761,7 @@ void CWiiRemoteManager::EditorResetGame(bool bStart)
 		}
 		SetMasterEnabled(true);
 	}
+	m_pWR->UnlockInput();
 }
 
 ////////////////////////////////////////////////////
@@ -569,6 +770,8 @@ void CWiiRemoteManager::SetMasterEnabled(bool bOn)
 	if (NULL == m_pRemote) return;
 
 	m_bMasterEnabled = bOn;
+	if (true == bOn)
+		InvalidateState();
 	if (CPlayer *pPlayer = GetPlayer())
 		if (IGameObject *pGameObject = pPlayer->GetGameObject())
 		{
@@ -696,12 +899,19 @@ void SWiiRemoteListener::OnConnect(IWR_WiiRemote *pRemote)
 	pRemote->GetButtonHelper()->EnableBufferedInput(true);
 	pRemote->GetMotionHelper()->Calibrate();
 	pRemote->GetMotionHelper()->SetMotionSize(10);
+	pManager->ApplyProfileSettings(pRemote);
 
 	// Turn on all LEDs
 	pRemote->SetLEDs(WR_LED_ALL);
 
 	// Listeners
-	pRemote->GetButtonHelper()->AddListener(&g_WiiInputListener);
+	pRemote->GetButtonHelper()->AddListener(&g_WiiInputListener, WR_BUTTONEVENT_BUTTON|WR_BUTTONEVENT_ACTION);
+
+	// Combos
+	const unsigned int nLockButton = CHECK_PROFILE_BUTTON(LockView);
+	if (NUNCHUK_BIT != (nLockButton&NUNCHUK_BIT))
+		pRemote->GetButtonHelper()->RegisterCombo(FORCELOCK_COMBO, GetForceLockCombo(nLockButton));
+	pManager->m_nForceLockButton = nLockButton;
 	pRemote->GetMotionHelper()->AddListener(&g_WiiInputListener);
 	pRemote->GetSensorHelper()->AddListener(&g_WiiInputListener);
 
@@ -757,9 +967,15 @@ void SWiiRemoteListener::OnExtensionPluggedIn(IWR_WiiRemote *pRemote, IWR_WiiExt
 	CWR_WiiNunchuk *pNunchuk = (CWR_WiiNunchuk*)pExtension;
 	pNunchuk->EnableBufferedInput(true);
 	pNunchuk->Calibrate();
+	pManager->ApplyProfileSettings(pRemote);
 
 	// Add listener
-	pNunchuk->AddListener(&g_WiiInputListener);
+	pNunchuk->AddListener(&g_WiiInputListener, WR_EXTEVENT_DEFAULT&~WR_EXTEVENT_ANALOGUPDATE);
+
+	// Combos
+	const unsigned int nLockButton = CHECK_PROFILE_BUTTON(LockView);
+	if (NUNCHUK_BIT == (nLockButton&NUNCHUK_BIT))
+		pNunchuk->RegisterCombo(FORCELOCK_COMBO, GetForceLockCombo(nLockButton&~NUNCHUK_BIT));
 }
 
 ////////////////////////////////////////////////////
@@ -876,21 +1092,8 @@ void SWiiInputListener::OnCommonButton(IWR_WiiRemote *pRemote, unsigned int nBut
 		{
 			pManager->m_pLockedEntity = NULL; // Lost locked entity
 			pManager->m_bLockedNPC = false;
-		}
-
-		// Check if force lock
-		if (true == bDown)
-		{
-			if (pManager->m_pWR->pTimer->GetCurrTime() - pManager->m_fLastLockRelease <= 0.25f)
-				pManager->m_bForceLockView = true;
-		}
-		else
-		{
-			// If the button is up, mark when
-			if (false == pManager->m_bForceLockView)
-				pManager->m_fLastLockRelease = pManager->m_pWR->pTimer->GetCurrTime();
-			else
-				pManager->m_bForceLockView = false;
+			pManager->m_bForceLockView = false;
+			pManager->CancelLockRays();
 		}
 	}
 
@@ -1285,13 +1488,21 @@ void SWiiInputListener::OnCommonButton(IWR_WiiRemote *pRemote, unsigned int nBut
 ////////////////////////////////////////////////////
 void SWiiInputListener::OnAction(IWR_WiiRemote *pRemote, IWR_WiiButtons *pButtons, char const* szAction, ActionID nActionID, int nStatus, bool bDown)
 {
+	if (NULL == pManager || false == pManager->IsMasterEnabled()) return;
 
+	// Force lock view, while the second tap is held
+	if (0 == strcmp(FORCELOCK_COMBO, szAction) && NUNCHUK_BIT != (CHECK_PROFILE_BUTTON(LockView)&NUNCHUK_BIT))
+		pManager->m_bForceLockView = (WR_BUTTONSTATUS_PUSHED == nStatus || WR_BUTTONSTATUS_DOWN == nStatus);
 }
 
 ////////////////////////////////////////////////////
 void SWiiInputListener::OnExtensionAction(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, char const* szAction, ActionID nActionID, int nStatus, bool bDown)
 {
+	if (NULL == pManager || false == pManager->IsMasterEnabled()) return;
 
+	// Force lock view, while the second tap is held
+	if (0 == strcmp(FORCELOCK_COMBO, szAction) && NUNCHUK_BIT == (CHECK_PROFILE_BUTTON(LockView)&NUNCHUK_BIT))
+		pManager->m_bForceLockView = (WR_BUTTONSTATUS_PUSHED == nStatus || WR_BUTTONSTATUS_DOWN == nStatus);
 }
 
 ////////////////////////////////////////////////////
@@ -1339,7 +1550,7 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 						Vec3 vForward = info.aimDirection;
 						Vec3 vPlanarForward(vForward.x,vForward.y,0.0f);
 						const float fPitch = acosf(vForward.Dot(vPlanarForward)) * (vForward.z < 0.0f ? -1.0f : 1.0f);
-						const float fMotionPitch = DEG2RAD(180.0f) * (motion.fPitch / DEG2RAD(CHECK_PROFILE_FLOAT(LookUpMaxTilt)));
+						const float fMotionPitch = DEG2RAD(180.0f) * (motion.fPitch / CHECK_PROFILE_RADIANS(LookUpMaxTilt));
 						const float fDelta = (fMotionPitch * (true == CHECK_PROFILE_BOOL(InverseLook) ? -1.0f : 1.0f)) - fPitch;
 						float fLookUp = 0.0f;
 						if (RAD2DEG(fabs(fDelta)) >= (CHECK_PROFILE_FLOAT(LookUpError) * (180.0f/CHECK_PROFILE_FLOAT(LookUpMaxTilt))))
@@ -1350,8 +1561,8 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 
 						// Turn
 						float fTurn = 0.0f;
-						const float fTurnMin = CHECK_PROFILE_FLOAT(TurnTilt);
-						if (fabs(motion.fRoll) >= DEG2RAD(fTurnMin))
+						const float fTurnMin = CHECK_PROFILE_RADIANS(TurnTilt);
+						if (fabs(motion.fRoll) >= fTurnMin)
 						{
 							fTurn = -motion.fRoll*CHECK_PROFILE_FLOAT(TurnSensitivity);
 						}
@@ -1368,15 +1579,15 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 						Vec3 vForward = info.aimDirection;
 						Vec3 vPlanarForward(vForward.x,vForward.y,0.0f);
 						const float fPitch = acosf(vForward.Dot(vPlanarForward)) * (vForward.z < 0.0f ? -1.0f : 1.0f);
-						const float fMotionPitch = DEG2RAD(180.0f) * (motion.fPitch / DEG2RAD(CHECK_PROFILE_FLOAT(LookUpMaxTilt)));
+						const float fMotionPitch = DEG2RAD(180.0f) * (motion.fPitch / CHECK_PROFILE_RADIANS(LookUpMaxTilt));
 						const float fDelta = (fMotionPitch * (true == CHECK_PROFILE_BOOL(InverseLook) ? -1.0f : 1.0f)) - fPitch;
 						float fLookUp = 0.0f;
 						if (RAD2DEG(fabs(fDelta)) >= (CHECK_PROFILE_FLOAT(LookUpError) * (180.0f/CHECK_PROFILE_FLOAT(LookUpMaxTilt))))
 						{
 							fMovePitch = fDelta * CHECK_PROFILE_FLOAT(SoftLock_LookUpSensitivity);
 						}
-						const float fTurnMin = CHECK_PROFILE_FLOAT(TurnTilt);
-						if (fabs(motion.fRoll) >= DEG2RAD(fTurnMin))
+						const float fTurnMin = CHECK_PROFILE_RADIANS(TurnTilt);
+						if (fabs(motion.fRoll) >= fTurnMin)
 						{
 							fMoveRoll = -motion.fRoll*CHECK_PROFILE_FLOAT(SoftLock_TurnSensitivity);
 						}
@@ -1429,7 +1640,7 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 						Vec3 vForward = info.aimDirection;
 						Vec3 vPlanarForward(vForward.x,vForward.y,0.0f);
 						const float fPitch = acosf(vForward.Dot(vPlanarForward)) * (vForward.z < 0.0f ? -1.0f : 1.0f);
-						const float fMotionPitch = DEG2RAD(180.0f) * (motion.fPitch / DEG2RAD(CHECK_PROFILE_FLOAT(Veh_LookUpMaxTilt)));
+						const float fMotionPitch = DEG2RAD(180.0f) * (motion.fPitch / CHECK_PROFILE_RADIANS(Veh_LookUpMaxTilt));
 						const float fDelta = (fMotionPitch * (true == CHECK_PROFILE_BOOL(Veh_InverseLook) ? -1.0f : 1.0f)) - fPitch;
 						float fLookUp = 0.0f;
 						if (RAD2DEG(fabs(fDelta)) >= (CHECK_PROFILE_FLOAT(Veh_LookUpError) * (180.0f/CHECK_PROFILE_FLOAT(Veh_LookUpMaxTilt))))
@@ -1440,8 +1651,8 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 
 						// Turn
 						float fTurn = 0.0f;
-						const float fTurnMin = CHECK_PROFILE_FLOAT(Veh_TurnTilt);
-						if (fabs(motion.fRoll) >= DEG2RAD(fTurnMin))
+						const float fTurnMin = CHECK_PROFILE_RADIANS(Veh_TurnTilt);
+						if (fabs(motion.fRoll) >= fTurnMin)
 						{
 							fTurn = motion.fRoll*CHECK_PROFILE_FLOAT(Veh_TurnSensitivity);
 						}
@@ -1477,15 +1688,15 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 					Vec3 vForward = info.aimDirection;
 					Vec3 vPlanarForward(vForward.x,vForward.y,0.0f);
 					const float fPitch = acosf(vForward.Dot(vPlanarForward)) * (vForward.z < 0.0f ? -1.0f : 1.0f);
-					const float fMotionPitch = DEG2RAD(180.0f) * (motion.fPitch / DEG2RAD(CHECK_PROFILE_FLOAT(Veh_LookUpMaxTilt)));
+					const float fMotionPitch = DEG2RAD(180.0f) * (motion.fPitch / CHECK_PROFILE_RADIANS(Veh_LookUpMaxTilt));
 					const float fDelta = (fMotionPitch * (true == CHECK_PROFILE_BOOL(Veh_InverseLook) ? -1.0f : 1.0f)) - fPitch;
 					float fLookUp = 0.0f;
 					if (RAD2DEG(fabs(fDelta)) >= (CHECK_PROFILE_FLOAT(Veh_LookUpError) * (180.0f/CHECK_PROFILE_FLOAT(Veh_LookUpMaxTilt))))
 					{
 						fMovePitch = fDelta * CHECK_PROFILE_FLOAT(SoftLock_LookUpSensitivity);
 					}
-					const float fTurnMin = CHECK_PROFILE_FLOAT(Veh_TurnTilt);
-					if (fabs(motion.fRoll) >= DEG2RAD(fTurnMin))
+					const float fTurnMin = CHECK_PROFILE_RADIANS(Veh_TurnTilt);
+					if (fabs(motion.fRoll) >= fTurnMin)
 					{
 						fMoveRoll = -motion.fRoll*CHECK_PROFILE_FLOAT(SoftLock_TurnSensitivity);
 					}
@@ -1548,16 +1759,16 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 					{
 						// Pitch update
 						float fPitch = 0.0f;
-						const float fPitchMin = CHECK_PROFILE_FLOAT(VTOL_PitchTilt);
-						if (fabs(motion.fPitch) >= DEG2RAD(fPitchMin))
+						const float fPitchMin = CHECK_PROFILE_RADIANS(VTOL_PitchTilt);
+						if (fabs(motion.fPitch) >= fPitchMin)
 						{
 							fPitch = -motion.fPitch*(CHECK_PROFILE_BOOL(VTOL_InverseLook)?-1.0f:1.0f)*CHECK_PROFILE_FLOAT(VTOL_PitchSensitivity);
 						}
 
 						// Turn update
 						float fTurn = 0.0f;
-						const float fTurnMin = CHECK_PROFILE_FLOAT(VTOL_TurnTilt);
-						if (fabs(motion.fRoll) >= DEG2RAD(fTurnMin))
+						const float fTurnMin = CHECK_PROFILE_RADIANS(VTOL_TurnTilt);
+						if (fabs(motion.fRoll) >= fTurnMin)
 						{
 							fTurn = motion.fRoll*CHECK_PROFILE_FLOAT(VTOL_TurnSensitivity);
 						}
@@ -1600,11 +1811,11 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 				{
 					// Get move speeds based on sensitivity and dead zones
 					float fMovePitch = 0.0f, fMoveRoll = 0.0f;
-					if (fabs(motion.fPitch) >= DEG2RAD(CHECK_PROFILE_FLOAT(VTOL_PitchTilt)))
+					if (fabs(motion.fPitch) >= CHECK_PROFILE_RADIANS(VTOL_PitchTilt))
 					{
 						fMovePitch = -motion.fPitch*CHECK_PROFILE_FLOAT(SoftLock_LookUpSensitivity);
 					}
-					if (fabs(motion.fRoll) >= DEG2RAD(CHECK_PROFILE_FLOAT(VTOL_TurnTilt)))
+					if (fabs(motion.fRoll) >= CHECK_PROFILE_RADIANS(VTOL_TurnTilt))
 					{
 						fMoveRoll = -motion.fRoll*CHECK_PROFILE_FLOAT(SoftLock_TurnSensitivity);
 					}
@@ -1667,16 +1878,16 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 					{
 						// Pitch update
 						float fPitch = 0.0f;
-						const float fPitchMin = CHECK_PROFILE_FLOAT(Heli_PitchTilt);
-						if (fabs(motion.fPitch) >= DEG2RAD(fPitchMin))
+						const float fPitchMin = CHECK_PROFILE_RADIANS(Heli_PitchTilt);
+						if (fabs(motion.fPitch) >= fPitchMin)
 						{
 							fPitch = -motion.fPitch*(CHECK_PROFILE_BOOL(Heli_InverseLook)?-1.0f:1.0f)*CHECK_PROFILE_FLOAT(Heli_PitchSensitivity);
 						}
 
 						// Turn update
 						float fTurn = 0.0f;
-						const float fTurnMin = CHECK_PROFILE_FLOAT(Heli_TurnTilt);
-						if (fabs(motion.fRoll) >= DEG2RAD(fTurnMin))
+						const float fTurnMin = CHECK_PROFILE_RADIANS(Heli_TurnTilt);
+						if (fabs(motion.fRoll) >= fTurnMin)
 						{
 							fTurn = motion.fRoll*CHECK_PROFILE_FLOAT(Heli_TurnSensitivity);
 						}
@@ -1719,11 +1930,11 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 				{
 					// Get move speeds based on sensitivity and dead zones
 					float fMovePitch = 0.0f, fMoveRoll = 0.0f;
-					if (fabs(motion.fPitch) >= DEG2RAD(CHECK_PROFILE_FLOAT(Heli_PitchTilt)))
+					if (fabs(motion.fPitch) >= CHECK_PROFILE_RADIANS(Heli_PitchTilt))
 					{
 						fMovePitch = -motion.fPitch*CHECK_PROFILE_FLOAT(SoftLock_LookUpSensitivity);
 					}
-					if (fabs(motion.fRoll) >= DEG2RAD(CHECK_PROFILE_FLOAT(Heli_TurnTilt)))
+					if (fabs(motion.fRoll) >= CHECK_PROFILE_RADIANS(Heli_TurnTilt))
 					{
 						fMoveRoll = -motion.fRoll*CHECK_PROFILE_FLOAT(SoftLock_TurnSensitivity);
 					}
@@ -1770,15 +1981,24 @@ void SWiiInputListener::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 }
 
 ////////////////////////////////////////////////////
-void SWiiInputListener::OnMotionStart(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion)
+void SWiiInputListener::OnMotionStart(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& onset)
 {
 	if (NULL == pManager || false == pManager->IsMasterEnabled()) return;
 
 	nEndLifetime = 0;
+	bCommitted = false;
+	CGestureRecognizer *pRecognizer = CGestureRecognizer::GetInstance(WIIMOTE);
+	pRecognizer->Begin();
+	for (int i = 0; i < onset.Size(); i++)
+		pRecognizer->Feed(onset[i]);
 	for (MotionList::iterator itMotion = pManager->m_WiimoteMotions.begin(); 
 		itMotion != pManager->m_WiimoteMotions.end(); itMotion++)
 	{
-		(*itMotion)->OnBegin(motion, nState);
+		// Begin on the first element, then feed it the rest of the onset
+		IMotion *pMotionI = *itMotion;
+		pMotionI->OnBegin(onset.Front(), nState);
+		for (int i = 1; i < onset.Size(); i++)
+			pMotionI->OnUpdate(onset[i], nState);
 	}
 }
 
@@ -1787,19 +2007,47 @@ void SWiiInputListener::OnMotionUpdate(IWR_WiiRemote *pRemote, IWR_WiiMotion *pM
 {
 	if (NULL == pManager || false == pManager->IsMasterEnabled()) return;
 
+	// Rest of the motion is ignored once one has fired early
+	if (true == bCommitted) return;
+
+	// Find which one is certain already
+	IMotion *pFiredMotion = NULL;
+	IMotion *pMotionI = NULL;
+	CGestureRecognizer::GetInstance(WIIMOTE)->Feed(motion);
 	for (MotionList::iterator itMotion = pManager->m_WiimoteMotions.begin(); 
 		itMotion != pManager->m_WiimoteMotions.end(); itMotion++)
 	{
-		(*itMotion)->OnUpdate(motion, nState);
+		pMotionI = *itMotion;
+		pMotionI->OnUpdate(motion, nState);
+		if (pMotionI->IsCommitted() && (NULL == pFiredMotion || pMotionI->GetPriority() > pFiredMotion->GetPriority()))
+			pFiredMotion = pMotionI;
+	}
+
+	// Execute it now instead of waiting for the motion to end, once the
+	//	start is certain (a speculative one can still be cancelled)
+	if (NULL != pFiredMotion && true == CHECK_PROFILE_BOOL(EarlyMotion) &&
+		true == pMotion->IsMotionActive() && false == pMotion->IsSpeculative())
+	{
+		pFiredMotion->Execute();
+		bCommitted = true;
 	}
 }
 
 ////////////////////////////////////////////////////
 void SWiiInputListener::OnMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion)
 {
+	// Already fired during the motion
+	if (true == bCommitted)
+	{
+		bCommitted = false;
+		nEndLifetime = motion.nLifetime;
+		return;
+	}
+
 	// Find which one fired here
 	IMotion *pFiredMotion = NULL;
 	IMotion *pMotionI = NULL;
+	CGestureRecognizer::GetInstance(WIIMOTE)->End();
 	for (MotionList::iterator itMotion = pManager->m_WiimoteMotions.begin(); 
 		itMotion != pManager->m_WiimoteMotions.end(); itMotion++)
 	{
@@ -1819,6 +2067,27 @@ void SWiiInputListener::OnMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMoti
 	}
 }
 
+////////////////////////////////////////////////////
+void SWiiInputListener::OnMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion)
+{
+	if (NULL == pManager) return;
+
+	// Roll back whatever the motions picked up since the start
+	bCommitted = false;
+	CGestureRecognizer::GetInstance(WIIMOTE)->Begin();
+	for (MotionList::iterator itMotion = pManager->m_WiimoteMotions.begin(); 
+		itMotion != pManager->m_WiimoteMotions.end(); itMotion++)
+	{
+		(*itMotion)->OnCancel(nState);
+	}
+}
+
+////////////////////////////////////////////////////
+void SWiiInputListener::OnMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& motions)
+{
+
+}
+
 ////////////////////////////////////////////////////
 void SWiiInputListener::OnExtensionSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion)
 {
@@ -1839,12 +2108,12 @@ void SWiiInputListener::OnExtensionSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiE
 			CMovementRequest mr;
 
 			// Check pitch to adjust the stance
-			if (motion.fPitch > DEG2RAD(-CHECK_PROFILE_FLOAT(CrouchTilt)))
+			if (motion.fPitch > -CHECK_PROFILE_RADIANS(CrouchTilt))
 			{
 				mr.SetStance(STANCE_STAND);
 				pPlayer->GetPlayerInput()->SetForceStance(STANCE_NULL);
 			}
-			else if (motion.fPitch > DEG2RAD(-CHECK_PROFILE_FLOAT(ProneTilt)))
+			else if (motion.fPitch > -CHECK_PROFILE_RADIANS(ProneTilt))
 			{
 				mr.SetStance(STANCE_CROUCH);
 				pPlayer->GetPlayerInput()->SetForceStance(STANCE_CROUCH);
@@ -1857,14 +2126,14 @@ void SWiiInputListener::OnExtensionSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiE
 
 			// Use roll as lean if not in dead zone
 			float fLean = 0.0f;
-			const float fMin = CHECK_PROFILE_FLOAT(LeanTilt);
-			if (motion.fRoll >= DEG2RAD(fMin))
+			const float fMin = CHECK_PROFILE_RADIANS(LeanTilt);
+			if (motion.fRoll >= fMin)
 			{
-				fLean = ((motion.fRoll-DEG2RAD(fMin))/(1.0f-DEG2RAD(fMin)));
+				fLean = ((motion.fRoll-fMin)/(1.0f-fMin));
 			}
-			else if (motion.fRoll <= DEG2RAD(-fMin))
+			else if (motion.fRoll <= -fMin)
 			{
-				fLean = ((motion.fRoll-DEG2RAD(-fMin))/(-(-1.0f-DEG2RAD(-fMin))));
+				fLean = ((motion.fRoll+fMin)/(1.0f-fMin));
 			}
 			mr.SetLean(NEGSATURATE(fLean));
 	
@@ -1874,15 +2143,24 @@ void SWiiInputListener::OnExtensionSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiE
 }
 
 ////////////////////////////////////////////////////
-void SWiiInputListener::OnExtensionMotionStart(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion)
+void SWiiInputListener::OnExtensionMotionStart(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& onset)
 {
 	if (NULL == pManager || false == pManager->IsMasterEnabled()) return;
 
 	nExtensionEndLifetime = 0;
+	bExtensionCommitted = false;
+	CGestureRecognizer *pRecognizer = CGestureRecognizer::GetInstance(NUNCHUK);
+	pRecognizer->Begin();
+	for (int i = 0; i < onset.Size(); i++)
+		pRecognizer->Feed(onset[i]);
 	for (MotionList::iterator itMotion = pManager->m_NunchukMotions.begin(); 
 		itMotion != pManager->m_NunchukMotions.end(); itMotion++)
 	{
-		(*itMotion)->OnBegin(motion, nState);
+		// Begin on the first element, then feed it the rest of the onset
+		IMotion *pMotionI = *itMotion;
+		pMotionI->OnBegin(onset.Front(), nState);
+		for (int i = 1; i < onset.Size(); i++)
+			pMotionI->OnUpdate(onset[i], nState);
 	}
 }
 
@@ -1891,19 +2169,48 @@ void SWiiInputListener::OnExtensionMotionUpdate(IWR_WiiRemote *pRemote, IWR_WiiE
 {
 	if (NULL == pManager || false == pManager->IsMasterEnabled()) return;
 
+	// Rest of the motion is ignored once one has fired early
+	if (true == bExtensionCommitted) return;
+
+	// Find which one is certain already
+	IMotion *pFiredMotion = NULL;
+	IMotion *pMotionI = NULL;
+	CGestureRecognizer::GetInstance(NUNCHUK)->Feed(motion);
 	for (MotionList::iterator itMotion = pManager->m_NunchukMotions.begin(); 
 		itMotion != pManager->m_NunchukMotions.end(); itMotion++)
 	{
-		(*itMotion)->OnUpdate(motion, nState);
+		pMotionI = *itMotion;
+		pMotionI->OnUpdate(motion, nState);
+		if (pMotionI->IsCommitted() && (NULL == pFiredMotion || pMotionI->GetPriority() > pFiredMotion->GetPriority()))
+			pFiredMotion = pMotionI;
+	}
+
+	// Execute it now instead of waiting for the motion to end, once the
+	//	start is certain (a speculative one can still be cancelled)
+	CWR_WiiNunchuk *pNunchuk = (CWR_WiiNunchuk*)pExtension;
+	if (NULL != pFiredMotion && true == CHECK_PROFILE_BOOL(EarlyMotion) &&
+		true == pNunchuk->IsMotionActive() && false == pNunchuk->IsSpeculative())
+	{
+		pFiredMotion->Execute();
+		bExtensionCommitted = true;
 	}
 }
 
 ////////////////////////////////////////////////////
 void SWiiInputListener::OnExtensionMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion)
 {
+	// Already fired during the motion
+	if (true == bExtensionCommitted)
+	{
+		bExtensionCommitted = false;
+		nExtensionEndLifetime = motion.nLifetime;
+		return;
+	}
+
 	// Find which one fired here
 	IMotion *pFiredMotion = NULL;
 	IMotion *pMotionI = NULL;
+	CGestureRecognizer::GetInstance(NUNCHUK)->End();
 	for (MotionList::iterator itMotion = pManager->m_NunchukMotions.begin(); 
 		itMotion != pManager->m_NunchukMotions.end(); itMotion++)
 	{
@@ -1923,25 +2230,45 @@ void SWiiInputListener::OnExtensionMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiExte
 	}
 }
 
+////////////////////////////////////////////////////
+void SWiiInputListener::OnExtensionMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion)
+{
+	if (NULL == pManager) return;
+
+	// Roll back whatever the motions picked up since the start
+	bExtensionCommitted = false;
+	CGestureRecognizer::GetInstance(NUNCHUK)->Begin();
+	for (MotionList::iterator itMotion = pManager->m_NunchukMotions.begin(); 
+		itMotion != pManager->m_NunchukMotions.end(); itMotion++)
+	{
+		(*itMotion)->OnCancel(nState);
+	}
+}
+
 ////////////////////////////////////////////////////
 void SWiiInputListener::OnExtensionAnalogUpdate(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, int nStickID, float fX, float fY)
 {
 	
 }
 
+////////////////////////////////////////////////////
+void SWiiInputListener::OnExtensionMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& motions)
+{
+
+}
+
 ////////////////////////////////////////////////////
 void CWiiRemoteManager::UpdatePlayerMovement(void)
 {
 	if (false == IsMasterEnabled()) return;
 
 	CPlayer *pPlayer = GetPlayer();
-	if (NULL == pPlayer || NULL == m_pRemote || NULL == m_pRemote->GetExtensionHelper()) return;
-	CWR_WiiNunchuk *pNunchuk = (CWR_WiiNunchuk*)m_pRemote->GetExtensionHelper();
+	if (NULL == pPlayer || NULL == m_pRemote || false == g_WiiInput.bExtension) return;
 	const CGameActions &rGameActions = m_pGame->Actions();
 
 	// Analog stick positions
-	float fX = pNunchuk->GetAnalogX();
-	float fY = pNunchuk->GetAnalogY();
+	float fX = g_WiiInput.fAnalogX;
+	float fY = g_WiiInput.fAnalogY;
 
 	// Player controls
 	if (g_WiiInputListener.nState == STATE_PLAYER || g_WiiInputListener.nState == STATE_BINOCULARS)
@@ -1985,9 +2312,9 @@ void CWiiRemoteManager::UpdatePlayerMovement(void)
 		else
 		{
 			// Use roll
-			float fRoll = ((CWR_WiiNunchuk*)m_pRemote->GetExtensionHelper())->GetRoll();
-			const float fMin = CHECK_PROFILE_FLOAT(Veh_SteerTilt_Land);
-			if (fabs(fRoll) >= DEG2RAD(fMin))
+			float fRoll = g_WiiInput.fExtRoll;
+			const float fMin = CHECK_PROFILE_RADIANS(Veh_SteerTilt_Land);
+			if (fabs(fRoll) >= fMin)
 			{
 				action.rotateYaw = CLAMP(fRoll*CHECK_PROFILE_FLOAT(Veh_SteerSensitivity_Land),-1.0f,1.0f);
 			}
@@ -2020,9 +2347,9 @@ void CWiiRemoteManager::UpdatePlayerMovement(void)
 		else
 		{
 			// Use roll
-			float fRoll = ((CWR_WiiNunchuk*)m_pRemote->GetExtensionHelper())->GetRoll();
-			const float fMin = CHECK_PROFILE_FLOAT(Veh_SteerTilt_Sea);
-			if (fabs(fRoll) >= DEG2RAD(fMin))
+			float fRoll = g_WiiInput.fExtRoll;
+			const float fMin = CHECK_PROFILE_RADIANS(Veh_SteerTilt_Sea);
+			if (fabs(fRoll) >= fMin)
 			{
 				action.rotateYaw = CLAMP(fRoll*CHECK_PROFILE_FLOAT(Veh_SteerSensitivity_Sea),-1.0f,1.0f);
 			}
@@ -2073,15 +2400,15 @@ void CWiiRemoteManager::UpdatePlayerMovement(void)
 		}
 		else
 		{
-			float fRoll = ((CWR_WiiNunchuk*)m_pRemote->GetExtensionHelper())->GetRoll();
-			const float fDZ = CHECK_PROFILE_FLOAT(VTOL_HTilt);
-			if (fRoll >= DEG2RAD(fDZ))
+			float fRoll = g_WiiInput.fExtRoll;
+			const float fDZ = CHECK_PROFILE_RADIANS(VTOL_HTilt);
+			if (fRoll >= fDZ)
 			{
 				float fSpeed = CLAMP((fRoll*(1.0f/DEG2RAD(90.0f))) * CHECK_PROFILE_FLOAT(VTOL_HSensitivity),0.0f,1.0f);
 				pVM->OnAction(eVAI_StrafeLeft, eAAM_OnRelease, 0.0f);
 				pVM->OnAction(eVAI_StrafeRight, eAAM_OnPress, fSpeed);
 			}
-			else if (fRoll <= DEG2RAD(fDZ))
+			else if (fRoll <= fDZ)
 			{
 				float fSpeed = CLAMP((-fRoll*(1.0f/DEG2RAD(90.0f))) * CHECK_PROFILE_FLOAT(VTOL_HSensitivity),0.0f,1.0f);
 				pVM->OnAction(eVAI_StrafeRight, eAAM_OnRelease, 0.0f);
@@ -2115,15 +2442,15 @@ void CWiiRemoteManager::UpdatePlayerMovement(void)
 		}
 		else
 		{
-			float fRoll = ((CWR_WiiNunchuk*)m_pRemote->GetExtensionHelper())->GetRoll();
-			const float fDZ = CHECK_PROFILE_FLOAT(VTOL_HTilt);
-			if (fRoll >= DEG2RAD(fDZ))
+			float fRoll = g_WiiInput.fExtRoll;
+			const float fDZ = CHECK_PROFILE_RADIANS(VTOL_HTilt);
+			if (fRoll >= fDZ)
 			{
 				float fSpeed = CLAMP((fRoll*(1.0f/DEG2RAD(90.0f))) * CHECK_PROFILE_FLOAT(VTOL_HSensitivity),0.0f,1.0f);
 				pVM->OnAction(eVAI_RollLeft, eAAM_OnRelease, 0.0f);
 				pVM->OnAction(eVAI_RollRight, eAAM_OnPress, fSpeed);
 			}
-			else if (fRoll <= DEG2RAD(fDZ))
+			else if (fRoll <= fDZ)
 			{
 				float fSpeed = CLAMP((-fRoll*(1.0f/DEG2RAD(90.0f))) * CHECK_PROFILE_FLOAT(VTOL_HSensitivity),0.0f,1.0f);
 				pVM->OnAction(eVAI_RollRight, eAAM_OnRelease, 0.0f);
@@ -2137,15 +2464,15 @@ void CWiiRemoteManager::UpdatePlayerMovement(void)
 		}
 
 		// Check nunchuk pitch for vertical movement
-		float fPitch = ((CWR_WiiNunchuk*)m_pRemote->GetExtensionHelper())->GetPitch();
-		const float fDZ = CHECK_PROFILE_FLOAT(VTOL_VTilt);
-		if (fPitch >= DEG2RAD(fDZ))
+		float fPitch = g_WiiInput.fExtPitch;
+		const float fDZ = CHECK_PROFILE_RADIANS(VTOL_VTilt);
+		if (fPitch >= fDZ)
 		{
 			float fSpeed = CLAMP((fPitch*(1.0f/DEG2RAD(90.0f))) * CHECK_PROFILE_FLOAT(VTOL_VSensitivity),0.0f,1.0f);
 			pVM->OnAction(eVAI_MoveDown, eAAM_OnRelease, 0.0f);
 			pVM->OnAction(eVAI_MoveUp, eAAM_OnPress, fSpeed);
 		}
-		else if (fPitch <= DEG2RAD(-fDZ))
+		else if (fPitch <= -fDZ)
 		{
 			float fSpeed = CLAMP((-fPitch*(1.0f/DEG2RAD(90.0f))) * CHECK_PROFILE_FLOAT(VTOL_VSensitivity),0.0f,1.0f);
 			pVM->OnAction(eVAI_MoveUp, eAAM_OnRelease, 0.0f);
@@ -2199,15 +2526,15 @@ void CWiiRemoteManager::UpdatePlayerMovement(void)
 		}
 		else
 		{
-			float fRoll = ((CWR_WiiNunchuk*)m_pRemote->GetExtensionHelper())->GetRoll();
-			const float fDZ = CHECK_PROFILE_FLOAT(Heli_RollTilt);
-			if (fRoll >= DEG2RAD(fDZ))
+			float fRoll = g_WiiInput.fExtRoll;
+			const float fDZ = CHECK_PROFILE_RADIANS(Heli_RollTilt);
+			if (fRoll >= fDZ)
 			{
 				float fSpeed = CLAMP((fRoll*(1.0f/DEG2RAD(90.0f))) * CHECK_PROFILE_FLOAT(Heli_RollSensitivity),0.0f,1.0f);
 				pVM->OnAction(eVAI_RollLeft, eAAM_OnRelease, 0.0f);
 				pVM->OnAction(eVAI_RollRight, eAAM_OnPress, fSpeed);
 			}
-			else if (fRoll <= DEG2RAD(fDZ))
+			else if (fRoll <= fDZ)
 			{
 				float fSpeed = CLAMP((-fRoll*(1.0f/DEG2RAD(90.0f))) * CHECK_PROFILE_FLOAT(Heli_RollSensitivity),0.0f,1.0f);
 				pVM->OnAction(eVAI_RollRight, eAAM_OnRelease, 0.0f);
@@ -2249,65 +2576,28 @@ void CWiiRemoteManager::UpdatePlayerMovement(void)
 		// Find entity to lock on to
 		if ((NULL == m_pLockedEntity || false == m_bLockedNPC) && NULL != pMC && false == m_bForceLockView)
 		{
-			// See if we are looking at one now
 			SMovementState info; pMC->GetMovementState(info);
-			Vec3 vPlayerForward = info.fireDirection * CHECK_PROFILE_FLOAT(MaxLockViewDist);
 			Vec3 vPlayerPos(PlayerCam.GetPosition());
-			ray_hit actorHit, objectHit;
-			IPhysicalEntity *pSkip[3] = {pPlayer->GetEntity()->GetPhysics(), NULL, NULL};
-			if (pPlayer->GetLinkedVehicle())
-				pSkip[1] = pPlayer->GetLinkedVehicle()->GetEntity()->GetPhysics();
-			COffHand* pOffHand = static_cast<COffHand*>(pPlayer->GetWeaponByClass(CItem::sOffHandClass));
-			if (NULL != pOffHand && pOffHand->GetOffHandState()&(eOHS_HOLDING_OBJECT|eOHS_HOLDING_NPC|eOHS_THROWING_OBJECT|eOHS_THROWING_NPC))
+
+			// Take the object ray queued on an earlier frame
+			if (true == m_bLockRayReady)
 			{
-				// Try to ignore the object picked up as well
-				if (IEntity *pEnt = gEnv->pEntitySystem->GetEntity(pOffHand->GetHeldEntityId()))
-					pSkip[2] = pEnt->GetPhysics();
+				m_bLockRayReady = false;
+				if (true == m_LockRayHit.bHit && NULL == m_pLockedEntity && true == ApplyLockHit(m_LockRayHit, false))
+					CacheLockHit(m_LockRayHit.nEntityId, m_vLockRayPos, m_vLockRayDir);
 			}
 
-			// Perform a trace on actors and on objects
-			int nActorHit = gEnv->pPhysicalWorld->RayWorldIntersection(vPlayerPos, vPlayerForward, (ent_independent), 
-				(rwi_stop_at_pierceable|rwi_colltype_any|rwi_ignore_back_faces), &actorHit, 1, pSkip, 3);
-			int nObjectHit = 0;
-			if (NULL == m_pLockedEntity)
-				nObjectHit = gEnv->pPhysicalWorld->RayWorldIntersection(vPlayerPos, vPlayerForward, (ent_static|ent_rigid|ent_sleeping_rigid|ent_living), 
-					(rwi_stop_at_pierceable|rwi_colltype_any|rwi_ignore_back_faces), &objectHit, 1, pSkip, 3);
+			// Take the best actor in the view cone over any object
+			m_TargetSelector.Update(pPlayer, vPlayerPos, info.fireDirection);
+			SLockRayHit target;
+			target.nEntityId = m_TargetSelector.GetTarget();
+			target.bHit = (0 != target.nEntityId);
+			if (true == target.bHit)
+				ApplyLockHit(target, true);
 
-			// Try to take the actor over the object
-			ray_hit *pHit = ((nActorHit && actorHit.pCollider) ? &actorHit : ((nObjectHit && objectHit.pCollider) ? &objectHit : NULL));
-			if (NULL != pHit)
-			{
-				if (IEntity *pEnt = (IEntity*)pHit->pCollider->GetForeignData(PHYS_FOREIGN_ID_ENTITY))
-				{
-					if (IEntityRenderProxy *pRenderProxy = (IEntityRenderProxy*)pEnt->GetProxy(ENTITY_PROXY_RENDER))
-						m_pLockedEntity = pRenderProxy->GetRenderNode();
-				}
-				else if (IRenderNode *pRndNode = (IRenderNode*)pHit->pCollider->GetForeignData(PHYS_FOREIGN_ID_STATIC))
-				{
-					m_pLockedEntity = pRndNode;
-				}
-				if (NULL != m_pLockedEntity)
-				{
-					// Set offset point to maintain hit point when using only remote
-					//if (false == UsingIRSensor())
-					{
-						AABB aabb = m_pLockedEntity->GetBBox();
-						Vec3 vPos = aabb.GetCenter()+Vec3(0.f,0.f,(aabb.max.z-aabb.min.z)*0.25f);
-						if (pHit == &objectHit)
-						{
-							// Use offset from hit point to position
-							m_bLockedNPC = false;
-							m_vLockedEntityOffset = pHit->pt - vPos;
-						}
-						else
-						{
-							// Use 0-based offset (to retain center position)
-							m_bLockedNPC = true;
-							m_vLockedEntityOffset.Set(0,0,0);
-						}
-					}
-				}
-			}
+			// Look for an object while nothing is locked, reusing a recent hit before casting again
+			if (NULL == m_pLockedEntity && false == LookupLockCache(vPlayerPos, info.fireDirection) && false == m_bLockRayPending && false == m_bLockRayInFlight)
+				QueueLockRay(pPlayer, vPlayerPos, info.fireDirection);
 		}
 		if (NULL != m_pLockedEntity)
 		{
@@ -2352,14 +2642,241 @@ IRenderNode* CWiiRemoteManager::GetLockedEntity(Vec3 &vOffset) const
 }
 
 ////////////////////////////////////////////////////
-bool CWiiRemoteManager::IsButtonDown(int nButton) const
+void CWiiRemoteManager::QueueLockRay(CPlayer *pPlayer, Vec3 const& vPos, Vec3 const& vDir)
 {
-	if (nButton == WIIBTN_C || nButton == WIIBTN_Z)
+	// A cancelled ray may still be writing into the buffer
+	if (true == m_bLockRayInFlight) return;
+
+	IPhysicalEntity *pSkip[TARGET_MAX_SKIP];
+	int nSkip = CWiiRemoteTargetSelector::GetSkipEntities(pPlayer, pSkip);
+
+	// Result is tagged with the sequence so a stale one can be dropped
+	m_nLockRaySeq = (m_nLockRaySeq+1) & 0x3FFFFFFF;
+	m_bLockRayPending = true;
+	m_bLockRayInFlight = true;
+	m_bLockRayReady = false;
+	m_vLockRayPos = vPos;
+	m_vLockRayDir = vDir;
+	m_LockRayHit = SLockRayHit();
+
+	// Queue a trace on objects
+	gEnv->pPhysicalWorld->RayWorldIntersection(vPos, vDir * CHECK_PROFILE_FLOAT(MaxLockViewDist), (ent_static|ent_rigid|ent_sleeping_rigid|ent_living),
+		(rwi_stop_at_pierceable|rwi_colltype_any|rwi_ignore_back_faces|rwi_queue), &m_LockRayBuffer, 1, pSkip, nSkip, this, m_nLockRaySeq);
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteManager::CancelLockRays(void)
+{
+	// Results still in flight no longer match the sequence, but keep
+	//	m_bLockRayInFlight until physics is done with the buffer
+	m_nLockRaySeq = (m_nLockRaySeq+1) & 0x3FFFFFFF;
+	m_bLockRayPending = false;
+	m_bLockRayReady = false;
+	m_TargetSelector.Reset();
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteManager::RegisterForceLockCombo(void)
+{
+	const unsigned int nLockButton = CHECK_PROFILE_BUTTON(LockView);
+	if (NULL == m_pRemote || nLockButton == m_nForceLockButton) return;
+	m_nForceLockButton = nLockButton;
+	m_bForceLockView = false;
+
+	// Register on whichever device has the button now, the input thread may be
+	//	stepping the combos or removing the extension
+	m_pWR->LockInput();
+	if (NUNCHUK_BIT != (nLockButton&NUNCHUK_BIT))
+		m_pRemote->GetButtonHelper()->RegisterCombo(FORCELOCK_COMBO, GetForceLockCombo(nLockButton));
+	else if (IWR_WiiExtension *pExtension = m_pRemote->GetExtensionHelper())
+	{
+		if (pExtension->GetType() == CWR_WiiNunchuk::TYPE)
+			((CWR_WiiNunchuk*)pExtension)->RegisterCombo(FORCELOCK_COMBO, GetForceLockCombo(nLockButton&~NUNCHUK_BIT));
+	}
+	m_pWR->UnlockInput();
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteManager::ApplyProfileSettings(IWR_WiiRemote *pRemote)
+{
+	if (NULL == pRemote) return;
+
+	// Input thread may be using the helpers
+	m_pWR->LockInput();
+	pRemote->GetMotionHelper()->SetSpeculativeOnset(CHECK_PROFILE_BOOL(SpeculativeMotion));
+	pRemote->GetSensorHelper()->SetCursorFilter(CHECK_PROFILE_BOOL(FilterIRCursor),
+		CHECK_PROFILE_FLOAT(IRFilterMinCutoff), CHECK_PROFILE_FLOAT(IRFilterBeta));
+	if (IWR_WiiExtension *pExtension = pRemote->GetExtensionHelper())
+	{
+		if (pExtension->GetType() == CWR_WiiNunchuk::TYPE)
+			((CWR_WiiNunchuk*)pExtension)->SetSpeculativeOnset(CHECK_PROFILE_BOOL(SpeculativeMotion));
+	}
+	m_pWR->UnlockInput();
+}
+
+////////////////////////////////////////////////////
+int CWiiRemoteManager::OnLockRayResult(EventPhys const* pEvent)
+{
+	EventPhysRWIResult const* pResult = (EventPhysRWIResult const*)pEvent;
+
+	// Other systems queue rays too
+	CWiiRemoteManager *pManager = (CWiiRemoteManager*)(g_pGame ? g_pGame->GetWiiRemoteManager() : NULL);
+	if (NULL == pManager || pResult->pForeignData != pManager) return 1;
+
+	// Buffer is free again, even for a stale result
+	pManager->m_bLockRayInFlight = false;
+	if (pResult->iForeignData != pManager->m_nLockRaySeq || false == pManager->m_bLockRayPending) return 1;
+
+	// Keep what was hit, not the collider, as it is read on a later frame
+	SLockRayHit &hit = pManager->m_LockRayHit;
+	if (pResult->nHits > 0 && NULL != pResult->pHits && NULL != pResult->pHits[0].pCollider)
+	{
+		IPhysicalEntity *pCollider = pResult->pHits[0].pCollider;
+		if (IEntity *pEnt = (IEntity*)pCollider->GetForeignData(PHYS_FOREIGN_ID_ENTITY))
+		{
+			hit.bHit = true;
+			hit.nEntityId = pEnt->GetId();
+		}
+		else if (IRenderNode *pRndNode = (IRenderNode*)pCollider->GetForeignData(PHYS_FOREIGN_ID_STATIC))
+		{
+			hit.bHit = true;
+			hit.pStatic = pRndNode;
+		}
+		hit.vPt = pResult->pHits[0].pt;
+	}
+
+	pManager->m_bLockRayPending = false;
+	pManager->m_bLockRayReady = true;
+	return 1;
+}
+
+////////////////////////////////////////////////////
+bool CWiiRemoteManager::ApplyLockHit(SLockRayHit const& hit, bool bNPC)
+{
+	IRenderNode *pNode = hit.pStatic;
+	if (0 != hit.nEntityId)
+	{
+		pNode = NULL;
+		if (IEntity *pEnt = gEnv->pEntitySystem->GetEntity(hit.nEntityId))
+			if (IEntityRenderProxy *pRenderProxy = (IEntityRenderProxy*)pEnt->GetProxy(ENTITY_PROXY_RENDER))
+				pNode = pRenderProxy->GetRenderNode();
+	}
+	if (NULL == pNode) return false;
+
+	// Set offset point to maintain hit point when using only remote
+	m_pLockedEntity = pNode;
+	m_bLockedNPC = bNPC;
+	if (true == bNPC)
+	{
+		// Use 0-based offset (to retain center position)
+		m_vLockedEntityOffset.Set(0,0,0);
+	}
+	else
 	{
-		CWR_WiiNunchuk *pNunchuk = (CWR_WiiNunchuk*)m_pRemote->GetExtensionHelper();
-		return (pNunchuk?pNunchuk->IsButtonDown(g_WiiRemoteProfile->TranslateButton((EWiiButton)nButton)):false);
+		// Use offset from hit point to position
+		AABB aabb = m_pLockedEntity->GetBBox();
+		Vec3 vPos = aabb.GetCenter()+Vec3(0.f,0.f,(aabb.max.z-aabb.min.z)*0.25f);
+		m_vLockedEntityOffset = hit.vPt - vPos;
 	}
-	return m_pRemote->GetButtonHelper()->IsButtonDown(g_WiiRemoteProfile->TranslateButton((EWiiButton)nButton));
+	return true;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteManager::CacheLockHit(EntityId nEntityId, Vec3 const& vPos, Vec3 const& vDir)
+{
+	// Static geometry can't be checked for still existing later
+	if (0 == nEntityId) return;
+
+	// Replace the entry for the same entity, else the oldest
+	int nEntry = 0;
+	for (int i = 0; i < LOCKVIEW_CACHE_SIZE; i++)
+	{
+		if (m_LockCache[i].nEntityId == nEntityId)
+		{
+			nEntry = i;
+			break;
+		}
+		if (m_LockCache[i].fTime < m_LockCache[nEntry].fTime)
+			nEntry = i;
+	}
+
+	SLockCacheEntry &entry = m_LockCache[nEntry];
+	entry.nEntityId = nEntityId;
+	entry.vPos = vPos;
+	entry.vDir = vDir.GetNormalized();
+	entry.vOffset = m_vLockedEntityOffset;
+	entry.fTime = m_pWR->pTimer->GetCurrTime();
+}
+
+////////////////////////////////////////////////////
+bool CWiiRemoteManager::LookupLockCache(Vec3 const& vPos, Vec3 const& vDir)
+{
+	const float fCurrTime = m_pWR->pTimer->GetCurrTime();
+	const float fMaxDist = CHECK_PROFILE_FLOAT(MaxLockViewDist);
+	const Vec3 vNormDir = vDir.GetNormalized();
+	for (int i = 0; i < LOCKVIEW_CACHE_SIZE; i++)
+	{
+		SLockCacheEntry &entry = m_LockCache[i];
+		if (0 == entry.nEntityId || fCurrTime - entry.fTime > LOCKVIEW_CACHE_TIME) continue;
+		if ((vPos - entry.vPos).GetLengthSquared() > LOCKVIEW_CACHE_DIST*LOCKVIEW_CACHE_DIST) continue;
+		if (vNormDir.Dot(entry.vDir) < LOCKVIEW_CACHE_COS) continue;
+
+		// Entity may have moved off the ray since it was hit
+		IEntity *pEnt = gEnv->pEntitySystem->GetEntity(entry.nEntityId);
+		if (NULL == pEnt)
+		{
+			entry.nEntityId = 0;
+			continue;
+		}
+		AABB aabb; pEnt->GetWorldBounds(aabb);
+		Vec3 vHit;
+		if (0 == Intersect::Ray_AABB(Ray(vPos, vNormDir), aabb, vHit) ||
+			(vHit - vPos).GetLengthSquared() > fMaxDist*fMaxDist)
+		{
+			entry.nEntityId = 0;
+			continue;
+		}
+
+		// Entity must still be renderable
+		SLockRayHit hit;
+		hit.bHit = true;
+		hit.nEntityId = entry.nEntityId;
+		if (false == ApplyLockHit(hit, false))
+		{
+			entry.nEntityId = 0;
+			continue;
+		}
+		m_vLockedEntityOffset = entry.vOffset;
+		return true;
+	}
+	return false;
+}
+
+////////////////////////////////////////////////////
+bool CWiiRemoteManager::PredictCursor(Vec3 &vPos) const
+{
+	if (false == m_bMasterEnabled || false == m_bIRCursorLive || NULL == m_pRemote || NULL == m_pWR) return false;
+
+	// The frame is shown about a frame from now
+	float fX = 0.0f, fY = 0.0f;
+	const float fShowTime = m_pWR->pTimer->GetPreciseTime() + gEnv->pTimer->GetFrameTime();
+	m_pWR->LockInput();
+	const bool bOnScreen = m_pRemote->GetSensorHelper()->PredictCursor(fShowTime, fX, fY);
+	m_pWR->UnlockInput();
+	if (false == bOnScreen) return false;
+
+	vPos.Set(fX, fY, 0);
+	return true;
+}
+
+////////////////////////////////////////////////////
+bool CWiiRemoteManager::IsButtonDown(int nButton) const
+{
+	// Read from this frame's input so the answer holds for the whole frame
+	const unsigned int nMask = g_WiiRemoteProfile->TranslateButton((EWiiButton)nButton);
+	if (nButton == WIIBTN_C || nButton == WIIBTN_Z)
+		return (0 != (g_WiiInput.nExtButtons & nMask));
+	return (0 != (g_WiiInput.nButtons & nMask));
 }
 
 ////////////////////////////////////////////////////
@@ -2380,11 +2897,15 @@ void SWiiInputListener::OnLeaveScreen(IWR_WiiRemote *pRemote, IWR_WiiSensor *pSe
 	if (NULL == pManager->m_pGame || NULL == (pHUD = pManager->m_pGame->GetHUD()) || NULL == (pCH = pHUD->GetCrosshair())) return;
 	
 	pCH->IRSetOnScreen(false);
+	pManager->m_bIRCursorLive = false;
 }
 
 ////////////////////////////////////////////////////
 void SWiiInputListener::OnCursorUpdate(IWR_WiiRemote *pRemote, IWR_WiiSensor *pSensor, float fX, float fY)
 {
+	// Only predicted while it follows the cursor below
+	pManager->m_bIRCursorLive = false;
+
 	CHUD *pHUD;
 	CHUDCrosshair *pCH;
 	if (NULL == pManager->m_pGame || NULL == (pHUD = pManager->m_pGame->GetHUD()) || NULL == (pCH = pHUD->GetCrosshair())) return;
@@ -2431,6 +2952,7 @@ void SWiiInputListener::OnCursorUpdate(IWR_WiiRemote *pRemote, IWR_WiiSensor *pS
 
 		// Set the cursor position
 		pCH->IRSetCursorPos(fX,fY);
+		pManager->m_bIRCursorLive = true;
 
 		if (false == pManager->m_bForceLockView && false == pManager->IsMovementFrozen())
 		{
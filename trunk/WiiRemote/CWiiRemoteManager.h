@@ -15,12 +15,19 @@
 
 #include "Interfaces\IWiiRemoteManager.h"
 #include "Interfaces\IMotion.h"
+#include "CWiiRemoteTargetSelector.h"
 #include "IActionMapManager.h"
 
 #define WRERROR_SHOWMESSAGE_RATE (10.0f)
 #define WRERROR_SHOWMESSAGE_LENGTH (5.0f)
 #define WRERROR_BATTERY_MARKER (0.1f) // Show battery low warning at 10%
 
+// Lock view acquisition
+#define LOCKVIEW_CACHE_SIZE (4)
+#define LOCKVIEW_CACHE_TIME (2.0f) // How long a cached hit can be reused
+#define LOCKVIEW_CACHE_DIST (0.5f) // How far the eye can move to reuse a cached hit
+#define LOCKVIEW_CACHE_COS (0.999f) // Cosine of how far the aim can turn to reuse a cached hit
+
 // Rumble timers
 #define RUMBLE_DAMAGE_TIMER (0.25f)
 #define RUMBLE_FIRE_WEAPON_TIMER (0.1f)
@@ -55,6 +62,28 @@ struct SWiiRemoteError
 	SWiiRemoteError(void) : bOn(false), nTextureID(0), fTextureWidth(0), fTextureHeight(0) {}
 };
 
+// Lock view ray result
+struct SLockRayHit
+{
+	bool bHit;
+	EntityId nEntityId; // Entity hit, or 0 for static geometry
+	IRenderNode *pStatic; // Static geometry hit
+	Vec3 vPt;
+
+	SLockRayHit(void) : bHit(false), nEntityId(0), pStatic(NULL), vPt(0,0,0) {}
+};
+
+// Recent lock view object hit
+struct SLockCacheEntry
+{
+	EntityId nEntityId;
+	Vec3 vPos, vDir; // Ray it was hit with
+	Vec3 vOffset;
+	float fTime;
+
+	SLockCacheEntry(void) : nEntityId(0), vPos(0,0,0), vDir(0,0,0), vOffset(0,0,0), fTime(0) {}
+};
+
 // States
 enum EStates
 {
@@ -66,13 +95,20 @@ enum EStates
 	STATE_SEAVEHICLE,
 	STATE_HELIVEHICLE,
 	STATE_VTOLVEHICLE,
+
+	STATE_MAX,
 };
 
+// State listeners
+typedef std::list<IWiiRemoteStateListener*> StateListenerList;
+
 class CWiiRemoteProfile;
 class CWiiRemoteManager : public IWiiRemoteManager, public IActionListener
 {
 	friend struct SWiiRemoteListener;
 	friend struct SWiiInputListener;
+	friend struct SWiiGameStateListener;
+	friend struct SWiiProfileStateListener;
 
 protected:
 	bool m_bMasterEnabled;
@@ -101,14 +137,37 @@ protected:
 	bool m_bSprint;
 	bool m_bLockView;
 	bool m_bForceLockView;
+	unsigned int m_nForceLockButton; // Lock view button the force lock combo is registered for
 	bool m_bLockedNPC;
 	IRenderNode *m_pLockedEntity;
 	Vec3 m_vLockedEntityOffset;
-
-	// Used for double force lock check
-	float m_fLastLockRelease;
+	bool m_bIRCursorLive; // TRUE while the crosshair follows the IR cursor
+
+	// Lock view object ray queued with physics, read on a later frame
+	SLockRayHit m_LockRayHit;
+	ray_hit m_LockRayBuffer;
+	int m_nLockRaySeq;
+	bool m_bLockRayPending;
+	bool m_bLockRayInFlight; // Physics may still write m_LockRayBuffer, only OnLockRayResult clears it
+	bool m_bLockRayReady;
+	Vec3 m_vLockRayPos, m_vLockRayDir;
+	SLockCacheEntry m_LockCache[LOCKVIEW_CACHE_SIZE];
+
+	// Picks the actor to lock on to from those in the view cone
+	CWiiRemoteTargetSelector m_TargetSelector;
+
+	// When movement was last frozen
 	float m_fFreezeMovement;
 
+	// Profile layer used in each state
+	int m_nStateLayers[STATE_MAX];
+
+	// Game state cache, detected again only when dirty
+	bool m_bStateDirty;
+	EntityId m_nStatePlayerId;
+	EntityId m_nStateItemId;
+	StateListenerList m_StateListeners;
+
 	// Motion objects
 	MotionList m_NunchukMotions;
 	MotionList m_WiimoteMotions;
@@ -199,6 +258,19 @@ public:
 	////////////////////////////////////////////////////
 	virtual IRenderNode* GetLockedEntity(Vec3 &vOffset) const;
 
+	////////////////////////////////////////////////////
+	// PredictCursor
+	//
+	// Purpose: Get where the IR cursor is expected to be
+	//	when the current frame is shown
+	//
+	// Out:	vPos - Predicted cursor position
+	//
+	// Returns TRUE if the crosshair is following the
+	//	IR cursor, otherwise vPos is untouched
+	////////////////////////////////////////////////////
+	virtual bool PredictCursor(Vec3 &vPos) const;
+
 	////////////////////////////////////////////////////
 	// FreezeMovement
 	//
@@ -268,7 +340,66 @@ public:
 	////////////////////////////////////////////////////
 	virtual void OnWeaponShoot(unsigned int nShooterId);
 
+	////////////////////////////////////////////////////
+	// InvalidateState
+	//
+	// Purpose: Call when something the game state is
+	//	derived from changes, i.e. a HUD menu opening or
+	//	the player entering a vehicle
+	//
+	// Note: The state is detected again on the next update
+	////////////////////////////////////////////////////
+	virtual void InvalidateState(void);
+
+	////////////////////////////////////////////////////
+	// GetState
+	//
+	// Purpose: Return the current game state
+	////////////////////////////////////////////////////
+	virtual int GetState(void) const;
+
+	////////////////////////////////////////////////////
+	// AddStateListener
+	//
+	// Purpose: Add a listener for game state changes
+	//
+	// In:	pListener - Listener to add
+	////////////////////////////////////////////////////
+	virtual void AddStateListener(IWiiRemoteStateListener *pListener);
+
+	////////////////////////////////////////////////////
+	// RemoveStateListener
+	//
+	// Purpose: Remove a listener for game state changes
+	//
+	// In:	pListener - Listener to remove
+	////////////////////////////////////////////////////
+	virtual void RemoveStateListener(IWiiRemoteStateListener *pListener);
+
 protected:
+	////////////////////////////////////////////////////
+	// DetectState
+	//
+	// Purpose: Derive the game state from the HUD, the
+	//	player's item and linked vehicle
+	//
+	// In:	pPlayer - Client player
+	//		pCurrentItem - Player's current item
+	//
+	// Returns the state or -1 if the remote can't be used
+	//	in it
+	////////////////////////////////////////////////////
+	virtual int DetectState(class CPlayer *pPlayer, class CItem *pCurrentItem) const;
+
+	////////////////////////////////////////////////////
+	// SetState
+	//
+	// Purpose: Change the game state and notify listeners
+	//
+	// In:	nNewState - State now active
+	////////////////////////////////////////////////////
+	virtual void SetState(int nNewState);
+
 	////////////////////////////////////////////////////
 	// UpdatePlayerMovement
 	//
@@ -285,6 +416,103 @@ protected:
 	// In:	nButton - Button to check
 	////////////////////////////////////////////////////
 	virtual bool IsButtonDown(int nButton) const;
+
+	////////////////////////////////////////////////////
+	// QueueLockRay
+	//
+	// Purpose: Queue the ray used to find an object to
+	//	lock the view on to
+	//
+	// In:	pPlayer - Client player
+	//		vPos - Ray origin
+	//		vDir - Ray direction
+	//
+	// Note: Result arrives through OnLockRayResult. Does
+	//	nothing while the last ray is still in flight
+	////////////////////////////////////////////////////
+	virtual void QueueLockRay(class CPlayer *pPlayer, Vec3 const& vPos, Vec3 const& vDir);
+
+	////////////////////////////////////////////////////
+	// CancelLockRays
+	//
+	// Purpose: Drop the results of any queued lock rays
+	//	and the actor targets found so far
+	////////////////////////////////////////////////////
+	virtual void CancelLockRays(void);
+
+	////////////////////////////////////////////////////
+	// RegisterForceLockCombo
+	//
+	// Purpose: Register the force lock combo again if the
+	//	lock view button has changed
+	//
+	// Note: Call after the profile is reloaded or its
+	//	layer changes
+	////////////////////////////////////////////////////
+	virtual void RegisterForceLockCombo(void);
+
+	////////////////////////////////////////////////////
+	// ApplyProfileSettings
+	//
+	// Purpose: Pass the profile's options on to the
+	//	remote's helpers and the nunchuk
+	//
+	// In:	pRemote - Remote to set up
+	//
+	// Note: Call on connect, on nunchuk plug-in and when
+	//	the profile's values change
+	////////////////////////////////////////////////////
+	virtual void ApplyProfileSettings(IWR_WiiRemote *pRemote);
+
+	////////////////////////////////////////////////////
+	// ApplyLockHit
+	//
+	// Purpose: Lock the view on to what a ray hit
+	//
+	// In:	hit - Ray result
+	//		bNPC - TRUE to retain the center of the entity,
+	//			FALSE to retain the hit point
+	//
+	// Returns TRUE if the view is now locked on it
+	////////////////////////////////////////////////////
+	virtual bool ApplyLockHit(SLockRayHit const& hit, bool bNPC);
+
+	////////////////////////////////////////////////////
+	// CacheLockHit
+	//
+	// Purpose: Remember the locked object for a while
+	//
+	// In:	nEntityId - Object locked on to
+	//		vPos - Ray origin
+	//		vDir - Ray direction
+	////////////////////////////////////////////////////
+	virtual void CacheLockHit(EntityId nEntityId, Vec3 const& vPos, Vec3 const& vDir);
+
+	////////////////////////////////////////////////////
+	// LookupLockCache
+	//
+	// Purpose: Lock on to a recently hit object if the
+	//	ray is close enough to the one that hit it, and
+	//	still passes through its bounds
+	//
+	// In:	vPos - Ray origin
+	//		vDir - Ray direction
+	//
+	// Returns TRUE if the view is now locked on it
+	//
+	// Note: Actors are always picked by the target
+	//	selector, so their line of sight is checked
+	////////////////////////////////////////////////////
+	virtual bool LookupLockCache(Vec3 const& vPos, Vec3 const& vDir);
+
+	////////////////////////////////////////////////////
+	// OnLockRayResult
+	//
+	// Purpose: Physics callback for the queued object ray
+	//
+	// In:	pEvent - Ray result event
+	////////////////////////////////////////////////////
+	static int OnLockRayResult(EventPhys const* pEvent);
 };
 
 #endif //_CWIIREMOTEMANAGER_H_
\ No newline at end of file
@@ -16,6 +16,40 @@
 #include "CWiiRemoteProfile.h"
 
 #define PROFILE_NAME ("%USER%/wiiremote.xml")
+#define PROFILE_CACHE_NAME ("%USER%/wiiremote.bin")
+#define PROFILE_WATCH_INTERVAL (250)	// Milliseconds between checks of the CFG file
+
+// Binary cache of the CFG file, only used while its source time matches the CFG file
+#define PROFILE_CACHE_MAGIC (0x43505257)	// "WRPC"
+#define PROFILE_CACHE_VERSION (2)			// Bump when SWiiRemoteProfileStage changes
+struct SWiiRemoteProfileCache
+{
+	unsigned int nMagic;
+	unsigned int nVersion;
+	unsigned int nLayout;		// Layout key of the variables it was made with
+	FILETIME SourceTime;		// Write time of the CFG file it was made from
+	unsigned int nChecksum;		// Checksum of the stage
+	SWiiRemoteProfileStage Stage;
+};
+
+////////////////////////////////////////////////////
+static bool GetProfileWriteTime(char const* szPath, FILETIME &WriteTime)
+{
+	WIN32_FILE_ATTRIBUTE_DATA Data;
+	if (FALSE == GetFileAttributesEx(szPath, GetFileExInfoStandard, &Data)) return false;
+	WriteTime = Data.ftLastWriteTime;
+	return true;
+}
+
+////////////////////////////////////////////////////
+static unsigned int GetProfileChecksum(void const* pData, unsigned int nSize)
+{
+	// FNV-1a
+	unsigned int nHash = 2166136261u;
+	for (unsigned char const* p = (unsigned char const*)pData; nSize > 0; nSize--, p++)
+		nHash = (nHash ^ *p) * 16777619u;
+	return nHash;
+}
 
 CWiiRemoteProfile CWiiRemoteProfile::m_Instance;
 CWiiRemoteProfile* g_WiiRemoteProfile = CWiiRemoteProfile::GetInstance();
@@ -23,16 +57,36 @@ CWiiRemoteProfile* g_WiiRemoteProfile = CWiiRemoteProfile::GetInstance();
 ////////////////////////////////////////////////////
 CWiiRemoteProfile::CWiiRemoteProfile(void)
 {
+	m_pValues = &m_Values[0][0];
+	m_nFront = 0;
+	m_nLayerCount = 1;
+	m_nLayer = 0;
+	memset(m_Overrides, 0, sizeof(m_Overrides));
+	m_bDeferCompile = false;
+	m_bChanged = false;
+	InitializeCriticalSection(&m_csParse);
+	m_nStageReady = 0;
+	m_hWatchThread = INVALID_HANDLE_VALUE;
+	m_dwWatchThreadID = 0;
+	_bWatchThreadProcTerminate = false;
+	m_szFilePath[0] = '\0';
+	m_szCachePath[0] = '\0';
+	m_nLayout = 0;
+
 	// Create variables
 	for (int i = 0; i < EPROFILEVARIABLES_COUNT; i++)
 	{
-		m_Variables[i] = new CWiiRemoteProfileVariable;
+		m_Variables[i] = new CWiiRemoteProfileVariable(this);
 	}
+	BuildIndex();
+	Compile();
 }
 
 ////////////////////////////////////////////////////
 CWiiRemoteProfile::~CWiiRemoteProfile(void)
 {
+	StopWatching();
+
 	// Save configuration before exiting
 	if (false == SaveCFG())
 		CryWarning(VALIDATOR_MODULE_GAME, VALIDATOR_ERROR, "Failed to save Wiisis Remote Configuration");
@@ -42,6 +96,7 @@ CWiiRemoteProfile::~CWiiRemoteProfile(void)
 	{
 		SAFE_DELETE(m_Variables[i]);
 	}
+	DeleteCriticalSection(&m_csParse);
 }
 
 ////////////////////////////////////////////////////
@@ -53,50 +108,182 @@ CWiiRemoteProfile* CWiiRemoteProfile::GetInstance(void)
 ////////////////////////////////////////////////////
 IWiiRemoteProfileVariable* CWiiRemoteProfile::GetVariable(char const* szName, char const* szGroup)
 {
+	int const nID = FindIndex(szName, szGroup);
+	return (-1 == nID ? NULL : m_Variables[nID]);
+}
+
+////////////////////////////////////////////////////
+IWiiRemoteProfileVariable const* CWiiRemoteProfile::GetVariable(char const* szName, char const* szGroup) const
+{
+	int const nID = FindIndex(szName, szGroup);
+	return (-1 == nID ? NULL : m_Variables[nID]);
+}
+
+////////////////////////////////////////////////////
+IWiiRemoteProfileVariable* CWiiRemoteProfile::GetVariable(int nIndex)
+{
+	if (nIndex < 0 || nIndex >= EPROFILEVARIABLES_COUNT)
+		return NULL;
+	return m_Variables[nIndex];
+}
+
+////////////////////////////////////////////////////
+IWiiRemoteProfileVariable const* CWiiRemoteProfile::GetVariable(int nIndex) const
+{
+	if (nIndex < 0 || nIndex >= EPROFILEVARIABLES_COUNT)
+		return NULL;
+	return m_Variables[nIndex];
+}
+
+////////////////////////////////////////////////////
+unsigned int CWiiRemoteProfile::HashKey(char const* szName, char const* szGroup)
+{
+	// FNV-1a over the lower case group and name
+	unsigned int nHash = 2166136261u;
+	for (char const* p = szGroup; '\0' != *p; p++)
+		nHash = (nHash ^ (unsigned char)tolower(*p)) * 16777619u;
+	nHash = (nHash ^ (unsigned char)'/') * 16777619u;
+	for (char const* p = szName; '\0' != *p; p++)
+		nHash = (nHash ^ (unsigned char)tolower(*p)) * 16777619u;
+	return nHash;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteProfile::BuildIndex(void)
+{
+	for (int nSlot = 0; nSlot < WRP_INDEX_SIZE; nSlot++)
+		m_nIndex[nSlot] = -1;
+	m_nLayout = EPROFILEVARIABLES_COUNT;
+
+	// Linear probing, first variable wins on a duplicate name
 	for (int i = 0; i < EPROFILEVARIABLES_COUNT; i++)
 	{
-		if (stricmp(szName, m_Variables[i]->GetName()) == 0 &&
-			stricmp(szGroup, m_Variables[i]->GetGroup()) == 0)
+		char const* szName = m_Variables[i]->GetName();
+		char const* szGroup = m_Variables[i]->GetGroup();
+		m_nLayout = (m_nLayout ^ HashKey(szName, szGroup)) * 16777619u;
+		if ('\0' == *szName || -1 != FindIndex(szName, szGroup)) continue;
+
+		unsigned int nSlot = HashKey(szName, szGroup) & (WRP_INDEX_SIZE-1);
+		while (-1 != m_nIndex[nSlot])
+			nSlot = (nSlot+1) & (WRP_INDEX_SIZE-1);
+		m_nIndex[nSlot] = i;
+	}
+
+	// Layers change what a cache holds too
+	for (int nLayer = 1; nLayer < m_nLayerCount; nLayer++)
+		m_nLayout = (m_nLayout ^ HashKey(m_szLayerNames[nLayer].c_str(), "layer")) * 16777619u;
+}
+
+////////////////////////////////////////////////////
+int CWiiRemoteProfile::FindIndex(char const* szName, char const* szGroup) const
+{
+	if (NULL == szName || NULL == szGroup) return -1;
+
+	unsigned int nSlot = HashKey(szName, szGroup) & (WRP_INDEX_SIZE-1);
+	while (-1 != m_nIndex[nSlot])
+	{
+		int const nID = m_nIndex[nSlot];
+		if (stricmp(szName, m_Variables[nID]->GetName()) == 0 &&
+			stricmp(szGroup, m_Variables[nID]->GetGroup()) == 0)
 		{
-			return m_Variables[i];
+			return nID;
 		}
+		nSlot = (nSlot+1) & (WRP_INDEX_SIZE-1);
 	}
-	return NULL;
+	return -1;
 }
 
 ////////////////////////////////////////////////////
-IWiiRemoteProfileVariable const* CWiiRemoteProfile::GetVariable(char const* szName, char const* szGroup) const
+void CWiiRemoteProfile::OnVariableChanged(void)
+{
+	if (false == m_bDeferCompile)
+		Compile();
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteProfile::Compile(void)
 {
+	// Build into the buffer that is not being read
+	int const nBack = 1 - m_nFront;
+	SWiiRemoteProfileValues &Base = m_Values[nBack][0];
 	for (int i = 0; i < EPROFILEVARIABLES_COUNT; i++)
 	{
-		if (stricmp(szName, m_Variables[i]->GetName()) == 0 &&
-			stricmp(szGroup, m_Variables[i]->GetGroup()) == 0)
+		IWiiRemoteProfileVariable const* pVar = m_Variables[i];
+		Base.fValue[i] = pVar->GetValueFloat();
+		Base.fRadians[i] = DEG2RAD(Base.fValue[i]);
+		Base.nButton[i] = TranslateButton(pVar->GetValueButton());
+		Base.bValue[i] = pVar->GetValueBool();
+	}
+
+	// Flatten each layer's overrides over the base
+	for (int nLayer = 1; nLayer < m_nLayerCount; nLayer++)
+	{
+		SWiiRemoteProfileValues &Values = m_Values[nBack][nLayer];
+		SWiiRemoteProfileLayer const& Overrides = m_Overrides[nLayer];
+		Values = Base;
+		for (int i = 0; i < EPROFILEVARIABLES_COUNT; i++)
 		{
-			return m_Variables[i];
+			if (false == Overrides.bRead[i]) continue;
+			switch (m_Variables[i]->GetType())
+			{
+				case WRP_VARIABLE_FLOAT:
+					Values.fValue[i] = Overrides.fValue[i];
+					Values.fRadians[i] = DEG2RAD(Overrides.fValue[i]);
+				break;
+				case WRP_VARIABLE_BUTTON: Values.nButton[i] = TranslateButton(Overrides.nButton[i]); break;
+				case WRP_VARIABLE_BOOL: Values.bValue[i] = Overrides.bValue[i]; break;
+			}
 		}
 	}
-	return NULL;
+
+	// Swap it in
+	m_nFront = nBack;
+	InterlockedExchangePointer((PVOID volatile*)&m_pValues, &m_Values[nBack][m_nLayer]);
+	m_bChanged = true;
 }
 
 ////////////////////////////////////////////////////
-IWiiRemoteProfileVariable* CWiiRemoteProfile::GetVariable(int nIndex)
+int CWiiRemoteProfile::RegisterLayer(char const* szName)
 {
-	if (nIndex < 0 || nIndex >= EPROFILEVARIABLES_COUNT)
-		return NULL;
-	return m_Variables[nIndex];
+	if (NULL == szName || '\0' == *szName) return 0;
+
+	// Already have it?
+	for (int nLayer = 1; nLayer < m_nLayerCount; nLayer++)
+	{
+		if (stricmp(szName, m_szLayerNames[nLayer].c_str()) == 0)
+			return nLayer;
+	}
+	if (m_nLayerCount >= WRP_MAX_LAYERS) return 0;
+
+	EnterCriticalSection(&m_csParse);
+	int const nLayer = m_nLayerCount++;
+	m_szLayerNames[nLayer] = szName;
+	memset(&m_Overrides[nLayer], 0, sizeof(SWiiRemoteProfileLayer));
+	BuildIndex();
+	LeaveCriticalSection(&m_csParse);
+
+	Compile();
+	return nLayer;
 }
 
 ////////////////////////////////////////////////////
-IWiiRemoteProfileVariable const* CWiiRemoteProfile::GetVariable(int nIndex) const
+void CWiiRemoteProfile::SelectLayer(int nLayer)
 {
-	if (nIndex < 0 || nIndex >= EPROFILEVARIABLES_COUNT)
-		return NULL;
-	return m_Variables[nIndex];
+	if (nLayer < 0 || nLayer >= m_nLayerCount) nLayer = 0;
+	if (nLayer == m_nLayer) return;
+
+	m_nLayer = nLayer;
+	InterlockedExchangePointer((PVOID volatile*)&m_pValues, &m_Values[m_nFront][nLayer]);
+	m_bChanged = true;
 }
 
 ////////////////////////////////////////////////////
 void CWiiRemoteProfile::SetToDefault(void)
 {
+	// Compile once at the end
+	EnterCriticalSection(&m_csParse);
+	m_bDeferCompile = true;
+
 	// Options
 	m_Variables[RetainViewMode]->Initialize("RetainViewMode", "Options", true);
 	m_Variables[HardLockView]->Initialize("HardLockView", "Options", true);
@@ -106,7 +293,17 @@ void CWiiRemoteProfile::SetToDefault(void)
 	m_Variables[IRDotOpacity]->SetRange(0.0f, 1.0f);
 	m_Variables[MaxLockViewDist]->Initialize("MaxLockViewDist", "Options", 250.0f);
 	m_Variables[MaxLockViewDist]->SetRange(1.0f);
+	m_Variables[LockViewConeAngle]->Initialize("LockViewConeAngle", "Options", 5.0f);
+	m_Variables[LockViewConeAngle]->SetRange(0.0f, 45.0f);
 	m_Variables[EnableRumble]->Initialize("EnableRumble", "Options", true);
+	m_Variables[SpeculativeMotion]->Initialize("SpeculativeMotion", "Options", false);
+	m_Variables[EarlyMotion]->Initialize("EarlyMotion", "Options", true);
+	m_Variables[FilterIRCursor]->Initialize("FilterIRCursor", "Options", true);
+	m_Variables[IRFilterMinCutoff]->Initialize("IRFilterMinCutoff", "Options", WR_WIISENSOR_FILTERMINCUTOFF);
+	m_Variables[IRFilterMinCutoff]->SetRange(0.01f, 30.0f);
+	m_Variables[IRFilterBeta]->Initialize("IRFilterBeta", "Options", WR_WIISENSOR_FILTERBETA);
+	m_Variables[IRFilterBeta]->SetRange(0.0f, 100.0f);
+	m_Variables[ThreadedInput]->Initialize("ThreadedInput", "Options", false);
 
 	// Player controls
 	m_Variables[JumpSensitivity]->Initialize("JumpSensitivity", "Player", 2.0f);
@@ -290,6 +487,11 @@ void CWiiRemoteProfile::SetToDefault(void)
 	m_Variables[VTOL_FireGunButton]->Initialize("Button_FireGun", "VTOL", WIIBTN_B);
 	m_Variables[VTOL_FireRocketButton]->Initialize("Button_FireRocket", "VTOL", WIIBTN_HOME);
 	m_Variables[VTOL_ViewButton]->Initialize("Button_View", "VTOL", WIIBTN_1);
+
+	BuildIndex();
+	m_bDeferCompile = false;
+	LeaveCriticalSection(&m_csParse);
+	Compile();
 }
 
 ////////////////////////////////////////////////////
@@ -330,19 +532,334 @@ EWiiButton CWiiRemoteProfile::TranslateStrButton(char const* szName)
 ////////////////////////////////////////////////////
 bool CWiiRemoteProfile::LoadCFG(void)
 {
+	// Use the binary cache if it was made from this file
+	ResolvePaths();
+	FILETIME SourceTime;
+	if (true == GetProfileWriteTime(m_szFilePath, SourceTime) && true == LoadCache(SourceTime, true))
+		return true;
+
 	// Open file for reading
 	XmlNodeRef rootNode = gEnv->pSystem->LoadXmlFile(PROFILE_NAME);
 	if (NULL == rootNode) return false;
 
-	// Let each variable read from it
-	for (int i = 0; i < EPROFILEVARIABLES_COUNT; i++)
-		m_Variables[i]->ReadFromConfig(rootNode);
+	// Read and validate it, then apply
+	SWiiRemoteProfileStage Stage;
+	ParseStage(rootNode, Stage);
+	ApplyStage(Stage);
 
 	return true;
 }
 
 ////////////////////////////////////////////////////
-bool CWiiRemoteProfile::SaveCFG(void) const
+void CWiiRemoteProfile::ParseLayer(XmlNodeRef pNode, SWiiRemoteProfileLayer &Layer)
+{
+	// Walk the node once and validate each entry against its variable
+	int nGroupCount = pNode->getChildCount();
+	for (int nGroup = 0; nGroup < nGroupCount; nGroup++)
+	{
+		XmlNodeRef pGroup = pNode->getChild(nGroup);
+		if (false == pGroup->isTag("group")) continue;
+		char const* szGroup = pGroup->getAttr("name");
+
+		int nEntryCount = pGroup->getChildCount();
+		for (int nEntry = 0; nEntry < nEntryCount; nEntry++)
+		{
+			XmlNodeRef pEntry = pGroup->getChild(nEntry);
+			if (false == pEntry->isTag("entry")) continue;
+
+			int const nID = FindIndex(pEntry->getAttr("name"), szGroup);
+			if (-1 == nID) continue;
+			IWiiRemoteProfileVariable const* pVar = m_Variables[nID];
+
+			// Extract value based on type
+			switch (pVar->GetType())
+			{
+				case WRP_VARIABLE_FLOAT:
+				{
+					float fValue, fMin, fMax;
+					if (false == pEntry->getAttr("value", fValue)) continue;
+					pVar->GetRange(fMin, fMax);
+					if (fValue < fMin || fValue > fMax)
+					{
+						CryLogAlways("[WiiRemoteProfile] [%s] %s = %f is out of range, clamped", pVar->GetGroup(), pVar->GetName(), fValue);
+						fValue = CLAMP(fValue,fMin,fMax);
+					}
+					Layer.fValue[nID] = fValue;
+				}
+				break;
+				case WRP_VARIABLE_BUTTON:
+				{
+					XmlString szButtonName;
+					if (false == pEntry->getAttr("value", szButtonName)) continue;
+					EWiiButton nButton = TranslateStrButton(szButtonName);
+					if (WIIBTN_NONE == nButton)
+					{
+						CryLogAlways("[WiiRemoteProfile] [%s] %s = %s is not a button, ignored", pVar->GetGroup(), pVar->GetName(), szButtonName.c_str());
+						continue;
+					}
+					Layer.nButton[nID] = nButton;
+				}
+				break;
+				case WRP_VARIABLE_BOOL:
+				{
+					bool bValue;
+					if (false == pEntry->getAttr("value", bValue)) continue;
+					Layer.bValue[nID] = bValue;
+				}
+				break;
+				default: continue;
+			}
+			Layer.bRead[nID] = true;
+		}
+	}
+}
+
+////////////////////////////////////////////////////
+bool CWiiRemoteProfile::ParseStage(XmlNodeRef rootNode, SWiiRemoteProfileStage &Stage)
+{
+	memset(&Stage, 0, sizeof(Stage));
+	if (NULL == rootNode) return false;
+
+	EnterCriticalSection(&m_csParse);
+
+	// Base values, then each registered layer
+	ParseLayer(rootNode, Stage.Layers[0]);
+	int nChildCount = rootNode->getChildCount();
+	for (int nChild = 0; nChild < nChildCount; nChild++)
+	{
+		XmlNodeRef pLayer = rootNode->getChild(nChild);
+		if (false == pLayer->isTag("layer")) continue;
+
+		char const* szLayer = pLayer->getAttr("name");
+		for (int nLayer = 1; nLayer < m_nLayerCount; nLayer++)
+		{
+			if (stricmp(szLayer, m_szLayerNames[nLayer].c_str()) == 0)
+			{
+				ParseLayer(pLayer, Stage.Layers[nLayer]);
+				break;
+			}
+		}
+	}
+
+	LeaveCriticalSection(&m_csParse);
+	return true;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteProfile::ApplyStage(SWiiRemoteProfileStage const& Stage)
+{
+	// Compile once at the end
+	m_bDeferCompile = true;
+	SWiiRemoteProfileLayer const& Base = Stage.Layers[0];
+	for (int i = 0; i < EPROFILEVARIABLES_COUNT; i++)
+	{
+		if (false == Base.bRead[i]) continue;
+		switch (m_Variables[i]->GetType())
+		{
+			case WRP_VARIABLE_FLOAT: m_Variables[i]->SetValue(Base.fValue[i]); break;
+			case WRP_VARIABLE_BUTTON: m_Variables[i]->SetValue(Base.nButton[i]); break;
+			case WRP_VARIABLE_BOOL: m_Variables[i]->SetValue(Base.bValue[i]); break;
+		}
+	}
+	for (int nLayer = 1; nLayer < m_nLayerCount; nLayer++)
+		m_Overrides[nLayer] = Stage.Layers[nLayer];
+	m_bDeferCompile = false;
+	Compile();
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteProfile::StartWatching(void)
+{
+	if (INVALID_HANDLE_VALUE != m_hWatchThread) return;
+	ResolvePaths();
+
+	// Create watching thread
+	_bWatchThreadProcTerminate = false;
+	m_hWatchThread = (HANDLE)_beginthreadex(NULL, 0, WatchThreadProc, this, 0, &m_dwWatchThreadID);
+	if (NULL == m_hWatchThread)
+	{
+		m_hWatchThread = INVALID_HANDLE_VALUE;
+		CryWarning(VALIDATOR_MODULE_GAME, VALIDATOR_WARNING, "Failed to watch Wiisis Remote Configuration");
+	}
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteProfile::StopWatching(void)
+{
+	if (INVALID_HANDLE_VALUE == m_hWatchThread) return;
+
+	_bWatchThreadProcTerminate = true;
+	WaitForSingleObject(m_hWatchThread, INFINITE);
+	CloseHandle(m_hWatchThread);
+	m_hWatchThread = INVALID_HANDLE_VALUE;
+}
+
+////////////////////////////////////////////////////
+bool CWiiRemoteProfile::Update(void)
+{
+	if (0 != m_nStageReady)
+	{
+		// Apply the reload and let the watch thread stage the next one
+		ApplyStage(m_Stage);
+		InterlockedExchange(&m_nStageReady, 0);
+		CryLogAlways("[WiiRemoteProfile] Reloaded %s", m_szFilePath);
+	}
+
+	const bool bChanged = m_bChanged;
+	m_bChanged = false;
+	return bChanged;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteProfile::ResolvePaths(void)
+{
+	if ('\0' != m_szFilePath[0]) return;
+
+	char path[_MAX_PATH];
+	const char* szAdjustedPath = gEnv->pCryPak->AdjustFileName(PROFILE_NAME,path,(ICryPak::FLAGS_NO_MASTER_FOLDER_MAPPING|ICryPak::FLAGS_FOR_WRITING));
+	strncpy(m_szFilePath, szAdjustedPath, _MAX_PATH-1);
+	m_szFilePath[_MAX_PATH-1] = '\0';
+	szAdjustedPath = gEnv->pCryPak->AdjustFileName(PROFILE_CACHE_NAME,path,(ICryPak::FLAGS_NO_MASTER_FOLDER_MAPPING|ICryPak::FLAGS_FOR_WRITING));
+	strncpy(m_szCachePath, szAdjustedPath, _MAX_PATH-1);
+	m_szCachePath[_MAX_PATH-1] = '\0';
+}
+
+////////////////////////////////////////////////////
+bool CWiiRemoteProfile::LoadCache(FILETIME const& SourceTime, bool bApply)
+{
+	HANDLE hFile = CreateFile(m_szCachePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (INVALID_HANDLE_VALUE == hFile) return false;
+
+	// Map it and use it in place
+	bool bLoaded = false;
+	if (sizeof(SWiiRemoteProfileCache) == GetFileSize(hFile, NULL))
+	{
+		HANDLE hMapping = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		if (NULL != hMapping)
+		{
+			SWiiRemoteProfileCache const* pCache = (SWiiRemoteProfileCache const*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+			if (NULL != pCache)
+			{
+				if (PROFILE_CACHE_MAGIC == pCache->nMagic && PROFILE_CACHE_VERSION == pCache->nVersion &&
+					m_nLayout == pCache->nLayout && 0 == CompareFileTime(&SourceTime, &pCache->SourceTime) &&
+					GetProfileChecksum(&pCache->Stage, sizeof(pCache->Stage)) == pCache->nChecksum)
+				{
+					if (true == bApply)
+						ApplyStage(pCache->Stage);
+					bLoaded = true;
+				}
+				UnmapViewOfFile(pCache);
+			}
+			CloseHandle(hMapping);
+		}
+	}
+
+	CloseHandle(hFile);
+	return bLoaded;
+}
+
+////////////////////////////////////////////////////
+bool CWiiRemoteProfile::SaveCache(SWiiRemoteProfileStage const& Stage, FILETIME const& SourceTime) const
+{
+	SWiiRemoteProfileCache *pCache = new SWiiRemoteProfileCache;
+	memset(pCache, 0, sizeof(SWiiRemoteProfileCache));
+	pCache->nMagic = PROFILE_CACHE_MAGIC;
+	pCache->nVersion = PROFILE_CACHE_VERSION;
+	pCache->nLayout = m_nLayout;
+	pCache->SourceTime = SourceTime;
+	pCache->Stage = Stage;
+	pCache->nChecksum = GetProfileChecksum(&pCache->Stage, sizeof(pCache->Stage));
+
+	// Write beside it and swap it in, so a reader never sees half a cache
+	char szTemp[_MAX_PATH+4];
+	_snprintf(szTemp, sizeof(szTemp), "%s.tmp", m_szCachePath);
+	szTemp[sizeof(szTemp)-1] = '\0';
+	bool bSaved = false;
+	FILE *pFile = NULL;
+	if (0 == fopen_s(&pFile, szTemp, "wb") && NULL != pFile)
+	{
+		bSaved = (1 == fwrite(pCache, sizeof(SWiiRemoteProfileCache), 1, pFile));
+		fclose(pFile);
+		if (true == bSaved)
+			bSaved = (FALSE != MoveFileEx(szTemp, m_szCachePath, MOVEFILE_REPLACE_EXISTING));
+		if (false == bSaved)
+			DeleteFile(szTemp);
+	}
+
+	SAFE_DELETE(pCache);
+	return bSaved;
+}
+
+////////////////////////////////////////////////////
+unsigned int __stdcall CWiiRemoteProfile::WatchThreadProc(void *pThis)
+{
+	CWiiRemoteProfile *pProfile = (CWiiRemoteProfile*)pThis;
+
+	// Get notified of writes in the folder holding the file
+	char szFolder[_MAX_PATH];
+	strcpy(szFolder, pProfile->m_szFilePath);
+	char *pSlash = strrchr(szFolder, '\\');
+	if (NULL == pSlash) pSlash = strrchr(szFolder, '/');
+	if (NULL != pSlash) *pSlash = '\0';
+	HANDLE hChange = FindFirstChangeNotification(szFolder, FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE);
+
+	// Rebuild the cache in the background if it is out of date
+	FILETIME LastWrite = {0};
+	bool bStale = (true == GetProfileWriteTime(pProfile->m_szFilePath, LastWrite) &&
+		false == pProfile->LoadCache(LastWrite, false));
+	if (true == bStale)
+	{
+		XmlNodeRef rootNode = gEnv->pSystem->LoadXmlFile(pProfile->m_szFilePath);
+		if (NULL != rootNode)
+		{
+			SWiiRemoteProfileStage Stage;
+			pProfile->ParseStage(rootNode, Stage);
+			pProfile->SaveCache(Stage, LastWrite);
+		}
+	}
+
+	bool bPending = false;
+	while (false == pProfile->_bWatchThreadProcTerminate)
+	{
+		// Wait for the folder to change
+		if (INVALID_HANDLE_VALUE != hChange)
+		{
+			if (WAIT_OBJECT_0 == WaitForSingleObject(hChange, PROFILE_WATCH_INTERVAL))
+				FindNextChangeNotification(hChange);
+		}
+		else
+			Sleep(PROFILE_WATCH_INTERVAL);
+
+		// Check if it was the file
+		FILETIME WriteTime;
+		if (true == GetProfileWriteTime(pProfile->m_szFilePath, WriteTime) &&
+			0 != CompareFileTime(&WriteTime, &LastWrite))
+		{
+			LastWrite = WriteTime;
+			bPending = true;
+		}
+
+		// Stage it once the last reload has been applied, keep
+		//	trying while the file can't be read (still being saved)
+		if (true == bPending && 0 == pProfile->m_nStageReady)
+		{
+			XmlNodeRef rootNode = gEnv->pSystem->LoadXmlFile(pProfile->m_szFilePath);
+			if (true == pProfile->ParseStage(rootNode, pProfile->m_Stage))
+			{
+				bPending = false;
+				InterlockedExchange(&pProfile->m_nStageReady, 1);
+				pProfile->SaveCache(pProfile->m_Stage, LastWrite);
+			}
+		}
+	}
+
+	if (INVALID_HANDLE_VALUE != hChange)
+		FindCloseChangeNotification(hChange);
+	return 0;
+}
+
+////////////////////////////////////////////////////
+bool CWiiRemoteProfile::SaveCFG(void)
 {
 	// Open file for reading
 	XmlNodeRef rootNode = gEnv->pSystem->LoadXmlFile(PROFILE_NAME);
@@ -354,15 +871,71 @@ bool CWiiRemoteProfile::SaveCFG(void) const
 			return false;
 	}
 
-	// Let each variable write to it
+	// Walk the file once, updating the entries that are already there
+	bool bWritten[EPROFILEVARIABLES_COUNT] = {false};
+	std::map<string, XmlNodeRef> Groups;
+	int nGroupCount = rootNode->getChildCount();
+	for (int nGroup = 0; nGroup < nGroupCount; nGroup++)
+	{
+		XmlNodeRef pGroup = rootNode->getChild(nGroup);
+		if (false == pGroup->isTag("group")) continue;
+		char const* szGroup = pGroup->getAttr("name");
+		string szKey = szGroup;
+		Groups.insert(std::make_pair(szKey.MakeLower(), pGroup));
+
+		int nEntryCount = pGroup->getChildCount();
+		for (int nEntry = 0; nEntry < nEntryCount; nEntry++)
+		{
+			XmlNodeRef pEntry = pGroup->getChild(nEntry);
+			if (false == pEntry->isTag("entry")) continue;
+
+			int const nID = FindIndex(pEntry->getAttr("name"), szGroup);
+			if (-1 != nID && false == bWritten[nID])
+			{
+				m_Variables[nID]->WriteToEntry(pEntry);
+				bWritten[nID] = true;
+			}
+		}
+	}
+
+	// Add entries for the rest
 	for (int i = 0; i < EPROFILEVARIABLES_COUNT; i++)
-		m_Variables[i]->WriteToConfig(rootNode);
+	{
+		if (true == bWritten[i]) continue;
+
+		string szKey = m_Variables[i]->GetGroup();
+		XmlNodeRef pGroup;
+		std::map<string, XmlNodeRef>::iterator itGroup = Groups.find(szKey.MakeLower());
+		if (Groups.end() == itGroup)
+		{
+			// Make a new one
+			pGroup = rootNode->newChild("group");
+			pGroup->setAttr("name", m_Variables[i]->GetGroup());
+			Groups.insert(std::make_pair(szKey, pGroup));
+		}
+		else
+			pGroup = itGroup->second;
+
+		XmlNodeRef pEntry = pGroup->newChild("entry");
+		pEntry->setAttr("name", m_Variables[i]->GetName());
+		m_Variables[i]->WriteToEntry(pEntry);
+	}
 
 	// Save it out
 	char path[_MAX_PATH];
 	const char* szAdjustedPath = gEnv->pCryPak->AdjustFileName(PROFILE_NAME,path,(ICryPak::FLAGS_NO_MASTER_FOLDER_MAPPING|ICryPak::FLAGS_FOR_WRITING));
 	rootNode->saveToFile(szAdjustedPath);
 
+	// Cache is keyed on the file's write time, make it again for the new one
+	ResolvePaths();
+	FILETIME SourceTime;
+	if (true == GetProfileWriteTime(m_szFilePath, SourceTime))
+	{
+		SWiiRemoteProfileStage Stage;
+		if (true == ParseStage(rootNode, Stage))
+			SaveCache(Stage, SourceTime);
+	}
+
 	return true;
 }
 
@@ -512,8 +1085,9 @@ void CWiiRemoteProfile::wr_list(IConsoleCmdArgs *pArgs)
 }
 
 ////////////////////////////////////////////////////
-CWiiRemoteProfileVariable::CWiiRemoteProfileVariable(void)
+CWiiRemoteProfileVariable::CWiiRemoteProfileVariable(CWiiRemoteProfile *pOwner)
 {
+	m_pOwner = pOwner;
 	m_nType = WRP_VARIABLE_NOTYPE;
 	m_fMin = FLT_MIN;
 	m_fMax = FLT_MAX;
@@ -534,6 +1108,7 @@ void CWiiRemoteProfileVariable::Initialize(char const* szName, char const* szGro
 	m_szGroup = szGroup;
 	m_nType = WRP_VARIABLE_FLOAT;
 	m_fValue = value;
+	m_pOwner->OnVariableChanged();
 }
 
 ////////////////////////////////////////////////////
@@ -543,6 +1118,7 @@ void CWiiRemoteProfileVariable::Initialize(char const* szName, char const* szGro
 	m_szGroup = szGroup;
 	m_nType = WRP_VARIABLE_BUTTON;
 	m_nValue = value;
+	m_pOwner->OnVariableChanged();
 }
 
 ////////////////////////////////////////////////////
@@ -552,6 +1128,7 @@ void CWiiRemoteProfileVariable::Initialize(char const* szName, char const* szGro
 	m_szGroup = szGroup;
 	m_nType = WRP_VARIABLE_BOOL;
 	m_bValue = value;
+	m_pOwner->OnVariableChanged();
 }
 
 ////////////////////////////////////////////////////
@@ -561,6 +1138,13 @@ void CWiiRemoteProfileVariable::SetRange(float min, float max)
 	m_fMax = max;
 }
 
+////////////////////////////////////////////////////
+void CWiiRemoteProfileVariable::GetRange(float &min, float &max) const
+{
+	min = m_fMin;
+	max = m_fMax;
+}
+
 ////////////////////////////////////////////////////
 char const* CWiiRemoteProfileVariable::GetName(void) const
 {
@@ -604,21 +1188,30 @@ bool CWiiRemoteProfileVariable::GetValueBool(void) const
 void CWiiRemoteProfileVariable::SetValue(float value)
 {
 	if (WRP_VARIABLE_FLOAT == m_nType)
+	{
 		m_fValue = CLAMP(value,m_fMin,m_fMax);
+		m_pOwner->OnVariableChanged();
+	}
 }
 
 ////////////////////////////////////////////////////
 void CWiiRemoteProfileVariable::SetValue(EWiiButton value)
 {
 	if (WRP_VARIABLE_BUTTON == m_nType)
+	{
 		m_nValue = (EWiiButton)CLAMP(value,WIIBTN_NONE+1,WIIBTN_MAX-1);
+		m_pOwner->OnVariableChanged();
+	}
 }
 
 ////////////////////////////////////////////////////
 void CWiiRemoteProfileVariable::SetValue(bool value)
 {
 	if (WRP_VARIABLE_BOOL == m_nType)
+	{
 		m_bValue = value;
+		m_pOwner->OnVariableChanged();
+	}
 }
 
 ////////////////////////////////////////////////////
@@ -669,6 +1262,14 @@ void CWiiRemoteProfileVariable::WriteToConfig(XmlNodeRef &pNode) const
 	}
 
 	// Set value
+	WriteToEntry(pEntry);
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteProfileVariable::WriteToEntry(XmlNodeRef &pEntry) const
+{
+	if (NULL == pEntry) return;
+
 	switch (m_nType)
 	{
 		case WRP_VARIABLE_FLOAT:
@@ -717,32 +1318,7 @@ void CWiiRemoteProfileVariable::ReadFromConfig(XmlNodeRef pNode)
 				// Check if this is the one
 				if (m_szName == pEntry->getAttr("name"))
 				{
-					// Extract value based on type
-					switch (m_nType)
-					{
-						case WRP_VARIABLE_FLOAT:
-						{
-							float fValue;
-							pEntry->getAttr("value", fValue);
-							SetValue(fValue);
-						}
-						break;
-						case WRP_VARIABLE_BUTTON:
-						{
-							XmlString szButtonName;
-							pEntry->getAttr("value", szButtonName);
-							SetValue(g_WiiRemoteProfile->TranslateStrButton(szButtonName));
-						}
-						break;
-						case WRP_VARIABLE_BOOL:
-						{
-							bool bValue;
-							pEntry->getAttr("value", bValue);
-							SetValue(bValue);
-						}
-						break;
-					}
-
+					ReadFromEntry(pEntry);
 					break;
 				}
 			}
@@ -750,4 +1326,36 @@ void CWiiRemoteProfileVariable::ReadFromConfig(XmlNodeRef pNode)
 			break;
 		}
 	}
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteProfileVariable::ReadFromEntry(XmlNodeRef pEntry)
+{
+	if (NULL == pEntry) return;
+
+	// Extract value based on type
+	switch (m_nType)
+	{
+		case WRP_VARIABLE_FLOAT:
+		{
+			float fValue;
+			pEntry->getAttr("value", fValue);
+			SetValue(fValue);
+		}
+		break;
+		case WRP_VARIABLE_BUTTON:
+		{
+			XmlString szButtonName;
+			pEntry->getAttr("value", szButtonName);
+			SetValue(g_WiiRemoteProfile->TranslateStrButton(szButtonName));
+		}
+		break;
+		case WRP_VARIABLE_BOOL:
+		{
+			bool bValue;
+			pEntry->getAttr("value", bValue);
+			SetValue(bValue);
+		}
+		break;
+	}
 }
\ No newline at end of file
@@ -22,6 +22,12 @@
 #define WII_IRSENSOR_DEADZONE_UP	(0.45f)
 #define WII_IRSENSOR_DEADZONE_DOWN	(0.55f)
 
+// Slots in the hashed variable index (power of 2, well above the variable count)
+#define WRP_INDEX_SIZE	(512)
+
+// Most layers a profile can have, including the base layer (0)
+#define WRP_MAX_LAYERS	(16)
+
 // Variable IDs
 enum EPROFILEVARIABLES
 {
@@ -31,7 +37,14 @@ enum EPROFILEVARIABLES
 	ShowIRDot,				// TRUE to show the IR Dot on the HUD
 	IRDotOpacity,			// Value between 0 and 1 for opacity of IR Dot on the HUD
 	MaxLockViewDist,		// Maximum distance entity can be to be locked on
+	LockViewConeAngle,		// Degree off the aim an actor can be to be locked on
 	EnableRumble,			// TRUE if rumble is allowed
+	SpeculativeMotion,		// TRUE if gestures start on the first moving update and are rolled back if they fail
+	EarlyMotion,			// TRUE if gestures fire as soon as they are certain instead of when the motion ends
+	FilterIRCursor,			// TRUE to smooth the IR cursor, more so when it moves slowly
+	IRFilterMinCutoff,		// Cutoff frequency (Hz) of the IR cursor filter while still, lower is smoother
+	IRFilterBeta,			// How quickly the IR cursor filter opens up as the cursor speeds up, higher has less lag
+	ThreadedInput,			// TRUE to parse the remote's reports on an input thread as they come in
 
 	JumpSensitivity,		// How many Gs must be applied for jump to occur
 	CrouchTilt,				// Degree remote must be tilted down to toggle crouch
@@ -161,10 +174,55 @@ enum EPROFILEVARIABLES
 	EPROFILEVARIABLES_COUNT,
 };
 
+////////////////////////////////////////////////////
+// SWiiRemoteProfileValues
+//
+// Purpose: Flat copy of every profile value, indexed
+//	by EPROFILEVARIABLES, read by the CHECK_PROFILE_*
+//	macros
+//
+// Note: Compiled by the profile whenever a variable
+//	changes and never written through by readers
+////////////////////////////////////////////////////
+struct __declspec(align(64)) SWiiRemoteProfileValues
+{
+	float fValue[EPROFILEVARIABLES_COUNT];		// Float values as stored
+	float fRadians[EPROFILEVARIABLES_COUNT];	// Float values converted from degrees (for the *Tilt options)
+	int nButton[EPROFILEVARIABLES_COUNT];		// Button values translated to WRLib values
+	bool bValue[EPROFILEVARIABLES_COUNT];		// Bool values
+};
+
+////////////////////////////////////////////////////
+// SWiiRemoteProfileLayer
+//
+// Purpose: Values read for one layer of a CFG file
+////////////////////////////////////////////////////
+struct SWiiRemoteProfileLayer
+{
+	bool bRead[EPROFILEVARIABLES_COUNT];		// TRUE if the variable was in the file
+	float fValue[EPROFILEVARIABLES_COUNT];
+	EWiiButton nButton[EPROFILEVARIABLES_COUNT];
+	bool bValue[EPROFILEVARIABLES_COUNT];
+};
+
+////////////////////////////////////////////////////
+// SWiiRemoteProfileStage
+//
+// Purpose: Values read from a CFG file, validated but
+//	not yet applied to the variables
+////////////////////////////////////////////////////
+struct SWiiRemoteProfileStage
+{
+	SWiiRemoteProfileLayer Layers[WRP_MAX_LAYERS];	// Base values, then the overrides of each layer
+};
+
+class CWiiRemoteProfile;
+
 ////////////////////////////////////////////////////
 class CWiiRemoteProfileVariable : public IWiiRemoteProfileVariable
 {
 protected:
+	CWiiRemoteProfile *m_pOwner;	// Profile to tell about value changes
 	int m_nType;	// Variable type
 	string m_szName;
 	string m_szGroup;
@@ -182,8 +240,10 @@ protected:
 public:
 	////////////////////////////////////////////////////
 	// Constructor
+	//
+	// In:	pOwner - Profile that owns the variable
 	////////////////////////////////////////////////////
-	CWiiRemoteProfileVariable(void);
+	CWiiRemoteProfileVariable(CWiiRemoteProfile *pOwner);
 private:
 	CWiiRemoteProfileVariable(CWiiRemoteProfileVariable const&) {}
 	CWiiRemoteProfileVariable& operator =(CWiiRemoteProfileVariable const&) {return *this;}
@@ -217,6 +277,16 @@ public:
 	////////////////////////////////////////////////////
 	virtual void SetRange(float min = FLT_MIN, float max = FLT_MAX);
 
+	////////////////////////////////////////////////////
+	// GetRange
+	//
+	// Purpose: Get the range of the variable (for floats)
+	//
+	// Out:	min - Minimum value
+	//		max - Maximum value
+	////////////////////////////////////////////////////
+	virtual void GetRange(float &min, float &max) const;
+
 	////////////////////////////////////////////////////
 	// GetName
 	//
@@ -277,6 +347,26 @@ public:
 	// In:	pNode - Config file node
 	////////////////////////////////////////////////////
 	virtual void ReadFromConfig(XmlNodeRef pNode);
+
+	////////////////////////////////////////////////////
+	// WriteToEntry
+	//
+	// Purpose: Write the value to the variable's own
+	//	entry node in the config
+	//
+	// In:	pEntry - Entry node of the variable
+	////////////////////////////////////////////////////
+	virtual void WriteToEntry(XmlNodeRef &pEntry) const;
+
+	////////////////////////////////////////////////////
+	// ReadFromEntry
+	//
+	// Purpose: Read the value from the variable's own
+	//	entry node in the config
+	//
+	// In:	pEntry - Entry node of the variable
+	////////////////////////////////////////////////////
+	virtual void ReadFromEntry(XmlNodeRef pEntry);
 };
 
 ////////////////////////////////////////////////////
@@ -286,6 +376,30 @@ protected:
 	// Variables
 	IWiiRemoteProfileVariable* m_Variables[EPROFILEVARIABLES_COUNT];
 
+	// Hashed group/name index, holds variable IDs or -1 for an empty slot
+	int m_nIndex[WRP_INDEX_SIZE];
+	unsigned int m_nLayout;	// Hash of every group/name in ID order, changes when the variables do
+
+	// Layers, each overriding some of the base values
+	string m_szLayerNames[WRP_MAX_LAYERS];
+	SWiiRemoteProfileLayer m_Overrides[WRP_MAX_LAYERS];
+	int m_nLayerCount;
+	int m_nLayer;	// Selected layer
+
+	// Compiled values of every layer, swapped on each compile
+	SWiiRemoteProfileValues m_Values[2][WRP_MAX_LAYERS];
+	SWiiRemoteProfileValues* volatile m_pValues;
+	int m_nFront;	// Buffer being read
+	bool m_bDeferCompile;	// TRUE while many variables are being changed at once
+	bool m_bChanged;		// TRUE if the values read changed since the last Update
+
+	// Guards the variable names and index while a CFG file is parsed
+	CRITICAL_SECTION m_csParse;
+
+	// Reload staged by the watch thread, applied on the next Update
+	SWiiRemoteProfileStage m_Stage;
+	volatile LONG m_nStageReady;
+
 private:
 	////////////////////////////////////////////////////
 	// Constructor
@@ -324,6 +438,50 @@ public:
 	virtual IWiiRemoteProfileVariable* GetVariable(int nIndex);
 	virtual IWiiRemoteProfileVariable const* GetVariable(int nIndex) const;
 
+	////////////////////////////////////////////////////
+	// RegisterLayer
+	//
+	// Purpose: Add a layer of overrides, read from the
+	//	<layer name="..."> node of the CFG file
+	//
+	// In:	szName - Name of the layer
+	//
+	// Returns layer ID, or 0 (the base layer) if there
+	//	is no room left
+	//
+	// Note: Register layers before loading the CFG file
+	////////////////////////////////////////////////////
+	virtual int RegisterLayer(char const* szName);
+
+	////////////////////////////////////////////////////
+	// SelectLayer
+	//
+	// Purpose: Select which layer's values are read by
+	//	the CHECK_PROFILE_* macros
+	//
+	// In:	nLayer - Layer ID
+	////////////////////////////////////////////////////
+	virtual void SelectLayer(int nLayer);
+
+	////////////////////////////////////////////////////
+	// GetValues
+	//
+	// Purpose: Get the compiled values of the selected
+	//	layer
+	//
+	// Note: Inline, this is what the CHECK_PROFILE_*
+	//	macros expand to
+	////////////////////////////////////////////////////
+	SWiiRemoteProfileValues const* GetValues(void) const { return m_pValues; }
+
+	////////////////////////////////////////////////////
+	// OnVariableChanged
+	//
+	// Purpose: Called by a variable when its value has
+	//	changed so the compiled values can be rebuilt
+	////////////////////////////////////////////////////
+	virtual void OnVariableChanged(void);
+
 	////////////////////////////////////////////////////
 	// SetToDefault
 	//
@@ -370,8 +528,39 @@ public:
 	// Purpose: Save the CFG file for the active user
 	//
 	// Returns TRUE if it was saved
+	//
+	// Note: Writes the cache again too, so saving does
+	//	not make the next LoadCFG miss it
+	////////////////////////////////////////////////////
+	virtual bool SaveCFG(void);
+
+	////////////////////////////////////////////////////
+	// StartWatching
+	//
+	// Purpose: Start watching the CFG file for changes
+	//	so it is reloaded while playing
+	////////////////////////////////////////////////////
+	virtual void StartWatching(void);
+
+	////////////////////////////////////////////////////
+	// StopWatching
+	//
+	// Purpose: Stop watching the CFG file
+	////////////////////////////////////////////////////
+	virtual void StopWatching(void);
+
+	////////////////////////////////////////////////////
+	// Update
+	//
+	// Purpose: Apply a reloaded CFG file, if one is
+	//	ready
+	//
+	// Returns TRUE if the values changed since the last
+	//	call (reload, wr_set or a layer switch)
+	//
+	// Note: Call once per frame from the game thread
 	////////////////////////////////////////////////////
-	virtual bool SaveCFG(void) const;
+	virtual bool Update(void);
 
 	////////////////////////////////////////////////////
 	// RegisterConsoleCommands
@@ -392,6 +581,132 @@ public:
 	virtual void UnregisterConsoleCommands(struct IConsole *pConsole) const;
 
 protected:
+	////////////////////////////////////////////////////
+	// Compile
+	//
+	// Purpose: Rebuild the compiled values into the back
+	//	buffer and swap it in
+	////////////////////////////////////////////////////
+	virtual void Compile(void);
+
+	////////////////////////////////////////////////////
+	// BuildIndex
+	//
+	// Purpose: Rebuild the hashed group/name index
+	////////////////////////////////////////////////////
+	virtual void BuildIndex(void);
+
+	////////////////////////////////////////////////////
+	// FindIndex
+	//
+	// Purpose: Look up a variable in the hashed index
+	//
+	// In:	szName - Name of the variable
+	//		szGroup - Group name of the variable
+	//
+	// Returns variable ID or -1 if not found
+	//
+	// Note: Case insensitive
+	////////////////////////////////////////////////////
+	virtual int FindIndex(char const* szName, char const* szGroup) const;
+
+	////////////////////////////////////////////////////
+	// HashKey
+	//
+	// Purpose: Case insensitive hash of a group/name pair
+	////////////////////////////////////////////////////
+	static unsigned int HashKey(char const* szName, char const* szGroup);
+
+	////////////////////////////////////////////////////
+	// ParseLayer
+	//
+	// Purpose: Read and validate the groups under a node
+	//	of a CFG file
+	//
+	// In:	pNode - Root or layer node
+	//
+	// Out:	Layer - Values that were read
+	//
+	// Note: Call with m_csParse held
+	////////////////////////////////////////////////////
+	virtual void ParseLayer(XmlNodeRef pNode, SWiiRemoteProfileLayer &Layer);
+
+	////////////////////////////////////////////////////
+	// ParseStage
+	//
+	// Purpose: Read and validate the values of a CFG
+	//	file without applying them
+	//
+	// In:	rootNode - Root node of the CFG file
+	//
+	// Out:	Stage - Values that were read
+	//
+	// Returns FALSE if the file could not be read
+	//
+	// Note: Safe to call from the watch thread
+	////////////////////////////////////////////////////
+	virtual bool ParseStage(XmlNodeRef rootNode, SWiiRemoteProfileStage &Stage);
+
+	////////////////////////////////////////////////////
+	// ApplyStage
+	//
+	// Purpose: Apply staged base values to the variables
+	//	and overrides to the layers, and compile them once
+	//
+	// In:	Stage - Values to apply
+	////////////////////////////////////////////////////
+	virtual void ApplyStage(SWiiRemoteProfileStage const& Stage);
+
+	////////////////////////////////////////////////////
+	// WatchThreadProc
+	//
+	// Purpose: CFG file watching thread procedure
+	//
+	// In:	pThis - Pointer to the profile
+	//
+	// Returns non-zero on error
+	////////////////////////////////////////////////////
+	static unsigned int __stdcall WatchThreadProc(void *pThis);
+	HANDLE m_hWatchThread;
+	unsigned int m_dwWatchThreadID;
+	volatile bool _bWatchThreadProcTerminate;
+
+	////////////////////////////////////////////////////
+	// ResolvePaths
+	//
+	// Purpose: Find the real paths of the CFG file and
+	//	its binary cache
+	////////////////////////////////////////////////////
+	virtual void ResolvePaths(void);
+	char m_szFilePath[_MAX_PATH];
+	char m_szCachePath[_MAX_PATH];
+
+	////////////////////////////////////////////////////
+	// LoadCache
+	//
+	// Purpose: Map the binary cache of the CFG file and
+	//	apply it if it is current
+	//
+	// In:	SourceTime - Write time of the CFG file
+	//		bApply - FALSE to only check that the cache
+	//			is current
+	//
+	// Returns TRUE if the cache is current
+	////////////////////////////////////////////////////
+	virtual bool LoadCache(FILETIME const& SourceTime, bool bApply);
+
+	////////////////////////////////////////////////////
+	// SaveCache
+	//
+	// Purpose: Write the binary cache of the CFG file
+	//
+	// In:	Stage - Values read from the CFG file
+	//		SourceTime - Write time of the CFG file
+	//
+	// Returns TRUE if it was saved
+	////////////////////////////////////////////////////
+	virtual bool SaveCache(SWiiRemoteProfileStage const& Stage, FILETIME const& SourceTime) const;
+
 	static void wr_get(IConsoleCmdArgs *pArgs);
 	static void wr_set(IConsoleCmdArgs *pArgs);
 	static void wr_reset(IConsoleCmdArgs *pArgs);
@@ -412,7 +727,17 @@ extern CWiiRemoteProfile* g_WiiRemoteProfile;
 //
 // In:	option - Option to check i.e. "JumpSensitivity"
 ////////////////////////////////////////////////////
-#define CHECK_PROFILE_FLOAT(option) g_WiiRemoteProfile->GetVariable(option)->GetValueFloat()
+#define CHECK_PROFILE_FLOAT(option) (g_WiiRemoteProfile->GetValues()->fValue[option])
+
+////////////////////////////////////////////////////
+// CHECK_PROFILE_RADIANS
+//
+// Purpose: Check the value of a profile option that
+//	is stored in degrees, converted to radians
+//
+// In:	option - Option to check i.e. "CrouchTilt"
+////////////////////////////////////////////////////
+#define CHECK_PROFILE_RADIANS(option) (g_WiiRemoteProfile->GetValues()->fRadians[option])
 
 ////////////////////////////////////////////////////
 // CHECK_PROFILE_BOOL
@@ -421,7 +746,7 @@ extern CWiiRemoteProfile* g_WiiRemoteProfile;
 //
 // In:	option - Option to check i.e. "UseIRSensor"
 ////////////////////////////////////////////////////
-#define CHECK_PROFILE_BOOL(option) g_WiiRemoteProfile->GetVariable(option)->GetValueBool()
+#define CHECK_PROFILE_BOOL(option) (g_WiiRemoteProfile->GetValues()->bValue[option])
 
 ////////////////////////////////////////////////////
 // CHECK_PROFILE_BUTTON
@@ -432,7 +757,7 @@ extern CWiiRemoteProfile* g_WiiRemoteProfile;
 // In:	option - Option to check i.e. "Sprint" for
 //	"SprintButton"
 ////////////////////////////////////////////////////
-#define CHECK_PROFILE_BUTTON(option) g_WiiRemoteProfile->TranslateButton(g_WiiRemoteProfile->GetVariable(option##Button)->GetValueButton())
+#define CHECK_PROFILE_BUTTON(option) (g_WiiRemoteProfile->GetValues()->nButton[option##Button])
 
 
 #endif //_CWIIREMOTEPROFILE_H_
\ No newline at end of file
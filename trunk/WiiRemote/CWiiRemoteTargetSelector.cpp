@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////
+// Wii Remote Game File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// CWiiRemoteTargetSelector.cpp
+//
+// Purpose: Picks the actor to lock the view on to
+//	from those in a cone around the aim
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "CWiiRemoteTargetSelector.h"
+#include "CWiiRemoteProfile.h"
+
+// Crysis files
+#include "Game.h"
+#include "Player.h"
+#include "OffHand.h"
+#include "IVehicleSystem.h"
+
+CWiiRemoteTargetSelector *CWiiRemoteTargetSelector::m_pActive = NULL;
+
+////////////////////////////////////////////////////
+CWiiRemoteTargetSelector::CWiiRemoteTargetSelector(void)
+{
+	m_nCandidates = 0;
+	m_fScanTime = 0.0f;
+	m_nTarget = 0;
+	m_nRaySeq = 0;
+	m_nRaysPending = 0;
+	for (int i = 0; i < TARGET_VERIFY_COUNT; i++)
+		m_bRayInFlight[i] = false;
+}
+
+////////////////////////////////////////////////////
+CWiiRemoteTargetSelector::~CWiiRemoteTargetSelector(void)
+{
+	Shutdown();
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteTargetSelector::Initialize(void)
+{
+	if (NULL != m_pActive) return;
+	m_pActive = this;
+	gEnv->pPhysicalWorld->AddEventClient(EventPhysRWIResult::id, OnRayResult, 1);
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteTargetSelector::Shutdown(void)
+{
+	if (this != m_pActive) return;
+	Reset();
+	if (NULL != gEnv->pPhysicalWorld)
+		gEnv->pPhysicalWorld->RemoveEventClient(EventPhysRWIResult::id, OnRayResult, 1);
+	m_pActive = NULL;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteTargetSelector::Reset(void)
+{
+	// Rays still in flight no longer match the sequence, but keep
+	//	m_bRayInFlight until physics is done with their buffers
+	m_nRaySeq = (m_nRaySeq+1) & 0x07FFFFFF;
+	m_nRaysPending = 0;
+	m_nCandidates = 0;
+	m_fScanTime = 0.0f;
+	m_nTarget = 0;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteTargetSelector::Update(CPlayer *pPlayer, Vec3 const& vPos, Vec3 const& vDir)
+{
+	if (NULL == pPlayer) return;
+
+	// Scan again once the candidates are old, otherwise keep checking them
+	if (gEnv->pTimer->GetCurrTime() - m_fScanTime > TARGET_RESCAN_TIME)
+		Scan(pPlayer, vPos, vDir);
+	else
+		Verify(pPlayer, vPos);
+}
+
+////////////////////////////////////////////////////
+EntityId CWiiRemoteTargetSelector::GetTarget(void) const
+{
+	return m_nTarget;
+}
+
+////////////////////////////////////////////////////
+int CWiiRemoteTargetSelector::GetSkipEntities(CPlayer *pPlayer, IPhysicalEntity **pSkip)
+{
+	int nSkip = 0;
+	pSkip[nSkip++] = pPlayer->GetEntity()->GetPhysics();
+	if (IVehicle *pVehicle = pPlayer->GetLinkedVehicle())
+		pSkip[nSkip++] = pVehicle->GetEntity()->GetPhysics();
+	COffHand* pOffHand = static_cast<COffHand*>(pPlayer->GetWeaponByClass(CItem::sOffHandClass));
+	if (NULL != pOffHand && pOffHand->GetOffHandState()&(eOHS_HOLDING_OBJECT|eOHS_HOLDING_NPC|eOHS_THROWING_OBJECT|eOHS_THROWING_NPC))
+	{
+		// Try to ignore the object picked up as well
+		if (IEntity *pEnt = gEnv->pEntitySystem->GetEntity(pOffHand->GetHeldEntityId()))
+			pSkip[nSkip++] = pEnt->GetPhysics();
+	}
+	return nSkip;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteTargetSelector::Scan(CPlayer *pPlayer, Vec3 const& vPos, Vec3 const& vDir)
+{
+	const float fCurrTime = gEnv->pTimer->GetCurrTime();
+	const float fMaxDist = CHECK_PROFILE_FLOAT(MaxLockViewDist);
+	const float fConeAngle = MAX(CHECK_PROFILE_RADIANS(LockViewConeAngle), 0.001f);
+	const float fConeCos = cosf(fConeAngle);
+
+	// Drop the old candidates and their rays
+	m_nRaySeq = (m_nRaySeq+1) & 0x07FFFFFF;
+	m_nRaysPending = 0;
+	m_nCandidates = 0;
+	m_fScanTime = fCurrTime;
+	bool bHaveTarget = false;
+
+	// Box around the cone
+	const Vec3 vEnd = vPos + vDir*fMaxDist;
+	const float fRadius = fMaxDist * tanf(fConeAngle);
+	Vec3 vMin(MIN(vPos.x,vEnd.x)-fRadius, MIN(vPos.y,vEnd.y)-fRadius, MIN(vPos.z,vEnd.z)-fRadius);
+	Vec3 vMax(MAX(vPos.x,vEnd.x)+fRadius, MAX(vPos.y,vEnd.y)+fRadius, MAX(vPos.z,vEnd.z)+fRadius);
+	IPhysicalEntity **pList = NULL;
+	int nCount = gEnv->pPhysicalWorld->GetEntitiesInBox(vMin, vMax, pList, ent_living);
+
+	IActorSystem *pActorSystem = g_pGame->GetIGameFramework()->GetIActorSystem();
+	for (int i = 0; i < nCount; i++)
+	{
+		IEntity *pEnt = (IEntity*)pList[i]->GetForeignData(PHYS_FOREIGN_ID_ENTITY);
+		if (NULL == pEnt || pEnt->GetId() == pPlayer->GetEntityId()) continue;
+
+		// Only living actors
+		IActor *pActor = pActorSystem->GetActor(pEnt->GetId());
+		if (NULL == pActor || pActor->GetHealth() <= 0) continue;
+
+		// Same point the view locks on to
+		AABB aabb;
+		pEnt->GetWorldBounds(aabb);
+		Vec3 vTargetPos = aabb.GetCenter()+Vec3(0.f,0.f,(aabb.max.z-aabb.min.z)*0.25f);
+
+		// Must be within the cone
+		Vec3 vTo = vTargetPos - vPos;
+		float fDist = vTo.GetLength();
+		if (fDist <= 0.0f || fDist > fMaxDist) continue;
+		float fCos = vTo.Dot(vDir) / fDist;
+		if (fCos < fConeCos) continue;
+
+		// Closer to the aim, nearer and on screen scores higher
+		float fScore = TARGET_ANGLE_WEIGHT * (1.0f - acos_tpl(CLAMP(fCos,-1.0f,1.0f))/fConeAngle);
+		fScore += TARGET_DISTANCE_WEIGHT * (1.0f - fDist/fMaxDist);
+		if (IEntityRenderProxy *pRenderProxy = (IEntityRenderProxy*)pEnt->GetProxy(ENTITY_PROXY_RENDER))
+			if (fCurrTime - pRenderProxy->GetLastSeenTime() <= TARGET_SEEN_TIME)
+				fScore += TARGET_VISIBLE_WEIGHT;
+		if (pEnt->GetId() == m_nTarget)
+		{
+			fScore += TARGET_CURRENT_WEIGHT;
+			bHaveTarget = true;
+		}
+
+		// Insert by score, dropping the worst when full
+		int nSlot = m_nCandidates;
+		while (nSlot > 0 && m_Candidates[nSlot-1].fScore < fScore)
+		{
+			if (nSlot < TARGET_MAX_CANDIDATES)
+				m_Candidates[nSlot] = m_Candidates[nSlot-1];
+			nSlot--;
+		}
+		if (nSlot >= TARGET_MAX_CANDIDATES) continue;
+		m_Candidates[nSlot].nEntityId = pEnt->GetId();
+		m_Candidates[nSlot].vPos = vTargetPos;
+		m_Candidates[nSlot].fScore = fScore;
+		m_Candidates[nSlot].nSight = TARGET_SIGHT_UNKNOWN;
+		if (m_nCandidates < TARGET_MAX_CANDIDATES)
+			m_nCandidates++;
+	}
+
+	// Keep the current target until its sight is checked again
+	if (false == bHaveTarget)
+		m_nTarget = 0;
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteTargetSelector::Verify(CPlayer *pPlayer, Vec3 const& vPos)
+{
+	if (m_nRaysPending >= TARGET_MAX_RAYS_PENDING) return;
+
+	IPhysicalEntity *pSkip[TARGET_MAX_SKIP];
+	int nSkip = GetSkipEntities(pPlayer, pSkip);
+
+	// Check the best candidates not yet known
+	const int nVerify = MIN(m_nCandidates, TARGET_VERIFY_COUNT);
+	for (int i = 0; i < nVerify && m_nRaysPending < TARGET_MAX_RAYS_PENDING; i++)
+	{
+		STargetCandidate &candidate = m_Candidates[i];
+		if (TARGET_SIGHT_UNKNOWN != candidate.nSight) continue;
+
+		// A dropped ray may still be writing into this buffer
+		if (true == m_bRayInFlight[i]) continue;
+
+		candidate.nSight = TARGET_SIGHT_PENDING;
+		m_nRaysPending++;
+		m_bRayInFlight[i] = true;
+		gEnv->pPhysicalWorld->RayWorldIntersection(vPos, candidate.vPos-vPos, (ent_terrain|ent_static|ent_rigid|ent_sleeping_rigid|ent_living),
+			(rwi_stop_at_pierceable|rwi_colltype_any|rwi_ignore_back_faces|rwi_queue), &m_RayBuffer[i], 1, pSkip, nSkip, this, (m_nRaySeq<<4)|i);
+	}
+}
+
+////////////////////////////////////////////////////
+void CWiiRemoteTargetSelector::PickTarget(void)
+{
+	const int nVerify = MIN(m_nCandidates, TARGET_VERIFY_COUNT);
+
+	// Drop the current target as soon as it is out of sight
+	for (int i = 0; i < nVerify; i++)
+	{
+		if (m_nTarget == m_Candidates[i].nEntityId && TARGET_SIGHT_BLOCKED == m_Candidates[i].nSight)
+			m_nTarget = 0;
+	}
+
+	for (int i = 0; i < nVerify; i++)
+	{
+		if (TARGET_SIGHT_CLEAR == m_Candidates[i].nSight)
+		{
+			m_nTarget = m_Candidates[i].nEntityId;
+			return;
+		}
+		if (TARGET_SIGHT_BLOCKED != m_Candidates[i].nSight)
+			return; // Wait on the better one
+	}
+
+	// None of the best are in sight
+	m_nTarget = 0;
+}
+
+////////////////////////////////////////////////////
+int CWiiRemoteTargetSelector::OnRayResult(EventPhys const* pEvent)
+{
+	EventPhysRWIResult const* pResult = (EventPhysRWIResult const*)pEvent;
+
+	// Other systems queue rays too
+	CWiiRemoteTargetSelector *pSelector = m_pActive;
+	if (NULL == pSelector || pResult->pForeignData != pSelector) return 1;
+
+	// Buffer is free again, even for a stale result
+	int nCandidate = (pResult->iForeignData&0xF);
+	if (nCandidate < TARGET_VERIFY_COUNT)
+		pSelector->m_bRayInFlight[nCandidate] = false;
+	if ((pResult->iForeignData>>4) != pSelector->m_nRaySeq) return 1;
+	if (nCandidate >= pSelector->m_nCandidates) return 1;
+	STargetCandidate &candidate = pSelector->m_Candidates[nCandidate];
+	if (TARGET_SIGHT_PENDING != candidate.nSight) return 1;
+
+	// In sight if nothing is hit before the candidate itself
+	candidate.nSight = TARGET_SIGHT_CLEAR;
+	if (pResult->nHits > 0 && NULL != pResult->pHits && NULL != pResult->pHits[0].pCollider)
+	{
+		IEntity *pEnt = (IEntity*)pResult->pHits[0].pCollider->GetForeignData(PHYS_FOREIGN_ID_ENTITY);
+		if (NULL == pEnt || pEnt->GetId() != candidate.nEntityId)
+			candidate.nSight = TARGET_SIGHT_BLOCKED;
+	}
+
+	pSelector->m_nRaysPending--;
+	pSelector->PickTarget();
+	return 1;
+}
\ No newline at end of file
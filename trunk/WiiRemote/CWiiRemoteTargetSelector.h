@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////
+// Wii Remote Game File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// CWiiRemoteTargetSelector.h
+//
+// Purpose: Picks the actor to lock the view on to
+//	from those in a cone around the aim
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _CWIIREMOTETARGETSELECTOR_H_
+#define _CWIIREMOTETARGETSELECTOR_H_
+
+#define TARGET_MAX_CANDIDATES (16)	// Best scored actors kept from a scan
+#define TARGET_MAX_SKIP (3)			// Physical entities rays skip, see GetSkipEntities
+#define TARGET_VERIFY_COUNT (3)		// Best candidates checked for line of sight
+#define TARGET_MAX_RAYS_PENDING (1)	// Line of sight rays in flight at once
+#define TARGET_RESCAN_TIME (0.25f)	// How long a scan's candidates are used
+#define TARGET_SEEN_TIME (0.5f)		// How recently an actor must have been rendered to count as visible
+
+// Score weights
+#define TARGET_ANGLE_WEIGHT (1.0f)
+#define TARGET_DISTANCE_WEIGHT (0.5f)
+#define TARGET_VISIBLE_WEIGHT (0.5f)
+#define TARGET_CURRENT_WEIGHT (0.25f) // Keeps the current target over ones scoring about the same
+
+// Candidate line of sight
+enum ETargetSight
+{
+	TARGET_SIGHT_UNKNOWN = 0,
+	TARGET_SIGHT_PENDING,
+	TARGET_SIGHT_CLEAR,
+	TARGET_SIGHT_BLOCKED,
+};
+
+// Actor in the view cone
+struct STargetCandidate
+{
+	EntityId nEntityId;
+	Vec3 vPos; // Point looked at
+	float fScore;
+	int nSight;
+
+	STargetCandidate(void) : nEntityId(0), vPos(0,0,0), fScore(0), nSight(TARGET_SIGHT_UNKNOWN) {}
+};
+
+class CWiiRemoteTargetSelector
+{
+protected:
+	// Candidates, best score first
+	STargetCandidate m_Candidates[TARGET_MAX_CANDIDATES];
+	int m_nCandidates;
+	float m_fScanTime;
+
+	// Picked target
+	EntityId m_nTarget;
+
+	// Line of sight rays queued with physics
+	ray_hit m_RayBuffer[TARGET_VERIFY_COUNT];
+	int m_nRaySeq;
+	int m_nRaysPending;
+	bool m_bRayInFlight[TARGET_VERIFY_COUNT]; // Physics may still write the buffer, only OnRayResult clears it
+
+	// Selector rays are reported to
+	static CWiiRemoteTargetSelector *m_pActive;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWiiRemoteTargetSelector(void);
+private:
+	CWiiRemoteTargetSelector(CWiiRemoteTargetSelector const&) {}
+	CWiiRemoteTargetSelector& operator =(CWiiRemoteTargetSelector const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWiiRemoteTargetSelector(void);
+
+	////////////////////////////////////////////////////
+	// Initialize
+	//
+	// Purpose: Start listening for ray results
+	////////////////////////////////////////////////////
+	virtual void Initialize(void);
+
+	////////////////////////////////////////////////////
+	// Shutdown
+	//
+	// Purpose: Stop listening for ray results
+	////////////////////////////////////////////////////
+	virtual void Shutdown(void);
+
+	////////////////////////////////////////////////////
+	// Reset
+	//
+	// Purpose: Drop the candidates, target and any rays
+	//	still queued
+	////////////////////////////////////////////////////
+	virtual void Reset(void);
+
+	////////////////////////////////////////////////////
+	// Update
+	//
+	// Purpose: Scan the view cone or check the next
+	//	candidates' line of sight
+	//
+	// In:	pPlayer - Client player
+	//		vPos - Eye position
+	//		vDir - Aim direction
+	//
+	// Note: Does one box query or queues rays while
+	//	fewer than TARGET_MAX_RAYS_PENDING are in flight
+	////////////////////////////////////////////////////
+	virtual void Update(class CPlayer *pPlayer, Vec3 const& vPos, Vec3 const& vDir);
+
+	////////////////////////////////////////////////////
+	// GetTarget
+	//
+	// Purpose: Returns the actor picked to lock on to,
+	//	or 0 if none is yet
+	////////////////////////////////////////////////////
+	virtual EntityId GetTarget(void) const;
+
+	////////////////////////////////////////////////////
+	// GetSkipEntities
+	//
+	// Purpose: Get the physical entities lock view rays
+	//	should pass through
+	//
+	// In:	pPlayer - Client player
+	//
+	// Out:	pSkip - Entities to skip, holds TARGET_MAX_SKIP
+	//
+	// Returns how many were set
+	////////////////////////////////////////////////////
+	static int GetSkipEntities(class CPlayer *pPlayer, IPhysicalEntity **pSkip);
+
+protected:
+	////////////////////////////////////////////////////
+	// Scan
+	//
+	// Purpose: Find and score the actors in the view cone
+	//	with one box query
+	//
+	// In:	pPlayer - Client player
+	//		vPos - Eye position
+	//		vDir - Aim direction
+	////////////////////////////////////////////////////
+	virtual void Scan(class CPlayer *pPlayer, Vec3 const& vPos, Vec3 const& vDir);
+
+	////////////////////////////////////////////////////
+	// Verify
+	//
+	// Purpose: Queue line of sight rays to the best
+	//	candidates not yet checked
+	//
+	// In:	pPlayer - Client player
+	//		vPos - Eye position
+	////////////////////////////////////////////////////
+	virtual void Verify(class CPlayer *pPlayer, Vec3 const& vPos);
+
+	////////////////////////////////////////////////////
+	// PickTarget
+	//
+	// Purpose: Pick the best candidate known to be in
+	//	sight, once every better one is known not to be
+	//
+	// Note: The current target is dropped right away if
+	//	it is found out of sight
+	////////////////////////////////////////////////////
+	virtual void PickTarget(void);
+
+	////////////////////////////////////////////////////
+	// OnRayResult
+	//
+	// Purpose: Physics callback for a queued line of
+	//	sight ray
+	//
+	// In:	pEvent - Ray result event
+	////////////////////////////////////////////////////
+	static int OnRayResult(EventPhys const* pEvent);
+};
+
+#endif //_CWIIREMOTETARGETSELECTOR_H_
\ No newline at end of file
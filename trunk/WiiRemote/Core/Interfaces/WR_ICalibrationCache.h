@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_ICalibrationCache.h
+//
+// Purpose: Interface object
+//	Describes a persistent store of calibration data
+//	read from each device
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_ICALIBRATIONCACHE_H_
+#define _WR_ICALIBRATIONCACHE_H_
+
+#include "WR_IWiiData.h"
+
+// Largest calibration block that can be cached
+#define WR_CALIBRATION_MAXSIZE	(16)
+
+struct IWR_CalibrationCache
+{
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~IWR_CalibrationCache(void) { }
+
+	////////////////////////////////////////////////////
+	// Load
+	//
+	// Purpose: Load the cache from file
+	//
+	// In:	szFile - File to load from and save to
+	//
+	// Returns TRUE if the file was read
+	//
+	// Note: The file is remembered even if it does
+	//	not exist yet, so later changes are saved to it
+	////////////////////////////////////////////////////
+	virtual bool Load(char const* szFile) = 0;
+
+	////////////////////////////////////////////////////
+	// Save
+	//
+	// Purpose: Save the cache to the file it was
+	//	loaded from
+	//
+	// Returns TRUE on success
+	////////////////////////////////////////////////////
+	virtual bool Save(void) const = 0;
+
+	////////////////////////////////////////////////////
+	// Clear
+	//
+	// Purpose: Forget all cached blocks
+	////////////////////////////////////////////////////
+	virtual void Clear(void) = 0;
+
+	////////////////////////////////////////////////////
+	// Find
+	//
+	// Purpose: Get a cached calibration block
+	//
+	// In:	szDevice - Device path of the remote
+	//		nAddr - Address the block is read from
+	//		nSize - Size of the block
+	//
+	// Out:	pData - Cached block
+	//
+	// Returns TRUE if the block was cached
+	////////////////////////////////////////////////////
+	virtual bool Find(char const* szDevice, int nAddr, int nSize, LPWiiIOData pData) const = 0;
+
+	////////////////////////////////////////////////////
+	// Store
+	//
+	// Purpose: Cache a calibration block read from
+	//	the device
+	//
+	// In:	szDevice - Device path of the remote
+	//		nAddr - Address the block is read from
+	//		nSize - Size of the block
+	//		pData - Block read
+	//
+	// Returns TRUE if the block was not cached or has
+	//	changed, in which case the cache is saved
+	////////////////////////////////////////////////////
+	virtual bool Store(char const* szDevice, int nAddr, int nSize, LPWiiIOData pData) = 0;
+};
+
+#endif //_WR_ICALIBRATIONCACHE_H_
\ No newline at end of file
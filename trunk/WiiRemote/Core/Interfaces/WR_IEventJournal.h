@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_IEventJournal.h
+//
+// Purpose: Interface object
+//	Describes the journal of input events each remote
+//	publishes, readable from any thread
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_IEVENTJOURNAL_H_
+#define _WR_IEVENTJOURNAL_H_
+
+// Events kept by the journal before the oldest are overwritten
+//	(must be a power of 2)
+#define WR_JOURNAL_SIZE (1024)
+
+// WR_JOURNAL_EVENTS
+//	Types of journal events
+enum WR_JOURNAL_EVENTS
+{
+	WR_JOURNAL_BUTTON = 0,		// Button edges
+	WR_JOURNAL_MOTION,			// Motion sample
+	WR_JOURNAL_SENSOR,			// IR sensor sample
+	WR_JOURNAL_ANALOG,			// Analog stick sample
+	WR_JOURNAL_STATUS,			// Status update
+};
+
+// WR_JOURNAL_SOURCES
+//	Where a journal event came from
+enum WR_JOURNAL_SOURCES
+{
+	WR_JOURNAL_REMOTE = 0,		// The Wii Remote
+	WR_JOURNAL_EXTENSION,		// The plugged in extension
+};
+
+struct SJournalEvent
+{
+	unsigned int nSeq;			// Position in the journal
+	float fTime;				// When the report came in (precise time)
+	unsigned short nType;		// See WR_JOURNAL_EVENTS
+	unsigned short nSource;		// See WR_JOURNAL_SOURCES
+	union
+	{
+		struct { unsigned int nPushed, nReleased, nHeld; } button;
+		struct { float x, y, z, fPitch, fRoll; } motion;
+		struct { float fX, fY; int nDots; bool bValid; } sensor;
+		struct { int nStick; float fX, fY; } analog;
+		struct { int nFlags, nBattery; } status;
+	} data;
+};
+
+// Position of a reader in the journal
+struct SJournalCursor
+{
+	unsigned int nNext;			// Next event to read
+	unsigned int nLost;			// Events overwritten before they were read
+
+	SJournalCursor(void) : nNext(0), nLost(0) {}
+};
+
+////////////////////////////////////////////////////
+////////////////////////////////////////////////////
+
+struct IWR_EventJournal
+{
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~IWR_EventJournal(void) { }
+
+	////////////////////////////////////////////////////
+	// GetHead
+	//
+	// Purpose: Returns the position the next event will
+	//	be published at
+	////////////////////////////////////////////////////
+	virtual unsigned int GetHead(void) const = 0;
+
+	////////////////////////////////////////////////////
+	// SeekToHead
+	//
+	// Purpose: Move a cursor so it only reads events
+	//	published from now on
+	//
+	// In:	cursor - Cursor to move
+	////////////////////////////////////////////////////
+	virtual void SeekToHead(SJournalCursor &cursor) const = 0;
+
+	////////////////////////////////////////////////////
+	// SeekToOldest
+	//
+	// Purpose: Move a cursor to the oldest event still
+	//	kept
+	//
+	// In:	cursor - Cursor to move
+	////////////////////////////////////////////////////
+	virtual void SeekToOldest(SJournalCursor &cursor) const = 0;
+
+	////////////////////////////////////////////////////
+	// Read
+	//
+	// Purpose: Copy out the events after a cursor and
+	//	move it past them
+	//
+	// In:	cursor - Reader's own cursor
+	//		pEvents - Where to copy the events
+	//		nMax - Most events to copy
+	//
+	// Returns the number of events copied
+	//
+	// Note: Safe from any thread and never blocks the
+	//	remote. Readers that fall more than WR_JOURNAL_SIZE
+	//	behind skip ahead, adding what they missed to
+	//	cursor.nLost
+	////////////////////////////////////////////////////
+	virtual int Read(SJournalCursor &cursor, SJournalEvent *pEvents, int nMax) const = 0;
+};
+
+#endif //_WR_IEVENTJOURNAL_H_
\ No newline at end of file
@@ -42,6 +42,15 @@ typedef std::string RemoteFoundMap[MAX_REMOTES];
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
+// HID listener events, used to pick what a listener
+//	is subscribed to
+enum WR_HIDCONTROLLER_EVENTS
+{
+	WR_HIDEVENT_FOUNDDEVICE = 0x01,		// OnFoundRemoteDevice
+	WR_HIDEVENT_INITIALIZED = 0x02,		// OnRemoteInitialized
+	WR_HIDEVENT_DEFAULT = 0x03,			// All events
+};
+
 // HID Listener
 struct IWR_HIDControllerListener
 {
@@ -179,8 +188,11 @@ struct IWR_HIDController
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_HIDCONTROLLER_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_HIDControllerListener *pListener) = 0;
+	virtual void AddListener(IWR_HIDControllerListener *pListener, unsigned int nEvents = WR_HIDEVENT_DEFAULT) = 0;
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -37,6 +37,8 @@ enum WR_WIIREMOTE_BUTTONS
 	WR_BUTTON_TWO = 0x0001,			// '2' or Two button
 
 	WR_BUTTON_HOME = 0x0080,		// Home button
+
+	WR_BUTTON_ALL = 0x1F9F,			// Every button
 };
 
 // WR_WIIREMOTE_BUTTONS_INDEX
@@ -96,9 +98,44 @@ struct SWR_WiiButton_Action
 };
 typedef std::map<ActionID, SWR_WiiButton_Action> ActionMap;
 
+// WR_WIIREMOTE_COMBOS
+//	Types of button combos
+enum WR_WIIREMOTE_COMBOS
+{
+	WR_COMBO_CHORD = 0,		// All buttons pushed within the window of each other
+	WR_COMBO_SEQUENCE,		// Steps pushed in order, each within the window of the last
+	WR_COMBO_TAP,			// Buttons tapped a number of times, each within the window of the last
+	WR_COMBO_HOLD,			// All buttons held down for the window
+};
+
+// Combos get IDs starting here, so they never clash with actions
+#define WR_COMBOID_FIRST (0x8000)
+#define WR_COMBO_MAXSTEPS (8)
+struct SWR_WiiButton_Combo
+{
+	int nType;
+	unsigned int nButtons[WR_COMBO_MAXSTEPS];	// Buttons of each step (only the first for chord, tap and hold)
+	int nCount;									// Steps of a sequence or taps of a tap
+	float fWindow;								// Time window in seconds
+
+	SWR_WiiButton_Combo(void) : nType(WR_COMBO_CHORD), nCount(1), fWindow(0.0f)
+	{
+		for (int i = 0; i < WR_COMBO_MAXSTEPS; i++) nButtons[i] = 0;
+	}
+};
+
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
+// Button listener events, used to pick what a listener
+//	is subscribed to
+enum WR_WIIBUTTONS_EVENTS
+{
+	WR_BUTTONEVENT_BUTTON = 0x01,		// OnButton
+	WR_BUTTONEVENT_ACTION = 0x02,		// OnAction
+	WR_BUTTONEVENT_DEFAULT = 0x03,		// All events
+};
+
 // Button Listener
 struct IWR_WiiRemote;
 struct IWR_WiiButtons;
@@ -155,8 +192,11 @@ struct IWR_WiiButtons
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIBUTTONS_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiButtonsListener *pListener) = 0;
+	virtual void AddListener(IWR_WiiButtonsListener *pListener, unsigned int nEvents = WR_BUTTONEVENT_DEFAULT) = 0;
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -224,6 +264,22 @@ struct IWR_WiiButtons
 	////////////////////////////////////////////////////
 	virtual int RegisterAction(char const* szName, unsigned int nButtonMask) = 0;
 
+	////////////////////////////////////////////////////
+	// RegisterCombo
+	//
+	// Purpose: Register a combo action
+	//
+	// In:	szName - Name of the combo
+	//		combo - Combo definition (see WR_WIIREMOTE_COMBOS)
+	//
+	// Returns ID of combo or 0 on error
+	//
+	// Note: Combos are pushed when they complete and released
+	//	when their last buttons are released, and are reported
+	//	and polled the same as actions
+	////////////////////////////////////////////////////
+	virtual int RegisterCombo(char const* szName, SWR_WiiButton_Combo const& combo) = 0;
+
 	////////////////////////////////////////////////////
 	// GetActionStatus
 	//
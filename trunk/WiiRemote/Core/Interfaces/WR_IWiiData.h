@@ -49,6 +49,15 @@ typedef std::map<int, WiiIOCallBackList> WiiIOCallBackMap;
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
+// Data listener events, used to pick what a listener
+//	is subscribed to
+enum WR_WIIDATA_EVENTS
+{
+	WR_DATAEVENT_READ = 0x01,		// OnDataRead
+	WR_DATAEVENT_ERROR = 0x02,		// OnDataError
+	WR_DATAEVENT_DEFAULT = 0x03,		// All events
+};
+
 // Data Listener
 struct IWR_WiiDataListener
 {
@@ -95,8 +104,11 @@ struct IWR_WiiData
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIDATA_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiDataListener *pListener) = 0;
+	virtual void AddListener(IWR_WiiDataListener *pListener, unsigned int nEvents = WR_DATAEVENT_DEFAULT) = 0;
 
 	////////////////////////////////////////////////////
 	// RemoveListener
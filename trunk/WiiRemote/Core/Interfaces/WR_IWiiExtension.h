@@ -14,6 +14,8 @@
 #ifndef _WR_IWIIEXTENSION_H_
 #define _WR_IWIIEXTENSION_H_
 
+class CWR_InputRelay;
+
 // Extension IDs
 enum WR_WIIEXTENSION_ID
 {
@@ -43,6 +45,22 @@ enum WR_WIIEXTENSION_UPDATE
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
+// Extension listener events, used to pick what a listener
+//	is subscribed to
+enum WR_WIIEXTENSION_EVENTS
+{
+	WR_EXTEVENT_BUTTON = 0x01,			// OnExtensionButton
+	WR_EXTEVENT_ACTION = 0x02,			// OnExtensionAction
+	WR_EXTEVENT_SINGLEMOTION = 0x04,		// OnExtensionSingleMotion
+	WR_EXTEVENT_MOTIONSTART = 0x08,		// OnExtensionMotionStart
+	WR_EXTEVENT_MOTIONUPDATE = 0x10,		// OnExtensionMotionUpdate
+	WR_EXTEVENT_MOTIONEND = 0x20,		// OnExtensionMotionEnd
+	WR_EXTEVENT_MOTIONCANCEL = 0x40,		// OnExtensionMotionCancel
+	WR_EXTEVENT_ANALOGUPDATE = 0x80,		// OnExtensionAnalogUpdate
+	WR_EXTEVENT_MOTIONBATCH = 0x100,		// OnExtensionMotionBatch
+	WR_EXTEVENT_DEFAULT = 0xFF,			// All but the batched events
+};
+
 // Extension Listener
 struct IWR_WiiExtension;
 struct IWR_WiiExtensionListener
@@ -100,9 +118,13 @@ struct IWR_WiiExtensionListener
 	//
 	// In:	pRemote - Controller object
 	//		pExtension - Extension object
-	//		motion - Motion element
+	//		onset - Buffered onset window, starting with
+	//			the first element of the motion
+	//
+	// Note: No OnExtensionMotionUpdate is sent for the
+	//	elements in the onset window
 	////////////////////////////////////////////////////
-	virtual void OnExtensionMotionStart(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion) = 0;
+	virtual void OnExtensionMotionStart(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& onset) = 0;
 
 	////////////////////////////////////////////////////
 	// OnExtensionMotionUpdate
@@ -126,6 +148,22 @@ struct IWR_WiiExtensionListener
 	////////////////////////////////////////////////////
 	virtual void OnExtensionMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion) = 0;
 
+	////////////////////////////////////////////////////
+	// OnExtensionMotionCancel
+	//
+	// Purpose: Called when a motion that was started
+	//	speculatively failed its onset test
+	//
+	// In:	pRemote - Controller object
+	//		pExtension - Extension object
+	//		motion - Motion element
+	//
+	// Note: Anything done since OnExtensionMotionStart
+	//	should be rolled back. No OnExtensionMotionEnd
+	//	follows.
+	////////////////////////////////////////////////////
+	virtual void OnExtensionMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion) = 0;
+
 	////////////////////////////////////////////////////
 	// OnExtensionAnalogUpdate
 	//
@@ -138,6 +176,21 @@ struct IWR_WiiExtensionListener
 	//		fY - Analog stick's Y position
 	////////////////////////////////////////////////////
 	virtual void OnExtensionAnalogUpdate(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, int nStickID, float fX, float fY) = 0;
+
+	////////////////////////////////////////////////////
+	// OnExtensionMotionBatch
+	//
+	// Purpose: Called once per update with every element
+	//	the extension reported during it
+	//
+	// In:	pRemote - Controller object
+	//		pExtension - Extension object
+	//		motions - Elements, oldest first
+	//
+	// Note: Only sent to listeners subscribed to
+	//	WR_EXTEVENT_MOTIONBATCH
+	////////////////////////////////////////////////////
+	virtual void OnExtensionMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& motions) = 0;
 };
 
 ////////////////////////////////////////////////////
@@ -156,8 +209,11 @@ struct IWR_WiiExtension
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIEXTENSION_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiExtensionListener *pListener) = 0;
+	virtual void AddListener(IWR_WiiExtensionListener *pListener, unsigned int nEvents = WR_EXTEVENT_DEFAULT) = 0;
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -221,6 +277,16 @@ struct IWR_WiiExtension
 	// Note: Should be called at end of Update
 	////////////////////////////////////////////////////
 	virtual void OnPostUpdate(void) = 0;
+
+	////////////////////////////////////////////////////
+	// SetRelay
+	//
+	// Purpose: Hand listener calls to a relay instead
+	//
+	// In:	pRelay - Relay to use, or NULL to call the
+	//			listeners directly
+	////////////////////////////////////////////////////
+	virtual void SetRelay(CWR_InputRelay *pRelay) = 0;
 };
 
 #endif //_WR_IWIIEXTENSION_H_
\ No newline at end of file
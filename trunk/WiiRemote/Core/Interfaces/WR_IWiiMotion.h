@@ -19,6 +19,20 @@
 #define WR_MOTION_1GEPSILON (0.2f)
 #define WR_MOTION_GESTUREEPSILON (0.1f)
 
+// Stillness detection
+//	A motion starts when the variance of the acceleration over
+//	the still window passes the noise level by the noise ratio
+//	(and is at least the gesture epsilon squared). It ends once
+//	the variance stays under the still ratio of that for the
+//	still count of updates in a row. The noise level is learned
+//	from still updates, up to the max noise.
+#define WR_MOTION_STILLWINDOW (6)
+#define WR_MOTION_NOISERATIO (9.0f)
+#define WR_MOTION_STILLRATIO (0.5f)
+#define WR_MOTION_STILLCOUNT (3)
+#define WR_MOTION_NOISEADAPT (0.05f)
+#define WR_MOTION_MAXNOISE (0.01f)
+
 // WR_WIIMOTION_LSBOFFSETS
 //	Offsets into buffer where LSB data is stored
 enum WR_WIIMOTION_LSBOFFSETS
@@ -95,12 +109,121 @@ struct SMotionElement
 	SMotionVec3F vAccel, vDir;
 };
 
+// Motion span
+//	Read-only view over a run of consecutive motion
+//	elements, oldest first
+struct SMotionSpan
+{
+	SMotionElement const* pElements;
+	int nCount;
+	SMotionSpan(void) : pElements(NULL),nCount(0) {}
+	SMotionSpan(SMotionElement const* _pElements, int _nCount) : pElements(_pElements),nCount(_nCount) {}
+
+	int Size(void) const { return nCount; }
+	bool IsEmpty(void) const { return (0 == nCount); }
+	SMotionElement const& Front(void) const { return pElements[0]; }
+	SMotionElement const& Back(void) const { return pElements[nCount-1]; }
+	SMotionElement const& operator [](int nIndex) const { return pElements[nIndex]; }
+};
+
+// Motion ring
+//	Fixed-capacity ring of motion elements stored inline
+//	so it never allocates. Each element is mirrored into
+//	the upper half so the newest N elements are always
+//	contiguous and can be handed out as a span. Once
+//	full, the oldest element is overwritten.
+template <int CAPACITY> struct SMOTIONRING
+{
+	SMotionElement m_Elements[CAPACITY*2];
+	int m_nNext;
+	int m_nCount;
+	SMOTIONRING(void) : m_nNext(0),m_nCount(0) {}
+
+	void Push(SMotionElement const& element)
+	{
+		m_Elements[m_nNext] = element;
+		m_Elements[m_nNext+CAPACITY] = element;
+		if (++m_nNext == CAPACITY) m_nNext = 0;
+		if (m_nCount < CAPACITY) ++m_nCount;
+	}
+	void Clear(void) { m_nNext = 0; m_nCount = 0; }
+	int Size(void) const { return m_nCount; }
+	int Capacity(void) const { return CAPACITY; }
+	bool IsEmpty(void) const { return (0 == m_nCount); }
+	bool IsFull(void) const { return (CAPACITY == m_nCount); }
+
+	// Span over the newest nCount elements (all by default)
+	SMotionSpan GetSpan(int nCount = CAPACITY) const
+	{
+		if (nCount > m_nCount) nCount = m_nCount;
+		return SMotionSpan(&m_Elements[m_nNext+CAPACITY-nCount], nCount);
+	}
+};
+
+// Largest onset window (in consecutive updates) a motion
+//	helper can buffer before reporting the motion start
+#define WR_MOTION_MAXONSETSIZE (32)
+
 // Motion queue
-typedef std::queue<SMotionElement> WiiMotionQueue;
+typedef SMOTIONRING<WR_MOTION_MAXONSETSIZE> WiiMotionQueue;
+
+// Most elements handed to a batch listener at once, a
+//	batch is sent early if an update has more than this
+#define WR_MOTION_MAXBATCHSIZE (32)
+
+// Speculative onset test defaults
+//	Window is in consecutive updates, energy is the mean
+//	squared change in acceleration (G) per update
+#define WR_MOTION_ONSETWINDOW (4)
+#define WR_MOTION_ONSETENERGY (0.04f)
+
+// Motion history
+//	Updates kept for windowed statistics, and the default
+//	sliding window (in consecutive updates)
+#define WR_MOTION_HISTORYSIZE (64)
+#define WR_MOTION_STATSWINDOW (8)
+
+// Nominal time between motion reports (100Hz), used for
+//	the first update of the history
+#define WR_MOTION_REPORTPERIOD (0.01f)
+
+// Least time between updates in the history, so reports
+//	received at the same time still have a duration
+#define WR_MOTION_MINPERIOD (0.0001f)
+
+// Motion statistics
+//	Summary of the updates in a window. Acceleration is in
+//	G, velocity is integrated from acceleration with gravity
+//	removed and jerk is the mean change in acceleration per
+//	second over the window. Pitch and roll means are circular,
+//	so they are right across the +/-PI wrap
+struct SMotionStats
+{
+	int nCount;
+	float fDuration;
+	SMotionVec3F vMean, vVariance, vMin, vMax;
+	float fGForceMean, fGForceMax;
+	float fPitchMean, fRollMean;
+	SMotionVec3F vVelocity, vJerk;
+	SMotionStats(void) : nCount(0),fDuration(0.0f),fGForceMean(0.0f),fGForceMax(0.0f),fPitchMean(0.0f),fRollMean(0.0f) {}
+};
 
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
+// Motion listener events, used to pick what a listener
+//	is subscribed to
+enum WR_WIIMOTION_EVENTS
+{
+	WR_MOTIONEVENT_SINGLE = 0x01,		// OnSingleMotion
+	WR_MOTIONEVENT_START = 0x02,		// OnMotionStart
+	WR_MOTIONEVENT_UPDATE = 0x04,		// OnMotionUpdate
+	WR_MOTIONEVENT_END = 0x08,			// OnMotionEnd
+	WR_MOTIONEVENT_CANCEL = 0x10,		// OnMotionCancel
+	WR_MOTIONEVENT_BATCH = 0x20,		// OnMotionBatch
+	WR_MOTIONEVENT_DEFAULT = 0x1F,		// All but the batched events
+};
+
 // Motion Listener
 struct IWR_WiiRemote;
 struct IWR_WiiMotion;
@@ -124,9 +247,13 @@ struct IWR_WiiMotionListener
 	//
 	// In:	pRemote - Controller object
 	//		pMotion - Motion helper
-	//		motion - Motion element
+	//		onset - Buffered onset window, starting with
+	//			the first element of the motion
+	//
+	// Note: No OnMotionUpdate is sent for the elements
+	//	in the onset window
 	////////////////////////////////////////////////////
-	virtual void OnMotionStart(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion) = 0;
+	virtual void OnMotionStart(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& onset) = 0;
 
 	////////////////////////////////////////////////////
 	// OnMotionUpdate
@@ -149,6 +276,36 @@ struct IWR_WiiMotionListener
 	//		motion - Motion element
 	////////////////////////////////////////////////////
 	virtual void OnMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion) = 0;
+
+	////////////////////////////////////////////////////
+	// OnMotionCancel
+	//
+	// Purpose: Called when a motion that was started
+	//	speculatively failed its onset test
+	//
+	// In:	pRemote - Controller object
+	//		pMotion - Motion helper
+	//		motion - Motion element
+	//
+	// Note: Anything done since OnMotionStart should be
+	//	rolled back. No OnMotionEnd follows.
+	////////////////////////////////////////////////////
+	virtual void OnMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion) = 0;
+
+	////////////////////////////////////////////////////
+	// OnMotionBatch
+	//
+	// Purpose: Called once per update with every element
+	//	the controller reported during it
+	//
+	// In:	pRemote - Controller object
+	//		pMotion - Motion helper
+	//		motions - Elements, oldest first
+	//
+	// Note: Only sent to listeners subscribed to
+	//	WR_MOTIONEVENT_BATCH
+	////////////////////////////////////////////////////
+	virtual void OnMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& motions) = 0;
 };
 
 ////////////////////////////////////////////////////
@@ -159,6 +316,9 @@ enum WR_WIIMOTION_FLAGS
 {
 	WMF_ISCALIBRATED = 0x01,		// Set if motion has been calibrated
 	WMF_ACTIVEMOTION = 0x02,		// Set if motion is active based on min size
+	WMF_SPECULATIVEONSET = 0x04,	// Set if motions start on the first update and are confirmed later
+	WMF_SPECULATIVE = 0x08,			// Set if the active motion has not passed its onset test yet
+	WMF_ONSETREJECTED = 0x10,		// Set if the onset test failed, buffered onset is used until still
 };
 
 struct IWR_WiiMotion
@@ -174,8 +334,11 @@ struct IWR_WiiMotion
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIMOTION_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiMotionListener *pListener) = 0;
+	virtual void AddListener(IWR_WiiMotionListener *pListener, unsigned int nEvents = WR_MOTIONEVENT_DEFAULT) = 0;
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -208,6 +371,8 @@ struct IWR_WiiMotion
 	//	for a motion to be reported
 	//
 	// In:	nSize - Size (in number of consecutive updates)
+	//
+	// Note: Size is clamped to [10, WR_MOTION_MAXONSETSIZE-1]
 	////////////////////////////////////////////////////
 	virtual void SetMotionSize(int nSize) = 0;
 
@@ -219,6 +384,37 @@ struct IWR_WiiMotion
 	////////////////////////////////////////////////////
 	virtual int GetMotionSize(void) const = 0;
 
+	////////////////////////////////////////////////////
+	// SetSpeculativeOnset
+	//
+	// Purpose: Start motions on the first moving update
+	//	instead of waiting for the minimum size. The onset
+	//	is confirmed once the mean energy over the test
+	//	window passes the threshold, otherwise the motion
+	//	is cancelled (see OnMotionCancel)
+	//
+	// In:	bEnable - TRUE to enable speculative onset
+	//		nWindow - Test window (in consecutive updates)
+	//		fEnergy - Minimum mean energy to confirm
+	////////////////////////////////////////////////////
+	virtual void SetSpeculativeOnset(bool bEnable, int nWindow = WR_MOTION_ONSETWINDOW, float fEnergy = WR_MOTION_ONSETENERGY) = 0;
+
+	////////////////////////////////////////////////////
+	// IsSpeculativeOnset
+	//
+	// Purpose: Returns TRUE if speculative onset is enabled
+	////////////////////////////////////////////////////
+	virtual bool IsSpeculativeOnset(void) const = 0;
+
+	////////////////////////////////////////////////////
+	// IsSpeculative
+	//
+	// Purpose: Returns TRUE while the active motion was
+	//	started speculatively and its onset test has not
+	//	confirmed it yet
+	////////////////////////////////////////////////////
+	virtual bool IsSpeculative(void) const = 0;
+
 	////////////////////////////////////////////////////
 	// IsMotionActive
 	//
@@ -234,6 +430,49 @@ struct IWR_WiiMotion
 	////////////////////////////////////////////////////
 	virtual int GetMotionLifetime(void) const = 0;
 
+	////////////////////////////////////////////////////
+	// SetStatsWindow
+	//
+	// Purpose: Set the size of the sliding window used
+	//	by GetWindowStats
+	//
+	// In:	nSize - Size (in number of consecutive updates)
+	//
+	// Note: Size is clamped to [2, WR_MOTION_HISTORYSIZE]
+	////////////////////////////////////////////////////
+	virtual void SetStatsWindow(int nSize) = 0;
+
+	////////////////////////////////////////////////////
+	// GetStatsWindow
+	//
+	// Purpose: Get the size of the sliding window used
+	//	by GetWindowStats
+	////////////////////////////////////////////////////
+	virtual int GetStatsWindow(void) const = 0;
+
+	////////////////////////////////////////////////////
+	// GetWindowStats
+	//
+	// Purpose: Get statistics over the newest updates
+	//
+	// Out:	stats - Statistics, including the last update
+	//
+	// Note: Constant time, kept up to date on each update
+	////////////////////////////////////////////////////
+	virtual void GetWindowStats(SMotionStats &stats) const = 0;
+
+	////////////////////////////////////////////////////
+	// GetMotionStats
+	//
+	// Purpose: Get statistics over the current motion
+	//
+	// Out:	stats - Statistics since the remote was last
+	//			still, including the last update
+	//
+	// Note: Constant time, kept up to date on each update
+	////////////////////////////////////////////////////
+	virtual void GetMotionStats(SMotionStats &stats) const = 0;
+
 	////////////////////////////////////////////////////
 	// GetAcceleration
 	//
@@ -19,6 +19,7 @@ struct IWR_WiiMotion;
 struct IWR_WiiData;
 struct IWR_WiiExtension;
 struct IWR_WiiSensor;
+struct IWR_EventJournal;
 
 // Remote ID
 typedef unsigned char RemoteID;
@@ -165,6 +166,20 @@ enum WR_WIIREMOTE_OUTPUT_OPS
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
+// Remote listener events, used to pick what a listener
+//	is subscribed to
+enum WR_WIIREMOTE_EVENTS
+{
+	WR_REMOTEEVENT_CONNECT = 0x01,				// OnConnect
+	WR_REMOTEEVENT_DISCONNECT = 0x02,				// OnDisconnect
+	WR_REMOTEEVENT_CONNECTING = 0x04,				// OnConnecting
+	WR_REMOTEEVENT_REPORTCHANGED = 0x08,			// OnReportChanged
+	WR_REMOTEEVENT_STATUSUPDATE = 0x10,			// OnStatusUpdate
+	WR_REMOTEEVENT_EXTENSIONPLUGGEDIN = 0x20,		// OnExtensionPluggedIn
+	WR_REMOTEEVENT_EXTENSIONUNPLUGGED = 0x40,		// OnExtensionUnplugged
+	WR_REMOTEEVENT_DEFAULT = 0x7F,				// All events
+};
+
 // Remote Listener
 struct IWR_WiiRemote;
 struct IWR_WiiRemoteListener
@@ -252,7 +267,8 @@ struct IWR_WiiRemoteListener
 struct DataBuffer
 {
 	unsigned char data[WR_MAX_PAYLOAD];
-	DataBuffer(void) { memset(&data, 0x00, WR_MAX_PAYLOAD); }
+	float fRecvTime; // When the read thread received it, 0 if never read
+	DataBuffer(void) { memset(&data, 0x00, WR_MAX_PAYLOAD); fRecvTime = 0.0f; }
 	unsigned char& operator [](int n) { return data[n]; }
 	unsigned char const& operator [](int n) const { return data[n]; }
 	operator LPVOID(void) { return data; }
@@ -262,6 +278,33 @@ struct DataBuffer
 };
 typedef std::queue<DataBuffer> DataQueue;
 
+// Input snapshot
+//	State of a remote and its extension as of the end
+//	of its last update, readable from any thread
+struct SInputSnapshot
+{
+	unsigned int nSeq;			// Updates published so far
+	float fTime;				// When the newest parsed report came in (precise time)
+	unsigned int nFlags;		// Status flags (see WR_WIIREMOTE_FLAGS)
+	unsigned int nBattery;		// Battery life
+
+	// Remote input
+	unsigned int nButtons;		// Buttons that are not up (see WR_WIIREMOTE_BUTTONS)
+	float fPitch, fRoll;		// Orientation
+	float fAccelX, fAccelY, fAccelZ;
+	int nMotionLifetime;		// Lifetime of the current motion, 0 if none
+	bool bOnScreen;				// TRUE if the cursor is on the screen
+	float fCursorX, fCursorY;	// Cursor position
+
+	// Extension input, only set if bExtension is TRUE
+	bool bExtension;			// TRUE if an extension is plugged in
+	int nExtensionType;			// See WR_WIIEXTENSION_ID
+	unsigned int nExtButtons;	// Buttons that are not up (see WR_NUNCHUK_BUTTONS)
+	float fExtPitch, fExtRoll;
+	float fAnalogX, fAnalogY;	// Analog stick
+	int nExtMotionLifetime;
+};
+
 // Wii remote interface
 struct IWR_WiiRemote
 {
@@ -370,14 +413,70 @@ public:
 	////////////////////////////////////////////////////
 	virtual IWR_WiiSensor* GetSensorHelper(void) const = 0;
 
+	////////////////////////////////////////////////////
+	// GetJournal
+	//
+	// Purpose: Return the journal of input events
+	//
+	// Note: See IWR_EventJournal
+	////////////////////////////////////////////////////
+	virtual IWR_EventJournal const* GetJournal(void) const = 0;
+
+	////////////////////////////////////////////////////
+	// GetSnapshot
+	//
+	// Purpose: Copy out the input state published at the
+	//	end of the last update
+	//
+	// Out:	snapshot - Input state
+	//
+	// Returns TRUE if an update has published one yet
+	//
+	// Note: Safe from any thread. Spins only while the
+	//	remote is in the middle of publishing
+	////////////////////////////////////////////////////
+	virtual bool GetSnapshot(SInputSnapshot &snapshot) const = 0;
+
+	////////////////////////////////////////////////////
+	// SetDeferredListeners
+	//
+	// Purpose: Hold on to listener calls made during
+	//	updates until DispatchDeferred is called
+	//
+	// In:	bDefer - TRUE to defer, FALSE to call listeners
+	//			directly again (pending calls are made first)
+	//
+	// Note: Used so the remote can be updated on another
+	//	thread than its listeners run on
+	////////////////////////////////////////////////////
+	virtual void SetDeferredListeners(bool bDefer) = 0;
+
+	////////////////////////////////////////////////////
+	// IsDeferredListeners
+	//
+	// Purpose: Returns TRUE if listener calls are deferred
+	////////////////////////////////////////////////////
+	virtual bool IsDeferredListeners(void) const = 0;
+
+	////////////////////////////////////////////////////
+	// DispatchDeferred
+	//
+	// Purpose: Make the listener calls deferred so far, in
+	//	the order they happened
+	////////////////////////////////////////////////////
+	virtual void DispatchDeferred(void) = 0;
+
 	////////////////////////////////////////////////////
 	// AddListener
 	//
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIREMOTE_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiRemoteListener *pListener) = 0;
+	virtual void AddListener(IWR_WiiRemoteListener *pListener, unsigned int nEvents = WR_REMOTEEVENT_DEFAULT) = 0;
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -543,6 +642,14 @@ public:
 	////////////////////////////////////////////////////
 	virtual RemoteID const& GetID(void) const = 0;
 
+	////////////////////////////////////////////////////
+	// GetDevicePath
+	//
+	// Purpose: Returns the device path the remote was
+	//	initialized with
+	////////////////////////////////////////////////////
+	virtual char const* GetDevicePath(void) const = 0;
+
 	////////////////////////////////////////////////////
 	// CheckFlags
 	//
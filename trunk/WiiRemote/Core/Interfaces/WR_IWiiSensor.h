@@ -20,8 +20,8 @@
 enum WR_WIISENSOR_MODE
 {
 	WR_SENSORMODE_POS = 0x01,		// Report only pos data (10 bytes)
-	WR_SENSORMODE_POSSIZE = 0x02,	// Report pos and size data (12 bytes, cannot be used with extension)
-	WR_SENSORMODE_ALL = 0x04,		// Report everything (16 bytes, cannot be used with motion or extension)
+	WR_SENSORMODE_POSSIZE = 0x03,	// Report pos and size data (12 bytes, cannot be used with extension)
+	WR_SENSORMODE_ALL = 0x05,		// Report everything (36 bytes over two reports, cannot be used with motion or extension)
 };
 
 // WR_WIISENSOR_REG
@@ -38,10 +38,56 @@ enum WR_WIISENSOR_REG
 #define WR_WIISENSOR_DZ (8.0f) // Deadzone value
 #define WR_WIISENSOR_MAX_X (1024.0f-WR_WIISENSOR_DZ)
 #define WR_WIISENSOR_MAX_Y (768.0f-WR_WIISENSOR_DZ)
+#define WR_WIISENSOR_NODOT (0x3FF) // Raw position of an untracked dot
+
+// Dot tracking
+#define WR_WIISENSOR_DOTS (4) // Dots the camera can report
+#define WR_WIISENSOR_TRACKDIST (96.0f) // Farthest a dot can move between reports and keep its identity (raw units)
+
+// Cursor filter defaults
+#define WR_WIISENSOR_FILTERMINCUTOFF (1.0f) // Cutoff frequency (Hz) while still
+#define WR_WIISENSOR_FILTERBETA (5.0f) // Cutoff increase (Hz) per screen per second of speed
+#define WR_WIISENSOR_FILTERSPEEDCUTOFF (1.0f) // Cutoff frequency (Hz) of the speed
+
+// Cursor prediction
+#define WR_WIISENSOR_HISTORY (8) // Cursor samples kept for prediction
+#define WR_WIISENSOR_PREDICTWINDOW (0.05f) // Newest samples (seconds) used to estimate cursor speed
+#define WR_WIISENSOR_MAXPREDICT (0.05f) // Farthest ahead (seconds) the cursor is predicted
+
+// Dots unpacked from a report, one array per field
+struct SSensorDots
+{
+	int nX[WR_WIISENSOR_DOTS];			// Raw position
+	int nY[WR_WIISENSOR_DOTS];
+	int nSize[WR_WIISENSOR_DOTS];		// Extended and full mode only
+	int nIntensity[WR_WIISENSOR_DOTS];	// Full mode only
+	int nFound;							// One bit per dot that was seen
+};
+
+// Sensor bar estimate, in raw camera units
+struct SSensorBar
+{
+	bool bValid;		// TRUE if the bar is in view
+	int nDots;			// How many dots are tracked
+	float fX;			// Midpoint of the bar
+	float fY;
+	float fSeparation;	// Distance between both ends of the bar
+	float fRoll;		// Angle of the bar (radians)
+};
 
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
+// Sensor listener events, used to pick what a listener
+//	is subscribed to
+enum WR_WIISENSOR_EVENTS
+{
+	WR_SENSOREVENT_ENTERSCREEN = 0x01,		// OnEnterScreen
+	WR_SENSOREVENT_LEAVESCREEN = 0x02,		// OnLeaveScreen
+	WR_SENSOREVENT_CURSORUPDATE = 0x04,		// OnCursorUpdate
+	WR_SENSOREVENT_DEFAULT = 0x07,			// All events
+};
+
 // Sensor Listener
 struct IWR_WiiRemote;
 struct IWR_WiiSensor;
@@ -103,8 +149,11 @@ struct IWR_WiiSensor
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIISENSOR_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiSensorListener *pListener) = 0;
+	virtual void AddListener(IWR_WiiSensorListener *pListener, unsigned int nEvents = WR_SENSOREVENT_DEFAULT) = 0;
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -122,6 +171,81 @@ struct IWR_WiiSensor
 	////////////////////////////////////////////////////
 	virtual bool IsEnabled(void) const = 0;
 
+	////////////////////////////////////////////////////
+	// GetSensorBar
+	//
+	// Purpose: Get the current sensor bar estimate
+	//
+	// Out:	bar - Sensor bar estimate
+	//
+	// Returns TRUE if the bar is in view
+	//
+	// Note: If one end of the bar drops out, the midpoint
+	//	is carried on from the end still in view
+	////////////////////////////////////////////////////
+	virtual bool GetSensorBar(SSensorBar &bar) const = 0;
+
+	////////////////////////////////////////////////////
+	// GetDot
+	//
+	// Purpose: Get a tracked dot
+	//
+	// In:	nDot - Dot identity (0 to WR_WIISENSOR_DOTS-1)
+	//
+	// Out:	nRawX - Raw X position
+	//		nRawY - Raw Y position
+	//
+	// Returns TRUE if the dot is tracked
+	//
+	// Note: A dot keeps its identity for as long as it
+	//	stays in view
+	////////////////////////////////////////////////////
+	virtual bool GetDot(int nDot, int &nRawX, int &nRawY) const = 0;
+
+	////////////////////////////////////////////////////
+	// SetCursorFilter
+	//
+	// Purpose: Set up the filter used to smooth the
+	//	cursor
+	//
+	// In:	bEnable - TRUE to filter the cursor
+	//		fMinCutoff - Cutoff frequency (Hz) while still,
+	//			lower is smoother
+	//		fBeta - How much the cutoff rises with speed,
+	//			higher has less lag
+	//
+	// Note: The filter runs once per report using the
+	//	time the report was received
+	////////////////////////////////////////////////////
+	virtual void SetCursorFilter(bool bEnable, float fMinCutoff = WR_WIISENSOR_FILTERMINCUTOFF, float fBeta = WR_WIISENSOR_FILTERBETA) = 0;
+
+	////////////////////////////////////////////////////
+	// IsCursorFilter
+	//
+	// Purpose: Returns TRUE if the cursor is filtered
+	////////////////////////////////////////////////////
+	virtual bool IsCursorFilter(void) const = 0;
+
+	////////////////////////////////////////////////////
+	// PredictCursor
+	//
+	// Purpose: Predict where the cursor will be at a
+	//	given time
+	//
+	// In:	fTime - Time to predict for, on the timer's
+	//			precise time (see GetPreciseTime)
+	//
+	// Out:	fX - Cursor X position
+	//		fY - Cursor Y position
+	//
+	// Returns TRUE if the cursor is on the screen
+	//
+	// Note: Extrapolates from the speed of the newest
+	//	samples, at most WR_WIISENSOR_MAXPREDICT ahead of
+	//	the newest one
+	////////////////////////////////////////////////////
+	virtual bool PredictCursor(float fTime, float &fX, float &fY) const = 0;
+
 protected:
 	////////////////////////////////////////////////////
 	// Initialize
@@ -0,0 +1,136 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CActionTable.cpp
+//
+// Purpose: Compiled table of input actions shared by
+//	the button helpers
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_CActionTable.h"
+
+////////////////////////////////////////////////////
+CWR_ActionTable::CWR_ActionTable(void)
+{
+	Clear();
+}
+
+////////////////////////////////////////////////////
+CWR_ActionTable::~CWR_ActionTable(void)
+{
+}
+
+////////////////////////////////////////////////////
+void CWR_ActionTable::Clear(void)
+{
+	m_Entries.clear();
+	m_Names.clear();
+	m_NameIndex.clear();
+	m_Changed.clear();
+	m_nUsedMask = 0;
+	m_bDirty = false;
+}
+
+////////////////////////////////////////////////////
+ActionID CWR_ActionTable::Register(char const* szName, unsigned int nButtonMask)
+{
+	if (NULL == szName) return ACTIONID_INVALID;
+
+	// Check to make sure there isn't already an action named this
+	NameIndex::iterator itName = m_NameIndex.find(szName);
+	if (m_NameIndex.end() != itName)
+	{
+		// Update its mask
+		m_Entries[itName->second-1].nButtonMask = nButtonMask;
+		m_nUsedMask |= nButtonMask;
+		m_bDirty = true;
+		return itName->second;
+	}
+	if (m_Entries.size() >= 0xFFFF) return ACTIONID_INVALID;
+
+	// Make a new entry
+	SEntry entry;
+	entry.nID = (ActionID)(m_Entries.size()+1);
+	entry.nButtonMask = nButtonMask;
+	entry.nLastStatus = WR_BUTTONSTATUS_UP;
+	m_Entries.push_back(entry);
+	m_Names.push_back(szName);
+	m_NameIndex[szName] = entry.nID;
+	m_Changed.reserve(m_Entries.size());
+	m_nUsedMask |= nButtonMask;
+
+	// Pick up buttons that are already held
+	m_bDirty = true;
+	return entry.nID;
+}
+
+////////////////////////////////////////////////////
+ActionID CWR_ActionTable::Find(char const* szName) const
+{
+	if (NULL == szName) return ACTIONID_INVALID;
+
+	NameIndex::const_iterator itName = m_NameIndex.find(szName);
+	return (m_NameIndex.end() == itName ? ACTIONID_INVALID : itName->second);
+}
+
+////////////////////////////////////////////////////
+unsigned int CWR_ActionTable::GetButtonMask(int nID) const
+{
+	if (nID <= ACTIONID_INVALID || nID > (int)m_Entries.size()) return 0;
+	return m_Entries[nID-1].nButtonMask;
+}
+
+////////////////////////////////////////////////////
+char const* CWR_ActionTable::GetName(int nID) const
+{
+	if (nID <= ACTIONID_INVALID || nID > (int)m_Names.size()) return NULL;
+	return m_Names[nID-1].c_str();
+}
+
+////////////////////////////////////////////////////
+int CWR_ActionTable::GetLastStatus(int nID) const
+{
+	if (nID <= ACTIONID_INVALID || nID > (int)m_Entries.size()) return WR_BUTTONSTATUS_UP;
+	return m_Entries[nID-1].nLastStatus;
+}
+
+////////////////////////////////////////////////////
+int CWR_ActionTable::Evaluate(CWR_ButtonBits const& buttons, unsigned int nChanged, float fError)
+{
+	m_Changed.clear();
+	if (true == m_bDirty) nChanged = ~0u;
+	m_bDirty = false;
+
+	// Buttons within the error time only need to be found once for all actions
+	const unsigned int nRecent = buttons.GetRecent(m_nUsedMask, fError);
+
+	for (Entries::iterator itEntry = m_Entries.begin(); itEntry != m_Entries.end(); ++itEntry)
+	{
+		// Up and down can only change with the buttons, pushed and released
+		//	can also settle as time goes by
+		if (0 == (itEntry->nButtonMask & nChanged) &&
+			WR_BUTTONSTATUS_PUSHED != itEntry->nLastStatus && WR_BUTTONSTATUS_RELEASED != itEntry->nLastStatus)
+			continue;
+
+		const int nStatus = buttons.GetMaskStatus(itEntry->nButtonMask, nRecent);
+		if (nStatus != itEntry->nLastStatus)
+		{
+			itEntry->nLastStatus = nStatus;
+			m_Changed.push_back(itEntry->nID);
+		}
+	}
+	return (int)m_Changed.size();
+}
+
+////////////////////////////////////////////////////
+ActionID CWR_ActionTable::GetChanged(int nIndex) const
+{
+	assert(nIndex >= 0 && nIndex < (int)m_Changed.size());
+	return m_Changed[nIndex];
+}
\ No newline at end of file
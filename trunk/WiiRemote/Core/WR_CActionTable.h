@@ -0,0 +1,155 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CActionTable.h
+//
+// Purpose: Compiled table of input actions shared by
+//	the button helpers
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CACTIONTABLE_H_
+#define _WR_CACTIONTABLE_H_
+
+#include "WR_CButtonBits.h"
+
+class CWR_ActionTable
+{
+protected:
+	// Action entry, stored at index ID-1
+	struct SEntry
+	{
+		unsigned int nButtonMask;
+		ActionID nID;
+		int nLastStatus;
+	};
+	typedef std::vector<SEntry> Entries;
+	Entries m_Entries;
+
+	// Action names, by index, and the name lookup used
+	//	when registering
+	typedef std::vector<std::string> Names;
+	Names m_Names;
+	typedef std::map<std::string, ActionID> NameIndex;
+	NameIndex m_NameIndex;
+
+	// Buttons used by any action
+	unsigned int m_nUsedMask;
+
+	// Actions whose status changed in the last evaluation
+	typedef std::vector<ActionID> Changed;
+	Changed m_Changed;
+
+	// TRUE if all actions must be evaluated next time
+	bool m_bDirty;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_ActionTable(void);
+private:
+	CWR_ActionTable(CWR_ActionTable const&) {}
+	CWR_ActionTable& operator =(CWR_ActionTable const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWR_ActionTable(void);
+
+	////////////////////////////////////////////////////
+	// Clear
+	//
+	// Purpose: Remove all actions
+	////////////////////////////////////////////////////
+	virtual void Clear(void);
+
+	////////////////////////////////////////////////////
+	// Register
+	//
+	// Purpose: Register an action or update the buttons
+	//	of an existing one
+	//
+	// In:	szName - Name of the action
+	//		nButtonMask - Buttons that make up the action
+	//
+	// Returns ID of action or ACTIONID_INVALID on error
+	////////////////////////////////////////////////////
+	virtual ActionID Register(char const* szName, unsigned int nButtonMask);
+
+	////////////////////////////////////////////////////
+	// Find
+	//
+	// Purpose: Look up an action by name
+	//
+	// In:	szName - Name of the action
+	//
+	// Returns ID of action or ACTIONID_INVALID if not found
+	////////////////////////////////////////////////////
+	virtual ActionID Find(char const* szName) const;
+
+	////////////////////////////////////////////////////
+	// GetButtonMask
+	//
+	// Purpose: Returns the buttons that make up an action,
+	//	or 0 if the action does not exist
+	//
+	// In:	nID - ID of the action
+	////////////////////////////////////////////////////
+	virtual unsigned int GetButtonMask(int nID) const;
+
+	////////////////////////////////////////////////////
+	// GetName
+	//
+	// Purpose: Returns the name of an action, or NULL
+	//	if the action does not exist
+	//
+	// In:	nID - ID of the action
+	////////////////////////////////////////////////////
+	virtual char const* GetName(int nID) const;
+
+	////////////////////////////////////////////////////
+	// GetLastStatus
+	//
+	// Purpose: Returns the status of an action as of the
+	//	last evaluation
+	//
+	// In:	nID - ID of the action
+	////////////////////////////////////////////////////
+	virtual int GetLastStatus(int nID) const;
+
+	////////////////////////////////////////////////////
+	// Evaluate
+	//
+	// Purpose: Update the status of the actions from the
+	//	button bitsets
+	//
+	// In:	buttons - Button state
+	//		nChanged - Buttons whose status changed since
+	//			the last evaluation
+	//		fError - Error time for buffered checking
+	//
+	// Returns the number of actions whose status changed
+	//
+	// Note: Only actions using a changed button, or that
+	//	are pushed or released, are looked at
+	////////////////////////////////////////////////////
+	virtual int Evaluate(CWR_ButtonBits const& buttons, unsigned int nChanged, float fError);
+
+	////////////////////////////////////////////////////
+	// GetChanged
+	//
+	// Purpose: Returns the ID of an action whose status
+	//	changed in the last evaluation
+	//
+	// In:	nIndex - Index, up to the count returned by
+	//			Evaluate
+	////////////////////////////////////////////////////
+	virtual ActionID GetChanged(int nIndex) const;
+};
+
+#endif //_WR_CACTIONTABLE_H_
\ No newline at end of file
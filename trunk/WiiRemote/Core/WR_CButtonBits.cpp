@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CButtonBits.cpp
+//
+// Purpose: Button state shared by the button helpers,
+//	kept as bitsets of button masks
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_CButtonBits.h"
+
+////////////////////////////////////////////////////
+CWR_ButtonBits::CWR_ButtonBits(void)
+{
+	m_pOrder = NULL;
+	m_nOrderCount = 0;
+	Reset();
+}
+
+////////////////////////////////////////////////////
+CWR_ButtonBits::~CWR_ButtonBits(void)
+{
+
+}
+
+////////////////////////////////////////////////////
+void CWR_ButtonBits::Reset(void)
+{
+	m_nHeld = 0;
+	m_nPushed = 0;
+	m_nReleased = 0;
+	memset(m_fBufferedTime, 0, sizeof(m_fBufferedTime));
+}
+
+////////////////////////////////////////////////////
+void CWR_ButtonBits::SetOrder(unsigned int const* pOrder, int nCount)
+{
+	m_pOrder = pOrder;
+	m_nOrderCount = (NULL == pOrder ? 0 : nCount);
+}
+
+////////////////////////////////////////////////////
+unsigned int CWR_ButtonBits::Update(unsigned int nDown, bool bBuffered, float fCurrTick)
+{
+	const unsigned int nBuffered = (true == bBuffered ? ~0u : 0u);
+	const unsigned int nWasUp = ~(m_nHeld|m_nReleased);
+	const unsigned int nWasDown = m_nHeld & ~m_nPushed;
+
+	// Up goes to pushed on buffered, released goes back to pushed
+	const unsigned int nPushed = nDown & ((nWasUp & nBuffered) | m_nReleased);
+
+	// Pushed goes to released, down goes to released on buffered
+	const unsigned int nReleased = ~nDown & (m_nPushed | (nWasDown & nBuffered));
+
+	const unsigned int nChanged = (m_nHeld^nDown) | (m_nPushed^nPushed) | (m_nReleased^nReleased);
+
+	// Remember when buffered buttons went down or up
+	for (unsigned int nBits = nBuffered & ((nWasUp & nDown) | (nWasDown & ~nDown)); 0 != nBits; nBits &= nBits-1)
+		m_fBufferedTime[GetBitIndex(nBits & (~nBits+1))] = fCurrTick;
+
+	m_nHeld = nDown;
+	m_nPushed = nPushed;
+	m_nReleased = nReleased;
+	return nChanged;
+}
+
+////////////////////////////////////////////////////
+unsigned int CWR_ButtonBits::Settle(void)
+{
+	const unsigned int nChanged = m_nPushed | m_nReleased;
+	m_nPushed = 0;
+	m_nReleased = 0;
+	return nChanged;
+}
+
+////////////////////////////////////////////////////
+int CWR_ButtonBits::GetStatus(unsigned int nButtonMask, float fError) const
+{
+	return GetMaskStatus(nButtonMask, GetRecent(nButtonMask, fError));
+}
+
+////////////////////////////////////////////////////
+int CWR_ButtonBits::GetMaskStatus(unsigned int nButtonMask, unsigned int nRecent) const
+{
+	// A single button is returned as is
+	if (0 == (nButtonMask & (nButtonMask-1))) nRecent = 0;
+
+	// Account for error: recently changed buttons that are down are
+	//	still being pushed, and ones that are up are still being released
+	const unsigned int nDown = m_nHeld & ~m_nPushed;
+	const unsigned int nUp = ~(m_nHeld|m_nReleased);
+	const unsigned int nPushed = (m_nPushed | (nDown & nRecent)) & nButtonMask;
+	const unsigned int nReleased = (m_nReleased | (nUp & nRecent)) & nButtonMask;
+
+	// Take status based on overall result, as if combining the buttons
+	//	in index order
+	// Rules:
+	//	1. If a button is up, all are up
+	//	2. Up and down status take presedence over pushed and releasing
+	//  3. If the first button is being released, all are releasing, otherwise
+	//		a button being released means all are up
+	if (0 == nButtonMask || 0 != (nButtonMask & nUp & ~nRecent))
+		return WR_BUTTONSTATUS_UP;
+	if (0 != nReleased)
+		return (0 != (nReleased & GetFirstButton(nButtonMask)) ? WR_BUTTONSTATUS_RELEASED : WR_BUTTONSTATUS_UP);
+	return (nPushed == nButtonMask ? WR_BUTTONSTATUS_PUSHED : WR_BUTTONSTATUS_DOWN);
+}
+
+////////////////////////////////////////////////////
+unsigned int CWR_ButtonBits::GetRecent(unsigned int nButtonMask, float fError) const
+{
+	if (fError <= 0.0f) return 0;
+
+	unsigned int nRecent = 0;
+	const float fCurrTick = g_pWR->pTimer->GetCurrTime();
+	for (unsigned int nBits = nButtonMask; 0 != nBits; nBits &= nBits-1)
+	{
+		const unsigned int nBit = nBits & (~nBits+1);
+		if (fCurrTick - m_fBufferedTime[GetBitIndex(nBit)] <= fError)
+			nRecent |= nBit;
+	}
+	return nRecent;
+}
+
+////////////////////////////////////////////////////
+unsigned int CWR_ButtonBits::GetHeld(void) const
+{
+	return m_nHeld;
+}
+
+////////////////////////////////////////////////////
+unsigned int CWR_ButtonBits::GetPushed(void) const
+{
+	return m_nPushed;
+}
+
+////////////////////////////////////////////////////
+unsigned int CWR_ButtonBits::GetReleased(void) const
+{
+	return m_nReleased;
+}
+
+////////////////////////////////////////////////////
+int CWR_ButtonBits::GetBitIndex(unsigned int nBit) const
+{
+	int nIndex = 0;
+	if (nBit & 0xFFFF0000) { nIndex += 16; nBit >>= 16; }
+	if (nBit & 0xFF00) { nIndex += 8; nBit >>= 8; }
+	if (nBit & 0xF0) { nIndex += 4; nBit >>= 4; }
+	if (nBit & 0xC) { nIndex += 2; nBit >>= 2; }
+	if (nBit & 0x2) { nIndex += 1; }
+	return nIndex;
+}
+
+////////////////////////////////////////////////////
+unsigned int CWR_ButtonBits::GetFirstButton(unsigned int nButtonMask) const
+{
+	for (int nButton = 0; nButton < m_nOrderCount; ++nButton)
+	{
+		if (0 != (nButtonMask & m_pOrder[nButton]))
+			return (nButtonMask & m_pOrder[nButton]);
+	}
+	return (nButtonMask & (~nButtonMask+1));
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CButtonBits.h
+//
+// Purpose: Button state shared by the button helpers,
+//	kept as bitsets of button masks
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CBUTTONBITS_H_
+#define _WR_CBUTTONBITS_H_
+
+// Most buttons a helper can have (one per bit)
+#define WR_BUTTONBITS_MAX (32)
+
+class CWR_ButtonBits
+{
+protected:
+	// Buttons in each state. Held buttons are either
+	//	pushed or down, so down is m_nHeld & ~m_nPushed
+	unsigned int m_nHeld;
+	unsigned int m_nPushed;
+	unsigned int m_nReleased;
+
+	// Time each button was last pushed or released (buffered)
+	float m_fBufferedTime[WR_BUTTONBITS_MAX];
+
+	// Order buttons are combined in (index value table)
+	unsigned int const* m_pOrder;
+	int m_nOrderCount;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_ButtonBits(void);
+private:
+	CWR_ButtonBits(CWR_ButtonBits const&) {}
+	CWR_ButtonBits& operator =(CWR_ButtonBits const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWR_ButtonBits(void);
+
+	////////////////////////////////////////////////////
+	// Reset
+	//
+	// Purpose: Put all buttons back up
+	////////////////////////////////////////////////////
+	virtual void Reset(void);
+
+	////////////////////////////////////////////////////
+	// SetOrder
+	//
+	// Purpose: Set the order buttons are combined in when
+	//	getting the status of more than one
+	//
+	// In:	pOrder - Index value table of the helper
+	//		nCount - Number of entries in the table
+	//
+	// Note: Without a table, buttons are combined from the
+	//	lowest bit up
+	////////////////////////////////////////////////////
+	virtual void SetOrder(unsigned int const* pOrder, int nCount);
+
+	////////////////////////////////////////////////////
+	// Update
+	//
+	// Purpose: Feed the buttons held down in a report
+	//
+	// In:	nDown - Buttons that are down
+	//		bBuffered - TRUE if buffered input is on
+	//		fCurrTick - Current tick time
+	//
+	// Returns the buttons whose status changed
+	////////////////////////////////////////////////////
+	virtual unsigned int Update(unsigned int nDown, bool bBuffered, float fCurrTick);
+
+	////////////////////////////////////////////////////
+	// Settle
+	//
+	// Purpose: Move pushed buttons to down and released
+	//	buttons to up
+	//
+	// Returns the buttons whose status changed
+	//
+	// Note: Used when no report came in, to prevent
+	//	spamming due to lack of comm from the remote
+	////////////////////////////////////////////////////
+	virtual unsigned int Settle(void);
+
+	////////////////////////////////////////////////////
+	// GetStatus
+	//
+	// Purpose: Get the status of buttons
+	//
+	// In:	nButtonMask - Buttons to check
+	//		fError - Error time for buffered checking
+	//
+	// Returns the status of the buttons (see WR_WIIREMOTE_BUTTONSTATUS)
+	////////////////////////////////////////////////////
+	virtual int GetStatus(unsigned int nButtonMask, float fError = 0.0f) const;
+
+	////////////////////////////////////////////////////
+	// GetMaskStatus
+	//
+	// Purpose: Get the status of buttons from the bitsets
+	//
+	// In:	nButtonMask - Buttons to check
+	//		nRecent - Buttons pushed or released within the
+	//			error time (see GetRecent)
+	//
+	// Returns the status of the buttons (see WR_WIIREMOTE_BUTTONSTATUS)
+	////////////////////////////////////////////////////
+	virtual int GetMaskStatus(unsigned int nButtonMask, unsigned int nRecent) const;
+
+	////////////////////////////////////////////////////
+	// GetRecent
+	//
+	// Purpose: Get the buttons whose buffered time is
+	//	within the error time
+	//
+	// In:	nButtonMask - Buttons to check
+	//		fError - Error time for buffered checking
+	////////////////////////////////////////////////////
+	virtual unsigned int GetRecent(unsigned int nButtonMask, float fError) const;
+
+	////////////////////////////////////////////////////
+	// GetHeld/GetPushed/GetReleased
+	//
+	// Purpose: Get the buttons in each state
+	////////////////////////////////////////////////////
+	virtual unsigned int GetHeld(void) const;
+	virtual unsigned int GetPushed(void) const;
+	virtual unsigned int GetReleased(void) const;
+
+protected:
+	////////////////////////////////////////////////////
+	// GetBitIndex
+	//
+	// Purpose: Returns the index of a single bit mask
+	////////////////////////////////////////////////////
+	virtual int GetBitIndex(unsigned int nBit) const;
+
+	////////////////////////////////////////////////////
+	// GetFirstButton
+	//
+	// Purpose: Returns the first button of a mask in the
+	//	combine order
+	////////////////////////////////////////////////////
+	virtual unsigned int GetFirstButton(unsigned int nButtonMask) const;
+};
+
+#endif //_WR_CBUTTONBITS_H_
\ No newline at end of file
@@ -0,0 +1,131 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CCalibrationCache.cpp
+//
+// Purpose: Persistent store of calibration data
+//	read from each device
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_CCalibrationCache.h"
+
+// File format, one block per line:
+//	<address> <size> <bytes...> <device path>
+#define CALIBRATION_LINESIZE (1024)
+
+////////////////////////////////////////////////////
+CWR_CalibrationCache::CWR_CalibrationCache(void)
+{
+
+}
+
+////////////////////////////////////////////////////
+CWR_CalibrationCache::~CWR_CalibrationCache(void)
+{
+
+}
+
+////////////////////////////////////////////////////
+bool CWR_CalibrationCache::Load(char const* szFile)
+{
+	m_Blocks.clear();
+	m_szFile = (NULL == szFile ? "" : szFile);
+
+	FILE *pFile = NULL;
+	if (true == m_szFile.empty() || 0 != fopen_s(&pFile, m_szFile.c_str(), "rt") || NULL == pFile)
+		return false;
+
+	char szLine[CALIBRATION_LINESIZE];
+	while (NULL != fgets(szLine, CALIBRATION_LINESIZE, pFile))
+	{
+		SBlock block;
+		int nAddr = 0, nRead = 0;
+		if (2 != sscanf_s(szLine, "%x %d%n", &nAddr, &block.nSize, &nRead)) continue;
+		if (block.nSize <= 0 || block.nSize > WR_CALIBRATION_MAXSIZE) continue;
+
+		// Bytes
+		char const* szPos = szLine+nRead;
+		bool bValid = true;
+		for (int i = 0; i < block.nSize && true == bValid; i++)
+		{
+			unsigned int nByte = 0;
+			bValid = (1 == sscanf_s(szPos, " %2x%n", &nByte, &nRead));
+			block.data[i] = (WiiIOData)nByte;
+			szPos += nRead;
+		}
+		if (false == bValid) continue;
+
+		// Device path is the rest of the line
+		while (' ' == *szPos) szPos++;
+		std::string szDevice(szPos);
+		while (false == szDevice.empty() && ('\n' == szDevice[szDevice.size()-1] || '\r' == szDevice[szDevice.size()-1]))
+			szDevice.erase(szDevice.size()-1);
+		if (true == szDevice.empty()) continue;
+
+		m_Blocks[BlockKey(szDevice, nAddr)] = block;
+	}
+
+	fclose(pFile);
+	return true;
+}
+
+////////////////////////////////////////////////////
+bool CWR_CalibrationCache::Save(void) const
+{
+	FILE *pFile = NULL;
+	if (true == m_szFile.empty() || 0 != fopen_s(&pFile, m_szFile.c_str(), "wt") || NULL == pFile)
+		return false;
+
+	for (BlockMap::const_iterator itI = m_Blocks.begin(); itI != m_Blocks.end(); itI++)
+	{
+		fprintf(pFile, "%08X %d", itI->first.second, itI->second.nSize);
+		for (int i = 0; i < itI->second.nSize; i++)
+			fprintf(pFile, " %02X", (unsigned int)itI->second.data[i]);
+		fprintf(pFile, " %s\n", itI->first.first.c_str());
+	}
+
+	fclose(pFile);
+	return true;
+}
+
+////////////////////////////////////////////////////
+void CWR_CalibrationCache::Clear(void)
+{
+	m_Blocks.clear();
+}
+
+////////////////////////////////////////////////////
+bool CWR_CalibrationCache::Find(char const* szDevice, int nAddr, int nSize, LPWiiIOData pData) const
+{
+	if (NULL == szDevice || NULL == pData) return false;
+
+	BlockMap::const_iterator itBlock = m_Blocks.find(BlockKey(szDevice, nAddr));
+	if (m_Blocks.end() == itBlock || nSize != itBlock->second.nSize) return false;
+
+	memcpy(pData, itBlock->second.data, nSize);
+	return true;
+}
+
+////////////////////////////////////////////////////
+bool CWR_CalibrationCache::Store(char const* szDevice, int nAddr, int nSize, LPWiiIOData pData)
+{
+	if (NULL == szDevice || NULL == pData || nSize <= 0 || nSize > WR_CALIBRATION_MAXSIZE) return false;
+
+	// Same as what we have?
+	BlockKey key(szDevice, nAddr);
+	BlockMap::const_iterator itBlock = m_Blocks.find(key);
+	if (m_Blocks.end() != itBlock && nSize == itBlock->second.nSize && 0 == memcmp(itBlock->second.data, pData, nSize))
+		return false;
+
+	SBlock &block = m_Blocks[key];
+	block.nSize = nSize;
+	memcpy(block.data, pData, nSize);
+	Save();
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CCalibrationCache.h
+//
+// Purpose: Persistent store of calibration data
+//	read from each device
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CCALIBRATIONCACHE_H_
+#define _WR_CCALIBRATIONCACHE_H_
+
+#include "Interfaces\WR_ICalibrationCache.h"
+
+class CWR_CalibrationCache : public IWR_CalibrationCache
+{
+protected:
+	// Cached blocks, by device path and address
+	struct SBlock
+	{
+		int nSize;
+		WiiIOData data[WR_CALIBRATION_MAXSIZE];
+	};
+	typedef std::pair<std::string, int> BlockKey;
+	typedef std::map<BlockKey, SBlock> BlockMap;
+	BlockMap m_Blocks;
+
+	// File the cache is kept in
+	std::string m_szFile;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_CalibrationCache(void);
+private:
+	CWR_CalibrationCache(CWR_CalibrationCache const&) {}
+	CWR_CalibrationCache& operator =(CWR_CalibrationCache const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWR_CalibrationCache(void);
+
+	////////////////////////////////////////////////////
+	// Load
+	//
+	// Purpose: Load the cache from file
+	//
+	// In:	szFile - File to load from and save to
+	//
+	// Returns TRUE if the file was read
+	//
+	// Note: The file is remembered even if it does
+	//	not exist yet, so later changes are saved to it
+	////////////////////////////////////////////////////
+	virtual bool Load(char const* szFile);
+
+	////////////////////////////////////////////////////
+	// Save
+	//
+	// Purpose: Save the cache to the file it was
+	//	loaded from
+	//
+	// Returns TRUE on success
+	////////////////////////////////////////////////////
+	virtual bool Save(void) const;
+
+	////////////////////////////////////////////////////
+	// Clear
+	//
+	// Purpose: Forget all cached blocks
+	////////////////////////////////////////////////////
+	virtual void Clear(void);
+
+	////////////////////////////////////////////////////
+	// Find
+	//
+	// Purpose: Get a cached calibration block
+	//
+	// In:	szDevice - Device path of the remote
+	//		nAddr - Address the block is read from
+	//		nSize - Size of the block
+	//
+	// Out:	pData - Cached block
+	//
+	// Returns TRUE if the block was cached
+	////////////////////////////////////////////////////
+	virtual bool Find(char const* szDevice, int nAddr, int nSize, LPWiiIOData pData) const;
+
+	////////////////////////////////////////////////////
+	// Store
+	//
+	// Purpose: Cache a calibration block read from
+	//	the device
+	//
+	// In:	szDevice - Device path of the remote
+	//		nAddr - Address the block is read from
+	//		nSize - Size of the block
+	//		pData - Block read
+	//
+	// Returns TRUE if the block was not cached or has
+	//	changed, in which case the cache is saved
+	////////////////////////////////////////////////////
+	virtual bool Store(char const* szDevice, int nAddr, int nSize, LPWiiIOData pData);
+};
+
+#endif //_WR_CCALIBRATIONCACHE_H_
\ No newline at end of file
@@ -0,0 +1,293 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CComboEngine.cpp
+//
+// Purpose: Detects chords, sequences, taps and holds
+//	from timestamped button edges
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_CComboEngine.h"
+
+////////////////////////////////////////////////////
+CWR_ComboEngine::CWR_ComboEngine(void)
+{
+	Clear();
+}
+
+////////////////////////////////////////////////////
+CWR_ComboEngine::~CWR_ComboEngine(void)
+{
+}
+
+////////////////////////////////////////////////////
+void CWR_ComboEngine::Clear(void)
+{
+	m_Combos.clear();
+	m_Names.clear();
+	m_NameIndex.clear();
+	m_Events.clear();
+	m_nUsedMask = 0;
+	m_nHeld = 0;
+	m_nTransient = 0;
+	m_nArmed = 0;
+}
+
+////////////////////////////////////////////////////
+void CWR_ComboEngine::Reset(void)
+{
+	for (Combos::iterator itCombo = m_Combos.begin(); itCombo != m_Combos.end(); ++itCombo)
+	{
+		itCombo->nSeen = 0;
+		itCombo->nStep = 0;
+		itCombo->fLast = 0.0f;
+		itCombo->bArmed = false;
+		itCombo->bFresh = false;
+		itCombo->nStatus = WR_BUTTONSTATUS_UP;
+	}
+	m_Events.clear();
+	m_nHeld = 0;
+	m_nTransient = 0;
+	m_nArmed = 0;
+}
+
+////////////////////////////////////////////////////
+ActionID CWR_ComboEngine::Register(char const* szName, SWR_WiiButton_Combo const& combo)
+{
+	if (NULL == szName || 0 == combo.nButtons[0]) return ACTIONID_INVALID;
+
+	// Taps are a sequence of the same buttons
+	SCombo entry;
+	entry.def = combo;
+	if (WR_COMBO_TAP == combo.nType)
+	{
+		entry.def.nType = WR_COMBO_SEQUENCE;
+		for (int i = 1; i < WR_COMBO_MAXSTEPS; i++)
+			entry.def.nButtons[i] = combo.nButtons[0];
+	}
+	if (WR_COMBO_SEQUENCE == entry.def.nType)
+		entry.def.nCount = CLAMP(combo.nCount, 1, WR_COMBO_MAXSTEPS);
+	else
+		entry.def.nCount = 1;
+
+	entry.nUsedMask = 0;
+	for (int i = 0; i < entry.def.nCount; i++)
+	{
+		if (0 == entry.def.nButtons[i]) return ACTIONID_INVALID;
+		entry.nUsedMask |= entry.def.nButtons[i];
+	}
+	entry.nReleaseMask = entry.def.nButtons[entry.def.nCount-1];
+	entry.nSeen = 0;
+	entry.nStep = 0;
+	entry.fLast = 0.0f;
+	entry.bArmed = false;
+	entry.bFresh = false;
+	entry.nStatus = WR_BUTTONSTATUS_UP;
+
+	// Replace an existing combo named this
+	NameIndex::iterator itName = m_NameIndex.find(szName);
+	if (m_NameIndex.end() != itName)
+	{
+		SCombo &old = m_Combos[itName->second-WR_COMBOID_FIRST];
+		if (true == old.bArmed) m_nArmed--;
+		if (WR_BUTTONSTATUS_PUSHED == old.nStatus || WR_BUTTONSTATUS_RELEASED == old.nStatus) m_nTransient--;
+		old = entry;
+		m_nUsedMask |= entry.nUsedMask;
+		return itName->second;
+	}
+	if (m_Combos.size() >= 0xFFFF-WR_COMBOID_FIRST) return ACTIONID_INVALID;
+
+	// Make a new entry
+	const ActionID nID = (ActionID)(WR_COMBOID_FIRST+m_Combos.size());
+	m_Combos.push_back(entry);
+	m_Names.push_back(szName);
+	m_NameIndex[szName] = nID;
+	m_nUsedMask |= entry.nUsedMask;
+	return nID;
+}
+
+////////////////////////////////////////////////////
+ActionID CWR_ComboEngine::Find(char const* szName) const
+{
+	if (NULL == szName) return ACTIONID_INVALID;
+
+	NameIndex::const_iterator itName = m_NameIndex.find(szName);
+	return (m_NameIndex.end() == itName ? ACTIONID_INVALID : itName->second);
+}
+
+////////////////////////////////////////////////////
+bool CWR_ComboEngine::IsCombo(int nID) const
+{
+	return (nID >= WR_COMBOID_FIRST && nID < WR_COMBOID_FIRST+(int)m_Combos.size());
+}
+
+////////////////////////////////////////////////////
+char const* CWR_ComboEngine::GetName(int nID) const
+{
+	if (false == IsCombo(nID)) return NULL;
+	return m_Names[nID-WR_COMBOID_FIRST].c_str();
+}
+
+////////////////////////////////////////////////////
+int CWR_ComboEngine::GetStatus(int nID) const
+{
+	if (false == IsCombo(nID)) return WR_BUTTONSTATUS_UP;
+	return m_Combos[nID-WR_COMBOID_FIRST].nStatus;
+}
+
+////////////////////////////////////////////////////
+void CWR_ComboEngine::OnButtons(unsigned int nPushed, unsigned int nReleased, float fTime)
+{
+	m_nHeld = (m_nHeld|nPushed) & ~nReleased;
+	if (0 == ((nPushed|nReleased) & m_nUsedMask)) return;
+
+	// Only step the combos these buttons take part in
+	for (Combos::iterator itCombo = m_Combos.begin(); itCombo != m_Combos.end(); ++itCombo)
+	{
+		SCombo &combo = *itCombo;
+		const unsigned int nDown = nPushed & combo.nUsedMask;
+		const unsigned int nUp = nReleased & combo.nUsedMask;
+		if (0 == (nDown|nUp)) continue;
+
+		// Releasing its last buttons ends it
+		if (0 != (nUp & combo.nReleaseMask) && true == IsActive(combo))
+			SetStatus(combo, WR_BUTTONSTATUS_RELEASED);
+
+		switch (combo.def.nType)
+		{
+			case WR_COMBO_CHORD:
+			{
+				combo.nSeen &= ~nUp;
+				if (0 != nDown)
+				{
+					// Start over if the first push is too old
+					if (0 == combo.nSeen || fTime - combo.fLast > combo.def.fWindow)
+					{
+						combo.nSeen = 0;
+						combo.fLast = fTime;
+					}
+					combo.nSeen |= nDown;
+					if (combo.nSeen == combo.nUsedMask && false == IsActive(combo))
+						SetStatus(combo, WR_BUTTONSTATUS_PUSHED);
+				}
+			}
+			break;
+
+			case WR_COMBO_SEQUENCE:
+			{
+				// The window runs from the end of the last step
+				if (combo.nStep > 0 && 0 != (nUp & combo.def.nButtons[combo.nStep-1]))
+					combo.fLast = fTime;
+				if (0 != nDown)
+				{
+					if (combo.nStep > 0 && fTime - combo.fLast > combo.def.fWindow)
+						combo.nStep = 0;
+					if (0 != (nDown & combo.def.nButtons[combo.nStep]))
+						combo.nStep++;
+					else
+						combo.nStep = (0 != (nDown & combo.def.nButtons[0]) ? 1 : 0);
+					combo.fLast = fTime;
+
+					if (combo.nStep >= combo.def.nCount)
+					{
+						combo.nStep = 0;
+						if (false == IsActive(combo))
+							SetStatus(combo, WR_BUTTONSTATUS_PUSHED);
+					}
+				}
+			}
+			break;
+
+			case WR_COMBO_HOLD:
+			{
+				if (0 != nUp && true == combo.bArmed)
+				{
+					combo.bArmed = false;
+					m_nArmed--;
+				}
+				if (0 != nDown && false == combo.bArmed && false == IsActive(combo) &&
+					combo.nUsedMask == (m_nHeld & combo.nUsedMask))
+				{
+					combo.bArmed = true;
+					combo.fLast = fTime;
+					m_nArmed++;
+				}
+			}
+			break;
+		}
+	}
+}
+
+////////////////////////////////////////////////////
+int CWR_ComboEngine::Update(float fTime)
+{
+	// Complete holds
+	if (m_nArmed > 0)
+	{
+		for (Combos::iterator itCombo = m_Combos.begin(); itCombo != m_Combos.end(); ++itCombo)
+		{
+			if (true == itCombo->bArmed && fTime - itCombo->fLast >= itCombo->def.fWindow)
+			{
+				itCombo->bArmed = false;
+				m_nArmed--;
+				SetStatus(*itCombo, WR_BUTTONSTATUS_PUSHED);
+			}
+		}
+	}
+
+	// Settle combos that were reported last update
+	if (m_nTransient > 0)
+	{
+		for (Combos::iterator itCombo = m_Combos.begin(); itCombo != m_Combos.end(); ++itCombo)
+		{
+			if (true == itCombo->bFresh)
+				itCombo->bFresh = false;
+			else if (WR_BUTTONSTATUS_PUSHED == itCombo->nStatus)
+				SetStatus(*itCombo, WR_BUTTONSTATUS_DOWN);
+			else if (WR_BUTTONSTATUS_RELEASED == itCombo->nStatus)
+				SetStatus(*itCombo, WR_BUTTONSTATUS_UP);
+		}
+	}
+
+	return (int)m_Events.size();
+}
+
+////////////////////////////////////////////////////
+CWR_ComboEngine::SEvent const& CWR_ComboEngine::GetEvent(int nIndex) const
+{
+	assert(nIndex >= 0 && nIndex < (int)m_Events.size());
+	return m_Events[nIndex];
+}
+
+////////////////////////////////////////////////////
+void CWR_ComboEngine::ClearEvents(void)
+{
+	m_Events.clear();
+}
+
+////////////////////////////////////////////////////
+void CWR_ComboEngine::SetStatus(SCombo &combo, int nStatus)
+{
+	const bool bWasTransient = (WR_BUTTONSTATUS_PUSHED == combo.nStatus || WR_BUTTONSTATUS_RELEASED == combo.nStatus);
+	const bool bTransient = (WR_BUTTONSTATUS_PUSHED == nStatus || WR_BUTTONSTATUS_RELEASED == nStatus);
+	m_nTransient += (bTransient ? 1 : 0) - (bWasTransient ? 1 : 0);
+	combo.nStatus = nStatus;
+	combo.bFresh = bTransient;
+
+	SEvent event;
+	event.nID = (ActionID)(WR_COMBOID_FIRST + (&combo - &m_Combos[0]));
+	event.nStatus = nStatus;
+	m_Events.push_back(event);
+}
+
+////////////////////////////////////////////////////
+bool CWR_ComboEngine::IsActive(SCombo const& combo) const
+{
+	return (WR_BUTTONSTATUS_PUSHED == combo.nStatus || WR_BUTTONSTATUS_DOWN == combo.nStatus);
+}
\ No newline at end of file
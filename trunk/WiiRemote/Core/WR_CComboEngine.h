@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CComboEngine.h
+//
+// Purpose: Detects chords, sequences, taps and holds
+//	from timestamped button edges
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CCOMBOENGINE_H_
+#define _WR_CCOMBOENGINE_H_
+
+class CWR_ComboEngine
+{
+public:
+	// Status change of a combo
+	struct SEvent
+	{
+		ActionID nID;
+		int nStatus;
+	};
+
+protected:
+	// Combo state, stored at index ID-WR_COMBOID_FIRST
+	struct SCombo
+	{
+		SWR_WiiButton_Combo def;	// Taps are stored as a sequence
+		unsigned int nUsedMask;		// Buttons it looks at
+		unsigned int nReleaseMask;	// Buttons whose release ends it
+		unsigned int nSeen;			// Chord: buttons pushed in the window
+		int nStep;					// Sequence: steps matched so far
+		float fLast;				// Chord: first push, Sequence: last step edge, Hold: when held
+		bool bArmed;				// Hold: waiting on time
+		bool bFresh;				// Status set since the last update
+		int nStatus;
+	};
+	typedef std::vector<SCombo> Combos;
+	Combos m_Combos;
+
+	// Combo names, by index, and the name lookup
+	typedef std::vector<std::string> Names;
+	Names m_Names;
+	typedef std::map<std::string, ActionID> NameIndex;
+	NameIndex m_NameIndex;
+
+	// Buttons used by any combo and buttons held now
+	unsigned int m_nUsedMask;
+	unsigned int m_nHeld;
+
+	// Combos waiting to settle or waiting on time
+	int m_nTransient;
+	int m_nArmed;
+
+	// Status changes since the events were last cleared
+	typedef std::vector<SEvent> Events;
+	Events m_Events;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_ComboEngine(void);
+private:
+	CWR_ComboEngine(CWR_ComboEngine const&) {}
+	CWR_ComboEngine& operator =(CWR_ComboEngine const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWR_ComboEngine(void);
+
+	////////////////////////////////////////////////////
+	// Clear
+	//
+	// Purpose: Remove all combos
+	////////////////////////////////////////////////////
+	virtual void Clear(void);
+
+	////////////////////////////////////////////////////
+	// Reset
+	//
+	// Purpose: Put all combos back to the start, with
+	//	no buttons held
+	////////////////////////////////////////////////////
+	virtual void Reset(void);
+
+	////////////////////////////////////////////////////
+	// Register
+	//
+	// Purpose: Register a combo or replace the definition
+	//	of an existing one
+	//
+	// In:	szName - Name of the combo
+	//		combo - Combo definition
+	//
+	// Returns ID of combo or ACTIONID_INVALID on error
+	////////////////////////////////////////////////////
+	virtual ActionID Register(char const* szName, SWR_WiiButton_Combo const& combo);
+
+	////////////////////////////////////////////////////
+	// Find
+	//
+	// Purpose: Look up a combo by name
+	//
+	// In:	szName - Name of the combo
+	//
+	// Returns ID of combo or ACTIONID_INVALID if not found
+	////////////////////////////////////////////////////
+	virtual ActionID Find(char const* szName) const;
+
+	////////////////////////////////////////////////////
+	// IsCombo
+	//
+	// Purpose: Returns TRUE if the ID belongs to a combo
+	//
+	// In:	nID - ID to check
+	////////////////////////////////////////////////////
+	virtual bool IsCombo(int nID) const;
+
+	////////////////////////////////////////////////////
+	// GetName
+	//
+	// Purpose: Returns the name of a combo, or NULL if
+	//	the combo does not exist
+	//
+	// In:	nID - ID of the combo
+	////////////////////////////////////////////////////
+	virtual char const* GetName(int nID) const;
+
+	////////////////////////////////////////////////////
+	// GetStatus
+	//
+	// Purpose: Returns the status of a combo (see
+	//	WR_WIIREMOTE_BUTTONSTATUS)
+	//
+	// In:	nID - ID of the combo
+	////////////////////////////////////////////////////
+	virtual int GetStatus(int nID) const;
+
+	////////////////////////////////////////////////////
+	// OnButtons
+	//
+	// Purpose: Step the combos with button edges
+	//
+	// In:	nPushed - Buttons that went down
+	//		nReleased - Buttons that went up
+	//		fTime - When the edges happened
+	////////////////////////////////////////////////////
+	virtual void OnButtons(unsigned int nPushed, unsigned int nReleased, float fTime);
+
+	////////////////////////////////////////////////////
+	// Update
+	//
+	// Purpose: Settle pushed and released combos and
+	//	complete holds
+	//
+	// In:	fTime - Current time, on the same clock as
+	//			the edges
+	//
+	// Returns the number of events to report
+	////////////////////////////////////////////////////
+	virtual int Update(float fTime);
+
+	////////////////////////////////////////////////////
+	// GetEvent
+	//
+	// Purpose: Returns a status change, in the order
+	//	they happened
+	//
+	// In:	nIndex - Index, up to the count returned by
+	//			Update
+	////////////////////////////////////////////////////
+	virtual SEvent const& GetEvent(int nIndex) const;
+
+	////////////////////////////////////////////////////
+	// ClearEvents
+	//
+	// Purpose: Call once the events have been reported
+	////////////////////////////////////////////////////
+	virtual void ClearEvents(void);
+
+protected:
+	////////////////////////////////////////////////////
+	// SetStatus
+	//
+	// Purpose: Change the status of a combo and record
+	//	the event
+	////////////////////////////////////////////////////
+	virtual void SetStatus(SCombo &combo, int nStatus);
+
+	////////////////////////////////////////////////////
+	// IsActive
+	//
+	// Purpose: Returns TRUE if the combo is pushed or down
+	////////////////////////////////////////////////////
+	virtual bool IsActive(SCombo const& combo) const;
+};
+
+#endif //_WR_CCOMBOENGINE_H_
\ No newline at end of file
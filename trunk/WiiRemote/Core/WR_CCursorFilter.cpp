@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CCursorFilter.cpp
+//
+// Purpose: Adaptive low-pass filter used by the
+//	sensor helper to smooth the IR cursor
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_CCursorFilter.h"
+
+////////////////////////////////////////////////////
+CWR_CursorFilter::CWR_CursorFilter(void)
+{
+	SetParams(WR_WIISENSOR_FILTERMINCUTOFF, WR_WIISENSOR_FILTERBETA, WR_WIISENSOR_FILTERSPEEDCUTOFF);
+	Reset();
+}
+
+////////////////////////////////////////////////////
+CWR_CursorFilter::~CWR_CursorFilter(void)
+{
+
+}
+
+////////////////////////////////////////////////////
+void CWR_CursorFilter::SetParams(float fMinCutoff, float fBeta, float fSpeedCutoff)
+{
+	m_fMinCutoff = MAX(fMinCutoff, 0.01f);
+	m_fBeta = MAX(fBeta, 0.0f);
+	m_fSpeedCutoff = MAX(fSpeedCutoff, 0.01f);
+}
+
+////////////////////////////////////////////////////
+void CWR_CursorFilter::Reset(void)
+{
+	m_bHasPrev = false;
+	m_fPrevTime = 0.0f;
+	m_fX = 0.0f;
+	m_fY = 0.0f;
+	m_fSpeed = 0.0f;
+}
+
+////////////////////////////////////////////////////
+void CWR_CursorFilter::Filter(float &fX, float &fY, float fTime)
+{
+	// Nothing to filter against, take it as is
+	if (false == m_bHasPrev)
+	{
+		m_bHasPrev = true;
+		m_fPrevTime = fTime;
+		m_fX = fX;
+		m_fY = fY;
+		m_fSpeed = 0.0f;
+		return;
+	}
+
+	// Same sample time again, keep what we have
+	const float fDT = fTime - m_fPrevTime;
+	if (fDT <= 0.0f)
+	{
+		fX = m_fX;
+		fY = m_fY;
+		return;
+	}
+	m_fPrevTime = fTime;
+
+	// Smooth the speed, then let it open up the cutoff
+	const float fMoveX = fX - m_fX;
+	const float fMoveY = fY - m_fY;
+	const float fSpeed = sqrtf((fMoveX*fMoveX)+(fMoveY*fMoveY)) / fDT;
+	m_fSpeed += (fSpeed - m_fSpeed) * GetAlpha(m_fSpeedCutoff, fDT);
+
+	const float fAlpha = GetAlpha(m_fMinCutoff + m_fBeta*m_fSpeed, fDT);
+	m_fX += fMoveX * fAlpha;
+	m_fY += fMoveY * fAlpha;
+	fX = m_fX;
+	fY = m_fY;
+}
+
+////////////////////////////////////////////////////
+float CWR_CursorFilter::GetAlpha(float fCutoff, float fDT) const
+{
+	const float fTau = 1.0f / (2.0f*PI*fCutoff);
+	return 1.0f / (1.0f + fTau/fDT);
+}
\ No newline at end of file
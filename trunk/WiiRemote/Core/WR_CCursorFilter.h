@@ -0,0 +1,99 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CCursorFilter.h
+//
+// Purpose: Adaptive low-pass filter used by the
+//	sensor helper to smooth the IR cursor
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CCURSORFILTER_H_
+#define _WR_CCURSORFILTER_H_
+
+#include "Interfaces\WR_IWiiSensor.h"
+
+class CWR_CursorFilter
+{
+protected:
+	bool m_bHasPrev;
+	float m_fPrevTime;
+
+	// Filtered cursor and speed
+	float m_fX;
+	float m_fY;
+	float m_fSpeed;
+
+	// Settings
+	float m_fMinCutoff;
+	float m_fBeta;
+	float m_fSpeedCutoff;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_CursorFilter(void);
+private:
+	CWR_CursorFilter(CWR_CursorFilter const&) {}
+	CWR_CursorFilter& operator =(CWR_CursorFilter const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWR_CursorFilter(void);
+
+	////////////////////////////////////////////////////
+	// SetParams
+	//
+	// Purpose: Set how the filter responds
+	//
+	// In:	fMinCutoff - Cutoff frequency (Hz) while still
+	//		fBeta - How much the cutoff rises with speed
+	//			(Hz per screen per second)
+	//		fSpeedCutoff - Cutoff frequency (Hz) used to
+	//			smooth the speed
+	////////////////////////////////////////////////////
+	virtual void SetParams(float fMinCutoff, float fBeta, float fSpeedCutoff);
+
+	////////////////////////////////////////////////////
+	// Reset
+	//
+	// Purpose: Forget the last sample, the next one is
+	//	passed through as is
+	////////////////////////////////////////////////////
+	virtual void Reset(void);
+
+	////////////////////////////////////////////////////
+	// Filter
+	//
+	// Purpose: Filter the next cursor sample
+	//
+	// In:	fX - Cursor X position
+	//		fY - Cursor Y position
+	//		fTime - Time the sample was taken
+	//
+	// Out:	fX - Filtered X position
+	//		fY - Filtered Y position
+	//
+	// Note: The cutoff follows the speed of the cursor,
+	//	so it is smooth while still and has little lag
+	//	while moving fast
+	////////////////////////////////////////////////////
+	virtual void Filter(float &fX, float &fY, float fTime);
+
+protected:
+	////////////////////////////////////////////////////
+	// GetAlpha
+	//
+	// Purpose: Returns the smoothing factor for a
+	//	cutoff frequency over a time step
+	////////////////////////////////////////////////////
+	virtual float GetAlpha(float fCutoff, float fDT) const;
+};
+
+#endif //_WR_CCURSORFILTER_H_
\ No newline at end of file
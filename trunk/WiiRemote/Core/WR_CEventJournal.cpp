@@ -0,0 +1,107 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CEventJournal.cpp
+//
+// Purpose: Lock-free ring of input events, written by
+//	its remote and read by anyone
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_CEventJournal.h"
+
+// Newest events a reader can safely copy; the slot after them may
+//	be getting written
+#define JOURNAL_READABLE (WR_JOURNAL_SIZE-1)
+
+////////////////////////////////////////////////////
+CWR_EventJournal::CWR_EventJournal(void)
+{
+	memset(m_Slots, 0, sizeof(m_Slots));
+	m_nHead = 0;
+}
+
+////////////////////////////////////////////////////
+CWR_EventJournal::~CWR_EventJournal(void)
+{
+}
+
+////////////////////////////////////////////////////
+void CWR_EventJournal::Publish(SJournalEvent const& event)
+{
+	// Only the owning remote writes, so the head needs no lock
+	const LONG nSeq = m_nHead;
+	SSlot &slot = m_Slots[nSeq & (WR_JOURNAL_SIZE-1)];
+
+	// Mark the slot as being written so readers still copying it
+	//	notice, then fill it in and publish it
+	InterlockedExchange(&slot.nStamp, 0);
+	slot.event = event;
+	slot.event.nSeq = (unsigned int)nSeq;
+	InterlockedExchange(&slot.nStamp, nSeq+1);
+	InterlockedExchange(&m_nHead, nSeq+1);
+}
+
+////////////////////////////////////////////////////
+unsigned int CWR_EventJournal::GetHead(void) const
+{
+	return (unsigned int)m_nHead;
+}
+
+////////////////////////////////////////////////////
+void CWR_EventJournal::SeekToHead(SJournalCursor &cursor) const
+{
+	cursor.nNext = GetHead();
+}
+
+////////////////////////////////////////////////////
+void CWR_EventJournal::SeekToOldest(SJournalCursor &cursor) const
+{
+	const unsigned int nHead = GetHead();
+	cursor.nNext = (nHead > JOURNAL_READABLE ? nHead-JOURNAL_READABLE : 0);
+}
+
+////////////////////////////////////////////////////
+int CWR_EventJournal::Read(SJournalCursor &cursor, SJournalEvent *pEvents, int nMax) const
+{
+	int nCount = 0;
+	unsigned int nHead = GetHead();
+	while (nCount < nMax && cursor.nNext != nHead)
+	{
+		// Skip what the writer has lapped
+		if (nHead - cursor.nNext > JOURNAL_READABLE)
+		{
+			cursor.nLost += nHead - JOURNAL_READABLE - cursor.nNext;
+			cursor.nNext = nHead - JOURNAL_READABLE;
+		}
+
+		// Copy it, then make sure it wasn't rewritten while copying
+		SSlot const& slot = m_Slots[cursor.nNext & (WR_JOURNAL_SIZE-1)];
+		const LONG nStamp = slot.nStamp;
+		if ((unsigned int)nStamp == cursor.nNext+1)
+		{
+			pEvents[nCount] = slot.event;
+			MemoryBarrier();
+			if (slot.nStamp == nStamp)
+			{
+				nCount++;
+				cursor.nNext++;
+				continue;
+			}
+		}
+
+		// The writer got to it first, so catch up
+		nHead = GetHead();
+		if (nHead - cursor.nNext <= JOURNAL_READABLE)
+		{
+			cursor.nLost++;
+			cursor.nNext++;
+		}
+	}
+	return nCount;
+}
\ No newline at end of file
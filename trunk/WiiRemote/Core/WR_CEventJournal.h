@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CEventJournal.h
+//
+// Purpose: Lock-free ring of input events, written by
+//	its remote and read by anyone
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CEVENTJOURNAL_H_
+#define _WR_CEVENTJOURNAL_H_
+
+#include "Interfaces\WR_IEventJournal.h"
+
+class CWR_EventJournal : public IWR_EventJournal
+{
+protected:
+	// Event slot. The stamp is the event's position plus
+	//	one once written, or 0 while it is being written
+	struct SSlot
+	{
+		volatile LONG nStamp;
+		SJournalEvent event;
+	};
+	SSlot m_Slots[WR_JOURNAL_SIZE];
+
+	// Position the next event is published at
+	volatile LONG m_nHead;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_EventJournal(void);
+private:
+	CWR_EventJournal(CWR_EventJournal const&) {}
+	CWR_EventJournal& operator =(CWR_EventJournal const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWR_EventJournal(void);
+
+	////////////////////////////////////////////////////
+	// Publish
+	//
+	// Purpose: Add an event, overwriting the oldest if
+	//	the journal is full
+	//
+	// In:	event - Event to add (its position is set here)
+	//
+	// Note: Only the owning remote may publish
+	////////////////////////////////////////////////////
+	virtual void Publish(SJournalEvent const& event);
+
+	////////////////////////////////////////////////////
+	// GetHead
+	//
+	// Purpose: Returns the position the next event will
+	//	be published at
+	////////////////////////////////////////////////////
+	virtual unsigned int GetHead(void) const;
+
+	////////////////////////////////////////////////////
+	// SeekToHead
+	//
+	// Purpose: Move a cursor so it only reads events
+	//	published from now on
+	//
+	// In:	cursor - Cursor to move
+	////////////////////////////////////////////////////
+	virtual void SeekToHead(SJournalCursor &cursor) const;
+
+	////////////////////////////////////////////////////
+	// SeekToOldest
+	//
+	// Purpose: Move a cursor to the oldest event still
+	//	kept
+	//
+	// In:	cursor - Cursor to move
+	////////////////////////////////////////////////////
+	virtual void SeekToOldest(SJournalCursor &cursor) const;
+
+	////////////////////////////////////////////////////
+	// Read
+	//
+	// Purpose: Copy out the events after a cursor and
+	//	move it past them
+	//
+	// In:	cursor - Reader's own cursor
+	//		pEvents - Where to copy the events
+	//		nMax - Most events to copy
+	//
+	// Returns the number of events copied
+	////////////////////////////////////////////////////
+	virtual int Read(SJournalCursor &cursor, SJournalEvent *pEvents, int nMax) const;
+};
+
+#endif //_WR_CEVENTJOURNAL_H_
\ No newline at end of file
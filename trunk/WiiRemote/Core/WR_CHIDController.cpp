@@ -111,7 +111,7 @@ int CWR_HIDController::PoolRemoteDevices(int nCount, float fTimeout)
 							m_FoundRemotes[m_nFoundCount++] = pDeviceData->DevicePath;
 
 							// Call the callback
-							for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+							for (Listeners::Dispatch itI(m_Listeners, WR_HIDEVENT_FOUNDDEVICE); itI; ++itI)
 								(*itI)->OnFoundRemoteDevice(pDeviceData->DevicePath, deviceHandle);
 						}
 					}
@@ -144,7 +144,7 @@ void CWR_HIDController::Shutdown(void)
 	ShutdownRemotes();
 
 	// Clean out listeners
-	m_Listeners.clear();
+	m_Listeners.Clear();
 }
 
 ////////////////////////////////////////////////////
@@ -175,17 +175,20 @@ IWR_WiiRemote* CWR_HIDController::InitializeRemote(int nID)
 		NULL != m_Remotes[nID])
 		return NULL;
 
-	// Create entry
+	// Create entry, its listeners are called wherever the others' are
+	g_pWR->LockInput();
 	IWR_WiiRemote *pRemote = new CWR_WiiRemote;
 	assert(pRemote);
+	pRemote->SetDeferredListeners(g_pWR->IsThreadedInput());
 	if (WR_SUCCESS(pRemote->Initialize(m_FoundRemotes[nID].c_str(), nID+1)))
 	{
 		m_Remotes[nID] = pRemote;
 
 		// Call the callback
-		for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+		for (Listeners::Dispatch itI(m_Listeners, WR_HIDEVENT_INITIALIZED); itI; ++itI)
 			(*itI)->OnRemoteInitialized(pRemote, pRemote->GetID());
 
+		g_pWR->UnlockInput();
 		return pRemote;
 	}
 	else
@@ -193,6 +196,7 @@ IWR_WiiRemote* CWR_HIDController::InitializeRemote(int nID)
 		// Don't hold on to it if it failed
 		SAFE_DELETE(pRemote);
 	}
+	g_pWR->UnlockInput();
 	return NULL;
 }
 
@@ -200,6 +204,7 @@ IWR_WiiRemote* CWR_HIDController::InitializeRemote(int nID)
 void CWR_HIDController::ShutdownRemotes(void)
 {
 	// Shutdown all remotes
+	g_pWR->LockInput();
 	for (int i = 0; i < MAX_REMOTES; i++)
 	{
 		if (NULL != m_Remotes[i])
@@ -209,6 +214,7 @@ void CWR_HIDController::ShutdownRemotes(void)
 		}
 	}
 	memset(m_Remotes, 0, sizeof(RemoteMap));
+	g_pWR->UnlockInput();
 }
 
 ////////////////////////////////////////////////////
@@ -245,23 +251,13 @@ int CWR_HIDController::GetRemoteCount(void) const
 }
 
 ////////////////////////////////////////////////////
-void CWR_HIDController::AddListener(IWR_HIDControllerListener *pListener)
+void CWR_HIDController::AddListener(IWR_HIDControllerListener *pListener, unsigned int nEvents)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-			return;
-	m_Listeners.push_back(pListener);
+	m_Listeners.Add(pListener, nEvents);
 }
 
 ////////////////////////////////////////////////////
 void CWR_HIDController::RemoveListener(IWR_HIDControllerListener *pListener)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-		{
-			m_Listeners.erase(itI);
-			return;
-		}
+	m_Listeners.Remove(pListener);
 }
\ No newline at end of file
@@ -30,7 +30,7 @@ protected:
 	int m_nFoundCount;
 
 	// Listeners
-	typedef std::list<IWR_HIDControllerListener*> Listeners;
+	typedef CWR_ListenerList<IWR_HIDControllerListener> Listeners;
 	Listeners m_Listeners;
 
 public:
@@ -151,8 +151,11 @@ public:
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_HIDCONTROLLER_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_HIDControllerListener *pListener);
+	virtual void AddListener(IWR_HIDControllerListener *pListener, unsigned int nEvents = WR_HIDEVENT_DEFAULT);
 
 	////////////////////////////////////////////////////
 	// RemoveListener
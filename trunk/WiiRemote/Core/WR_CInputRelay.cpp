@@ -0,0 +1,560 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CInputRelay.cpp
+//
+// Purpose: Records the listener calls a remote makes
+//	while it is updated so they can be made later on
+//	another thread
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_CInputRelay.h"
+
+////////////////////////////////////////////////////
+CWR_InputRelay::CWR_InputRelay(void)
+{
+	m_nRecord = 0;
+	m_pRemoteListeners = NULL;
+	m_pButtonsListeners = NULL;
+	m_pMotionListeners = NULL;
+	m_pSensorListeners = NULL;
+	m_pExtensionListeners = NULL;
+	m_pDataListeners = NULL;
+
+	InitializeCriticalSection(&m_csRecord);
+}
+
+////////////////////////////////////////////////////
+CWR_InputRelay::~CWR_InputRelay(void)
+{
+	// Nothing is replayed anymore, but retired extensions are still owned
+	for (int i = 0; i < 2; i++)
+	{
+		for (size_t j = 0; j < m_Batches[i].Retired.size(); j++)
+			SAFE_DELETE(m_Batches[i].Retired[j]);
+	}
+	DeleteCriticalSection(&m_csRecord);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Attach(RemoteListeners *pList)
+{
+	m_pRemoteListeners = pList;
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Attach(ButtonsListeners *pList)
+{
+	m_pButtonsListeners = pList;
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Attach(MotionListeners *pList)
+{
+	m_pMotionListeners = pList;
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Attach(SensorListeners *pList)
+{
+	m_pSensorListeners = pList;
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Attach(ExtensionListeners *pList)
+{
+	m_pExtensionListeners = pList;
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Attach(DataListeners *pList)
+{
+	m_pDataListeners = pList;
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Retire(IWR_WiiExtension *pExtension)
+{
+	if (NULL == pExtension) return;
+	EnterCriticalSection(&m_csRecord);
+	m_Batches[m_nRecord].Retired.push_back(pExtension);
+	LeaveCriticalSection(&m_csRecord);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Replay(void)
+{
+	// Take the recorded batch and let recording carry on in the other one
+	EnterCriticalSection(&m_csRecord);
+	SBatch &batch = m_Batches[m_nRecord];
+	m_nRecord ^= 1;
+	LeaveCriticalSection(&m_csRecord);
+
+	for (size_t i = 0; i < batch.Calls.size(); i++)
+		ReplayCall(batch, batch.Calls[i]);
+
+	// Nothing refers to the retired extensions anymore
+	for (size_t i = 0; i < batch.Retired.size(); i++)
+		SAFE_DELETE(batch.Retired[i]);
+
+	// Keep the storage for the next time around
+	batch.Calls.clear();
+	batch.Elements.clear();
+	batch.Names.clear();
+	batch.Data.clear();
+	batch.Retired.clear();
+}
+
+////////////////////////////////////////////////////
+CWR_InputRelay::SCall CWR_InputRelay::MakeCall(int nCall, void *pList, IWR_WiiRemote *pRemote, void *pHelper)
+{
+	SCall call;
+	memset(&call, 0, sizeof(SCall));
+	call.nCall = nCall;
+	call.pList = pList;
+	call.pRemote = pRemote;
+	call.pHelper = pHelper;
+	return call;
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Record(SCall &call)
+{
+	EnterCriticalSection(&m_csRecord);
+	m_Batches[m_nRecord].Calls.push_back(call);
+	LeaveCriticalSection(&m_csRecord);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Record(SCall &call, SMotionSpan const& motions)
+{
+	// Spans point into the helper's ring, which moves on before the replay
+	EnterCriticalSection(&m_csRecord);
+	SBatch &batch = m_Batches[m_nRecord];
+	call.nFirst = (int)batch.Elements.size();
+	call.nCount = motions.Size();
+	batch.Elements.insert(batch.Elements.end(), motions.pElements, motions.pElements+motions.nCount);
+	batch.Calls.push_back(call);
+	LeaveCriticalSection(&m_csRecord);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Record(SCall &call, char const* szName)
+{
+	if (NULL == szName) szName = "";
+	const int nLength = (int)strlen(szName)+1;
+
+	EnterCriticalSection(&m_csRecord);
+	SBatch &batch = m_Batches[m_nRecord];
+	call.nFirst = (int)batch.Names.size();
+	call.nCount = nLength;
+	batch.Names.insert(batch.Names.end(), szName, szName+nLength);
+	batch.Calls.push_back(call);
+	LeaveCriticalSection(&m_csRecord);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::Record(SCall &call, LPWiiIOData pData, int nSize)
+{
+	if (NULL == pData || nSize < 0) nSize = 0;
+
+	EnterCriticalSection(&m_csRecord);
+	SBatch &batch = m_Batches[m_nRecord];
+	call.nFirst = (int)batch.Data.size();
+	call.nCount = nSize;
+	batch.Data.insert(batch.Data.end(), pData, pData+nSize);
+	batch.Calls.push_back(call);
+	LeaveCriticalSection(&m_csRecord);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::ReplayCall(SBatch &batch, SCall const& call)
+{
+	IWR_WiiRemote *pRemote = call.pRemote;
+	IWR_WiiExtension *pExtension = (IWR_WiiExtension*)call.pHelper;
+
+	// Find what the call copied, depending on its kind
+	SMotionSpan span;
+	char const* szName = "";
+	LPWiiIOData pData = NULL;
+	if (0 < call.nCount)
+	{
+		switch (call.nCall)
+		{
+			case RELAY_ACTION: case RELAY_EXTACTION: szName = &batch.Names[call.nFirst]; break;
+			case RELAY_DATAREAD: pData = &batch.Data[call.nFirst]; break;
+			default: span = SMotionSpan(&batch.Elements[call.nFirst], call.nCount); break;
+		}
+	}
+
+	// Walk the listeners themselves, not the relay
+	switch (call.nCall)
+	{
+		case RELAY_CONNECT:
+			for (RemoteListeners::Dispatch itI(*(RemoteListeners*)call.pList, WR_REMOTEEVENT_CONNECT, false); itI; ++itI)
+				(*itI)->OnConnect(pRemote);
+			break;
+		case RELAY_DISCONNECT:
+			for (RemoteListeners::Dispatch itI(*(RemoteListeners*)call.pList, WR_REMOTEEVENT_DISCONNECT, false); itI; ++itI)
+				(*itI)->OnDisconnect(pRemote, call.args.value.bFlag);
+			break;
+		case RELAY_CONNECTING:
+			for (RemoteListeners::Dispatch itI(*(RemoteListeners*)call.pList, WR_REMOTEEVENT_CONNECTING, false); itI; ++itI)
+				(*itI)->OnConnecting(pRemote);
+			break;
+		case RELAY_REPORTCHANGED:
+			for (RemoteListeners::Dispatch itI(*(RemoteListeners*)call.pList, WR_REMOTEEVENT_REPORTCHANGED, false); itI; ++itI)
+				(*itI)->OnReportChanged(pRemote, call.args.value.nA, call.args.value.bFlag);
+			break;
+		case RELAY_STATUSUPDATE:
+			for (RemoteListeners::Dispatch itI(*(RemoteListeners*)call.pList, WR_REMOTEEVENT_STATUSUPDATE, false); itI; ++itI)
+				(*itI)->OnStatusUpdate(pRemote, call.args.value.nA, call.args.value.nB);
+			break;
+		case RELAY_EXTENSIONPLUGGEDIN:
+			for (RemoteListeners::Dispatch itI(*(RemoteListeners*)call.pList, WR_REMOTEEVENT_EXTENSIONPLUGGEDIN, false); itI; ++itI)
+				(*itI)->OnExtensionPluggedIn(pRemote, pExtension);
+			break;
+		case RELAY_EXTENSIONUNPLUGGED:
+			for (RemoteListeners::Dispatch itI(*(RemoteListeners*)call.pList, WR_REMOTEEVENT_EXTENSIONUNPLUGGED, false); itI; ++itI)
+				(*itI)->OnExtensionUnplugged(pRemote, pExtension);
+			break;
+
+		case RELAY_BUTTON:
+			for (ButtonsListeners::Dispatch itI(*(ButtonsListeners*)call.pList, WR_BUTTONEVENT_BUTTON, false); itI; ++itI)
+				(*itI)->OnButton(pRemote, (IWR_WiiButtons*)call.pHelper, call.args.button.nButton, call.args.button.nStatus, call.args.button.bDown);
+			break;
+		case RELAY_ACTION:
+			for (ButtonsListeners::Dispatch itI(*(ButtonsListeners*)call.pList, WR_BUTTONEVENT_ACTION, false); itI; ++itI)
+				(*itI)->OnAction(pRemote, (IWR_WiiButtons*)call.pHelper, szName, call.args.action.nID, call.args.action.nStatus, call.args.action.bDown);
+			break;
+
+		case RELAY_SINGLEMOTION:
+			for (MotionListeners::Dispatch itI(*(MotionListeners*)call.pList, WR_MOTIONEVENT_SINGLE, false); itI; ++itI)
+				(*itI)->OnSingleMotion(pRemote, (IWR_WiiMotion*)call.pHelper, span.Front());
+			break;
+		case RELAY_MOTIONSTART:
+			for (MotionListeners::Dispatch itI(*(MotionListeners*)call.pList, WR_MOTIONEVENT_START, false); itI; ++itI)
+				(*itI)->OnMotionStart(pRemote, (IWR_WiiMotion*)call.pHelper, span);
+			break;
+		case RELAY_MOTIONUPDATE:
+			for (MotionListeners::Dispatch itI(*(MotionListeners*)call.pList, WR_MOTIONEVENT_UPDATE, false); itI; ++itI)
+				(*itI)->OnMotionUpdate(pRemote, (IWR_WiiMotion*)call.pHelper, span.Front());
+			break;
+		case RELAY_MOTIONEND:
+			for (MotionListeners::Dispatch itI(*(MotionListeners*)call.pList, WR_MOTIONEVENT_END, false); itI; ++itI)
+				(*itI)->OnMotionEnd(pRemote, (IWR_WiiMotion*)call.pHelper, span.Front());
+			break;
+		case RELAY_MOTIONCANCEL:
+			for (MotionListeners::Dispatch itI(*(MotionListeners*)call.pList, WR_MOTIONEVENT_CANCEL, false); itI; ++itI)
+				(*itI)->OnMotionCancel(pRemote, (IWR_WiiMotion*)call.pHelper, span.Front());
+			break;
+		case RELAY_MOTIONBATCH:
+			for (MotionListeners::Dispatch itI(*(MotionListeners*)call.pList, WR_MOTIONEVENT_BATCH, false); itI; ++itI)
+				(*itI)->OnMotionBatch(pRemote, (IWR_WiiMotion*)call.pHelper, span);
+			break;
+
+		case RELAY_ENTERSCREEN:
+			for (SensorListeners::Dispatch itI(*(SensorListeners*)call.pList, WR_SENSOREVENT_ENTERSCREEN, false); itI; ++itI)
+				(*itI)->OnEnterScreen(pRemote, (IWR_WiiSensor*)call.pHelper, call.args.point.fX, call.args.point.fY);
+			break;
+		case RELAY_LEAVESCREEN:
+			for (SensorListeners::Dispatch itI(*(SensorListeners*)call.pList, WR_SENSOREVENT_LEAVESCREEN, false); itI; ++itI)
+				(*itI)->OnLeaveScreen(pRemote, (IWR_WiiSensor*)call.pHelper, call.args.point.fX, call.args.point.fY);
+			break;
+		case RELAY_CURSORUPDATE:
+			for (SensorListeners::Dispatch itI(*(SensorListeners*)call.pList, WR_SENSOREVENT_CURSORUPDATE, false); itI; ++itI)
+				(*itI)->OnCursorUpdate(pRemote, (IWR_WiiSensor*)call.pHelper, call.args.point.fX, call.args.point.fY);
+			break;
+
+		case RELAY_EXTBUTTON:
+			for (ExtensionListeners::Dispatch itI(*(ExtensionListeners*)call.pList, WR_EXTEVENT_BUTTON, false); itI; ++itI)
+				(*itI)->OnExtensionButton(pRemote, pExtension, call.args.button.nButton, call.args.button.nStatus, call.args.button.bDown);
+			break;
+		case RELAY_EXTACTION:
+			for (ExtensionListeners::Dispatch itI(*(ExtensionListeners*)call.pList, WR_EXTEVENT_ACTION, false); itI; ++itI)
+				(*itI)->OnExtensionAction(pRemote, pExtension, szName, call.args.action.nID, call.args.action.nStatus, call.args.action.bDown);
+			break;
+		case RELAY_EXTSINGLEMOTION:
+			for (ExtensionListeners::Dispatch itI(*(ExtensionListeners*)call.pList, WR_EXTEVENT_SINGLEMOTION, false); itI; ++itI)
+				(*itI)->OnExtensionSingleMotion(pRemote, pExtension, span.Front());
+			break;
+		case RELAY_EXTMOTIONSTART:
+			for (ExtensionListeners::Dispatch itI(*(ExtensionListeners*)call.pList, WR_EXTEVENT_MOTIONSTART, false); itI; ++itI)
+				(*itI)->OnExtensionMotionStart(pRemote, pExtension, span);
+			break;
+		case RELAY_EXTMOTIONUPDATE:
+			for (ExtensionListeners::Dispatch itI(*(ExtensionListeners*)call.pList, WR_EXTEVENT_MOTIONUPDATE, false); itI; ++itI)
+				(*itI)->OnExtensionMotionUpdate(pRemote, pExtension, span.Front());
+			break;
+		case RELAY_EXTMOTIONEND:
+			for (ExtensionListeners::Dispatch itI(*(ExtensionListeners*)call.pList, WR_EXTEVENT_MOTIONEND, false); itI; ++itI)
+				(*itI)->OnExtensionMotionEnd(pRemote, pExtension, span.Front());
+			break;
+		case RELAY_EXTMOTIONCANCEL:
+			for (ExtensionListeners::Dispatch itI(*(ExtensionListeners*)call.pList, WR_EXTEVENT_MOTIONCANCEL, false); itI; ++itI)
+				(*itI)->OnExtensionMotionCancel(pRemote, pExtension, span.Front());
+			break;
+		case RELAY_EXTANALOGUPDATE:
+			for (ExtensionListeners::Dispatch itI(*(ExtensionListeners*)call.pList, WR_EXTEVENT_ANALOGUPDATE, false); itI; ++itI)
+				(*itI)->OnExtensionAnalogUpdate(pRemote, pExtension, call.args.point.nStick, call.args.point.fX, call.args.point.fY);
+			break;
+		case RELAY_EXTMOTIONBATCH:
+			for (ExtensionListeners::Dispatch itI(*(ExtensionListeners*)call.pList, WR_EXTEVENT_MOTIONBATCH, false); itI; ++itI)
+				(*itI)->OnExtensionMotionBatch(pRemote, pExtension, span);
+			break;
+
+		case RELAY_DATAREAD:
+			for (DataListeners::Dispatch itI(*(DataListeners*)call.pList, WR_DATAEVENT_READ, false); itI; ++itI)
+				(*itI)->OnDataRead(pRemote, (IWR_WiiData*)call.pHelper, call.args.value.nA, call.nCount, pData);
+			break;
+		case RELAY_DATAERROR:
+			for (DataListeners::Dispatch itI(*(DataListeners*)call.pList, WR_DATAEVENT_ERROR, false); itI; ++itI)
+				(*itI)->OnDataError(pRemote, (IWR_WiiData*)call.pHelper, call.args.value.nA, call.args.value.nB);
+			break;
+	}
+}
+
+////////////////////////////////////////////////////
+////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnConnect(IWR_WiiRemote *pRemote)
+{
+	SCall call = MakeCall(RELAY_CONNECT, m_pRemoteListeners, pRemote, NULL);
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnDisconnect(IWR_WiiRemote *pRemote, bool bAbnormal)
+{
+	SCall call = MakeCall(RELAY_DISCONNECT, m_pRemoteListeners, pRemote, NULL);
+	call.args.value.bFlag = bAbnormal;
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnConnecting(IWR_WiiRemote *pRemote)
+{
+	SCall call = MakeCall(RELAY_CONNECTING, m_pRemoteListeners, pRemote, NULL);
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnReportChanged(IWR_WiiRemote *pRemote, int nReport, bool bContinuous)
+{
+	SCall call = MakeCall(RELAY_REPORTCHANGED, m_pRemoteListeners, pRemote, NULL);
+	call.args.value.nA = nReport;
+	call.args.value.bFlag = bContinuous;
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnStatusUpdate(IWR_WiiRemote *pRemote, int nStatus, int nBattery)
+{
+	SCall call = MakeCall(RELAY_STATUSUPDATE, m_pRemoteListeners, pRemote, NULL);
+	call.args.value.nA = nStatus;
+	call.args.value.nB = nBattery;
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionPluggedIn(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension)
+{
+	SCall call = MakeCall(RELAY_EXTENSIONPLUGGEDIN, m_pRemoteListeners, pRemote, pExtension);
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionUnplugged(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension)
+{
+	SCall call = MakeCall(RELAY_EXTENSIONUNPLUGGED, m_pRemoteListeners, pRemote, pExtension);
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnButton(IWR_WiiRemote *pRemote, IWR_WiiButtons *pButtons,
+	unsigned int nButton, int nStatus, bool bDown)
+{
+	SCall call = MakeCall(RELAY_BUTTON, m_pButtonsListeners, pRemote, pButtons);
+	call.args.button.nButton = nButton;
+	call.args.button.nStatus = nStatus;
+	call.args.button.bDown = bDown;
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnAction(IWR_WiiRemote *pRemote, IWR_WiiButtons *pButtons, char const* szAction,
+	ActionID nActionID, int nStatus, bool bDown)
+{
+	SCall call = MakeCall(RELAY_ACTION, m_pButtonsListeners, pRemote, pButtons);
+	call.args.action.nID = nActionID;
+	call.args.action.nStatus = nStatus;
+	call.args.action.bDown = bDown;
+	Record(call, szAction);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion)
+{
+	SCall call = MakeCall(RELAY_SINGLEMOTION, m_pMotionListeners, pRemote, pMotion);
+	Record(call, SMotionSpan(&motion, 1));
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnMotionStart(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& onset)
+{
+	SCall call = MakeCall(RELAY_MOTIONSTART, m_pMotionListeners, pRemote, pMotion);
+	Record(call, onset);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnMotionUpdate(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion)
+{
+	SCall call = MakeCall(RELAY_MOTIONUPDATE, m_pMotionListeners, pRemote, pMotion);
+	Record(call, SMotionSpan(&motion, 1));
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion)
+{
+	SCall call = MakeCall(RELAY_MOTIONEND, m_pMotionListeners, pRemote, pMotion);
+	Record(call, SMotionSpan(&motion, 1));
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion)
+{
+	SCall call = MakeCall(RELAY_MOTIONCANCEL, m_pMotionListeners, pRemote, pMotion);
+	Record(call, SMotionSpan(&motion, 1));
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& motions)
+{
+	SCall call = MakeCall(RELAY_MOTIONBATCH, m_pMotionListeners, pRemote, pMotion);
+	Record(call, motions);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnEnterScreen(IWR_WiiRemote *pRemote, IWR_WiiSensor *pSensor, float fX, float fY)
+{
+	SCall call = MakeCall(RELAY_ENTERSCREEN, m_pSensorListeners, pRemote, pSensor);
+	call.args.point.fX = fX;
+	call.args.point.fY = fY;
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnLeaveScreen(IWR_WiiRemote *pRemote, IWR_WiiSensor *pSensor, float fX, float fY)
+{
+	SCall call = MakeCall(RELAY_LEAVESCREEN, m_pSensorListeners, pRemote, pSensor);
+	call.args.point.fX = fX;
+	call.args.point.fY = fY;
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnCursorUpdate(IWR_WiiRemote *pRemote, IWR_WiiSensor *pSensor, float fX, float fY)
+{
+	SCall call = MakeCall(RELAY_CURSORUPDATE, m_pSensorListeners, pRemote, pSensor);
+	call.args.point.fX = fX;
+	call.args.point.fY = fY;
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionButton(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension,
+	unsigned int nButton, int nStatus, bool bDown)
+{
+	SCall call = MakeCall(RELAY_EXTBUTTON, m_pExtensionListeners, pRemote, pExtension);
+	call.args.button.nButton = nButton;
+	call.args.button.nStatus = nStatus;
+	call.args.button.bDown = bDown;
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionAction(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension,
+	char const* szAction, ActionID nActionID, int nStatus, bool bDown)
+{
+	SCall call = MakeCall(RELAY_EXTACTION, m_pExtensionListeners, pRemote, pExtension);
+	call.args.action.nID = nActionID;
+	call.args.action.nStatus = nStatus;
+	call.args.action.bDown = bDown;
+	Record(call, szAction);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion)
+{
+	SCall call = MakeCall(RELAY_EXTSINGLEMOTION, m_pExtensionListeners, pRemote, pExtension);
+	Record(call, SMotionSpan(&motion, 1));
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionMotionStart(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& onset)
+{
+	SCall call = MakeCall(RELAY_EXTMOTIONSTART, m_pExtensionListeners, pRemote, pExtension);
+	Record(call, onset);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionMotionUpdate(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion)
+{
+	SCall call = MakeCall(RELAY_EXTMOTIONUPDATE, m_pExtensionListeners, pRemote, pExtension);
+	Record(call, SMotionSpan(&motion, 1));
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion)
+{
+	SCall call = MakeCall(RELAY_EXTMOTIONEND, m_pExtensionListeners, pRemote, pExtension);
+	Record(call, SMotionSpan(&motion, 1));
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion)
+{
+	SCall call = MakeCall(RELAY_EXTMOTIONCANCEL, m_pExtensionListeners, pRemote, pExtension);
+	Record(call, SMotionSpan(&motion, 1));
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionAnalogUpdate(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, int nStickID, float fX, float fY)
+{
+	SCall call = MakeCall(RELAY_EXTANALOGUPDATE, m_pExtensionListeners, pRemote, pExtension);
+	call.args.point.nStick = nStickID;
+	call.args.point.fX = fX;
+	call.args.point.fY = fY;
+	Record(call);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnExtensionMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& motions)
+{
+	SCall call = MakeCall(RELAY_EXTMOTIONBATCH, m_pExtensionListeners, pRemote, pExtension);
+	Record(call, motions);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnDataRead(IWR_WiiRemote *pRemote, IWR_WiiData *pHelper, int nAddr, int nSize, LPWiiIOData pData)
+{
+	SCall call = MakeCall(RELAY_DATAREAD, m_pDataListeners, pRemote, pHelper);
+	call.args.value.nA = nAddr;
+	Record(call, pData, nSize);
+}
+
+////////////////////////////////////////////////////
+void CWR_InputRelay::OnDataError(IWR_WiiRemote *pRemote, IWR_WiiData *pHelper, int nAddr, int nError)
+{
+	SCall call = MakeCall(RELAY_DATAERROR, m_pDataListeners, pRemote, pHelper);
+	call.args.value.nA = nAddr;
+	call.args.value.nB = nError;
+	Record(call);
+}
\ No newline at end of file
@@ -0,0 +1,245 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CInputRelay.h
+//
+// Purpose: Records the listener calls a remote makes
+//	while it is updated so they can be made later on
+//	another thread
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CINPUTRELAY_H_
+#define _WR_CINPUTRELAY_H_
+
+class CWR_InputRelay : public IWR_WiiRemoteListener, public IWR_WiiButtonsListener,
+	public IWR_WiiMotionListener, public IWR_WiiSensorListener,
+	public IWR_WiiExtensionListener, public IWR_WiiDataListener
+{
+public:
+	// Listener lists calls are replayed to
+	typedef CWR_ListenerList<IWR_WiiRemoteListener> RemoteListeners;
+	typedef CWR_ListenerList<IWR_WiiButtonsListener> ButtonsListeners;
+	typedef CWR_ListenerList<IWR_WiiMotionListener> MotionListeners;
+	typedef CWR_ListenerList<IWR_WiiSensorListener> SensorListeners;
+	typedef CWR_ListenerList<IWR_WiiExtensionListener> ExtensionListeners;
+	typedef CWR_ListenerList<IWR_WiiDataListener> DataListeners;
+
+protected:
+	// Recorded calls, one per listener method
+	enum ERELAYCALLS
+	{
+		RELAY_CONNECT,
+		RELAY_DISCONNECT,
+		RELAY_CONNECTING,
+		RELAY_REPORTCHANGED,
+		RELAY_STATUSUPDATE,
+		RELAY_EXTENSIONPLUGGEDIN,
+		RELAY_EXTENSIONUNPLUGGED,
+		RELAY_BUTTON,
+		RELAY_ACTION,
+		RELAY_SINGLEMOTION,
+		RELAY_MOTIONSTART,
+		RELAY_MOTIONUPDATE,
+		RELAY_MOTIONEND,
+		RELAY_MOTIONCANCEL,
+		RELAY_MOTIONBATCH,
+		RELAY_ENTERSCREEN,
+		RELAY_LEAVESCREEN,
+		RELAY_CURSORUPDATE,
+		RELAY_EXTBUTTON,
+		RELAY_EXTACTION,
+		RELAY_EXTSINGLEMOTION,
+		RELAY_EXTMOTIONSTART,
+		RELAY_EXTMOTIONUPDATE,
+		RELAY_EXTMOTIONEND,
+		RELAY_EXTMOTIONCANCEL,
+		RELAY_EXTANALOGUPDATE,
+		RELAY_EXTMOTIONBATCH,
+		RELAY_DATAREAD,
+		RELAY_DATAERROR,
+	};
+
+	// Recorded call. Motion elements, action names and data
+	//	are copied into the batch and found by nFirst and nCount
+	struct SCall
+	{
+		int nCall;					// See ERELAYCALLS
+		void *pList;				// Listeners to replay it to
+		IWR_WiiRemote *pRemote;
+		void *pHelper;				// Helper or extension that made the call
+		int nFirst, nCount;
+		union
+		{
+			struct { unsigned int nButton; int nStatus; bool bDown; } button;
+			struct { ActionID nID; int nStatus; bool bDown; } action;
+			struct { int nStick; float fX, fY; } point;
+			struct { int nA, nB; bool bFlag; } value;
+		} args;
+	};
+
+	// Calls recorded between two replays
+	struct SBatch
+	{
+		std::vector<SCall> Calls;
+		std::vector<SMotionElement> Elements;
+		std::vector<char> Names;
+		std::vector<WiiIOData> Data;
+		std::vector<IWR_WiiExtension*> Retired;	// Deleted once replayed
+	};
+	SBatch m_Batches[2];
+	int m_nRecord;					// Batch being recorded into
+	CRITICAL_SECTION m_csRecord;
+
+	// Attached listener lists
+	RemoteListeners *m_pRemoteListeners;
+	ButtonsListeners *m_pButtonsListeners;
+	MotionListeners *m_pMotionListeners;
+	SensorListeners *m_pSensorListeners;
+	ExtensionListeners *m_pExtensionListeners;
+	DataListeners *m_pDataListeners;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_InputRelay(void);
+private:
+	CWR_InputRelay(CWR_InputRelay const&) {}
+	CWR_InputRelay& operator =(CWR_InputRelay const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWR_InputRelay(void);
+
+	////////////////////////////////////////////////////
+	// Attach
+	//
+	// Purpose: Set the listener list calls of a kind are
+	//	replayed to
+	//
+	// In:	pList - Listener list
+	//
+	// Note: Calls already recorded keep the list they
+	//	were recorded with
+	////////////////////////////////////////////////////
+	virtual void Attach(RemoteListeners *pList);
+	virtual void Attach(ButtonsListeners *pList);
+	virtual void Attach(MotionListeners *pList);
+	virtual void Attach(SensorListeners *pList);
+	virtual void Attach(ExtensionListeners *pList);
+	virtual void Attach(DataListeners *pList);
+
+	////////////////////////////////////////////////////
+	// Retire
+	//
+	// Purpose: Delete an extension once the calls
+	//	recorded so far have been replayed
+	//
+	// In:	pExtension - Extension that was unplugged
+	////////////////////////////////////////////////////
+	virtual void Retire(IWR_WiiExtension *pExtension);
+
+	////////////////////////////////////////////////////
+	// Replay
+	//
+	// Purpose: Make the calls recorded so far, in the
+	//	order they were recorded
+	//
+	// Note: Calls recorded while replaying wait for the
+	//	next replay. Only one thread may replay
+	////////////////////////////////////////////////////
+	virtual void Replay(void);
+
+public:
+	// IWR_WiiRemoteListener
+	virtual void OnConnect(IWR_WiiRemote *pRemote);
+	virtual void OnDisconnect(IWR_WiiRemote *pRemote, bool bAbnormal);
+	virtual void OnConnecting(IWR_WiiRemote *pRemote);
+	virtual void OnReportChanged(IWR_WiiRemote *pRemote, int nReport, bool bContinuous);
+	virtual void OnStatusUpdate(IWR_WiiRemote *pRemote, int nStatus, int nBattery);
+	virtual void OnExtensionPluggedIn(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension);
+	virtual void OnExtensionUnplugged(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension);
+
+	// IWR_WiiButtonsListener
+	virtual void OnButton(IWR_WiiRemote *pRemote, IWR_WiiButtons *pButtons,
+		unsigned int nButton, int nStatus, bool bDown);
+	virtual void OnAction(IWR_WiiRemote *pRemote, IWR_WiiButtons *pButtons, char const* szAction,
+		ActionID nActionID, int nStatus, bool bDown);
+
+	// IWR_WiiMotionListener
+	virtual void OnSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion);
+	virtual void OnMotionStart(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& onset);
+	virtual void OnMotionUpdate(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion);
+	virtual void OnMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion);
+	virtual void OnMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionElement const& motion);
+	virtual void OnMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiMotion *pMotion, SMotionSpan const& motions);
+
+	// IWR_WiiSensorListener
+	virtual void OnEnterScreen(IWR_WiiRemote *pRemote, IWR_WiiSensor *pSensor, float fX, float fY);
+	virtual void OnLeaveScreen(IWR_WiiRemote *pRemote, IWR_WiiSensor *pSensor, float fX, float fY);
+	virtual void OnCursorUpdate(IWR_WiiRemote *pRemote, IWR_WiiSensor *pSensor, float fX, float fY);
+
+	// IWR_WiiExtensionListener
+	virtual void OnExtensionButton(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension,
+		unsigned int nButton, int nStatus, bool bDown);
+	virtual void OnExtensionAction(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension,
+		char const* szAction, ActionID nActionID, int nStatus, bool bDown);
+	virtual void OnExtensionSingleMotion(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion);
+	virtual void OnExtensionMotionStart(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& onset);
+	virtual void OnExtensionMotionUpdate(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion);
+	virtual void OnExtensionMotionEnd(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion);
+	virtual void OnExtensionMotionCancel(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionElement const& motion);
+	virtual void OnExtensionAnalogUpdate(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, int nStickID, float fX, float fY);
+	virtual void OnExtensionMotionBatch(IWR_WiiRemote *pRemote, IWR_WiiExtension *pExtension, SMotionSpan const& motions);
+
+	// IWR_WiiDataListener
+	virtual void OnDataRead(IWR_WiiRemote *pRemote, IWR_WiiData *pHelper, int nAddr, int nSize, LPWiiIOData pData);
+	virtual void OnDataError(IWR_WiiRemote *pRemote, IWR_WiiData *pHelper, int nAddr, int nError);
+
+protected:
+	////////////////////////////////////////////////////
+	// MakeCall
+	//
+	// Purpose: Start a call to record
+	//
+	// In:	nCall - Call (see ERELAYCALLS)
+	//		pList - Listeners to replay it to
+	//		pRemote - Remote making the call
+	//		pHelper - Helper making the call
+	////////////////////////////////////////////////////
+	static SCall MakeCall(int nCall, void *pList, IWR_WiiRemote *pRemote, void *pHelper);
+
+	////////////////////////////////////////////////////
+	// Record
+	//
+	// Purpose: Add a call to the batch being recorded,
+	//	copying what it points to
+	//
+	// In:	call - Call to add
+	//		motions - Motion elements to copy
+	//		szName - Action name to copy
+	//		pData, nSize - Data to copy
+	////////////////////////////////////////////////////
+	virtual void Record(SCall &call);
+	virtual void Record(SCall &call, SMotionSpan const& motions);
+	virtual void Record(SCall &call, char const* szName);
+	virtual void Record(SCall &call, LPWiiIOData pData, int nSize);
+
+	////////////////////////////////////////////////////
+	// ReplayCall
+	//
+	// Purpose: Make one recorded call
+	//
+	// In:	batch - Batch it was recorded in
+	//		call - Call to make
+	////////////////////////////////////////////////////
+	virtual void ReplayCall(SBatch &batch, SCall const& call);
+};
+
+#endif //_WR_CINPUTRELAY_H_
\ No newline at end of file
@@ -0,0 +1,242 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CListenerList.h
+//
+// Purpose: Listener storage shared by all helpers
+//	Listeners subscribe to a mask of events and only
+//	the ones subscribed to an event are called
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CLISTENERLIST_H_
+#define _WR_CLISTENERLIST_H_
+
+////////////////////////////////////////////////////
+template <class T>
+class CWR_ListenerList
+{
+protected:
+	struct SEntry
+	{
+		T *pListener;
+		unsigned int nEvents;
+	};
+	typedef std::vector<SEntry> Entries;
+	Entries m_Entries;
+
+	unsigned int m_nEvents;		// Events anyone is subscribed to
+	int m_nDispatching;			// Dispatches in progress
+	bool m_bRemoved;			// Entries were removed during a dispatch
+	T *m_pRelay;				// Called in place of the listeners (see SetRelay)
+
+public:
+	////////////////////////////////////////////////////
+	// Dispatch
+	//
+	// Purpose: Walks the listeners subscribed to an event
+	//	Ex. for (Listeners::Dispatch itI(m_Listeners, EVENT); itI; ++itI)
+	//			(*itI)->OnEvent(...);
+	//
+	// Note: Listeners added during the walk are not called
+	//	until the next one. Listeners removed during the walk
+	//	are skipped and dropped once all walks are done.
+	//	If a relay is set, only the relay is walked unless
+	//	bRelay is FALSE.
+	////////////////////////////////////////////////////
+	class Dispatch
+	{
+		CWR_ListenerList &m_List;
+		unsigned int m_nEvent;
+		size_t m_nIndex, m_nCount;
+		T *m_pRelay;
+
+	public:
+		Dispatch(CWR_ListenerList &list, unsigned int nEvent, bool bRelay = true) : m_List(list),m_nEvent(nEvent),m_nIndex(0),m_pRelay(NULL)
+		{
+			// Nothing to walk if no one wants it
+			const bool bWanted = (0 != (m_List.m_nEvents&m_nEvent));
+			if (true == bRelay && NULL != m_List.m_pRelay)
+			{
+				// The entries belong to the thread the relay replays on, so leave them be
+				m_pRelay = m_List.m_pRelay;
+				m_nCount = (true == bWanted ? 1 : 0);
+				return;
+			}
+			m_nCount = (true == bWanted ? m_List.m_Entries.size() : 0);
+			++m_List.m_nDispatching;
+			Skip();
+		}
+		~Dispatch(void)
+		{
+			if (NULL != m_pRelay) return;
+			if (0 == --m_List.m_nDispatching && true == m_List.m_bRemoved)
+				m_List.Compact();
+		}
+
+		operator bool(void) const { return (m_nIndex < m_nCount); }
+		Dispatch& operator ++(void) { ++m_nIndex; if (NULL == m_pRelay) Skip(); return *this; }
+		T* operator *(void) const { return (NULL != m_pRelay ? m_pRelay : m_List.m_Entries[m_nIndex].pListener); }
+
+	private:
+		Dispatch(Dispatch const&);
+		Dispatch& operator =(Dispatch const&);
+
+		void Skip(void)
+		{
+			while (m_nIndex < m_nCount && 0 == (m_List.m_Entries[m_nIndex].nEvents&m_nEvent))
+				++m_nIndex;
+		}
+	};
+	friend class Dispatch;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_ListenerList(void) : m_nEvents(0),m_nDispatching(0),m_bRemoved(false),m_pRelay(NULL) {}
+
+	////////////////////////////////////////////////////
+	// Add
+	//
+	// Purpose: Add a listener, or change the events it
+	//	is subscribed to if it was already added
+	//
+	// In:	pListener - Listener to add
+	//		nEvents - Mask of events to subscribe to
+	////////////////////////////////////////////////////
+	void Add(T *pListener, unsigned int nEvents)
+	{
+		if (NULL == pListener) return;
+		for (size_t i = 0; i < m_Entries.size(); i++)
+		{
+			if (m_Entries[i].pListener == pListener)
+			{
+				m_Entries[i].nEvents = nEvents;
+				UpdateEvents();
+				return;
+			}
+		}
+
+		SEntry entry;
+		entry.pListener = pListener;
+		entry.nEvents = nEvents;
+		m_Entries.push_back(entry);
+		m_nEvents |= nEvents;
+	}
+
+	////////////////////////////////////////////////////
+	// Remove
+	//
+	// Purpose: Remove a listener
+	//
+	// In:	pListener - Listener to remove
+	////////////////////////////////////////////////////
+	void Remove(T *pListener)
+	{
+		if (NULL == pListener) return;
+		for (size_t i = 0; i < m_Entries.size(); i++)
+		{
+			if (m_Entries[i].pListener == pListener)
+			{
+				// Can't move entries while they are being walked
+				if (0 < m_nDispatching)
+				{
+					m_Entries[i].pListener = NULL;
+					m_Entries[i].nEvents = 0;
+					m_bRemoved = true;
+				}
+				else
+					m_Entries.erase(m_Entries.begin()+i);
+				UpdateEvents();
+				return;
+			}
+		}
+	}
+
+	////////////////////////////////////////////////////
+	// Clear
+	//
+	// Purpose: Remove all listeners
+	////////////////////////////////////////////////////
+	void Clear(void)
+	{
+		if (0 < m_nDispatching)
+		{
+			for (size_t i = 0; i < m_Entries.size(); i++)
+			{
+				m_Entries[i].pListener = NULL;
+				m_Entries[i].nEvents = 0;
+			}
+			m_bRemoved = true;
+		}
+		else
+			m_Entries.clear();
+		m_nEvents = 0;
+	}
+
+	////////////////////////////////////////////////////
+	// IsListening
+	//
+	// Purpose: Returns TRUE if any listener is subscribed
+	//	to one of the events
+	//
+	// In:	nEvents - Mask of events
+	////////////////////////////////////////////////////
+	bool IsListening(unsigned int nEvents) const
+	{
+		return (0 != (m_nEvents&nEvents));
+	}
+
+	////////////////////////////////////////////////////
+	// SetRelay
+	//
+	// Purpose: Hand every dispatch to a relay instead of
+	//	the listeners
+	//
+	// In:	pRelay - Relay to call, or NULL to call the
+	//			listeners directly again
+	//
+	// Note: The relay is only called for events someone is
+	//	subscribed to, and passes them on later by
+	//	dispatching with bRelay set to FALSE (see
+	//	CWR_InputRelay)
+	////////////////////////////////////////////////////
+	void SetRelay(T *pRelay)
+	{
+		m_pRelay = pRelay;
+	}
+
+protected:
+	////////////////////////////////////////////////////
+	// UpdateEvents
+	//
+	// Purpose: Rebuild the mask of subscribed events
+	////////////////////////////////////////////////////
+	void UpdateEvents(void)
+	{
+		m_nEvents = 0;
+		for (size_t i = 0; i < m_Entries.size(); i++)
+			m_nEvents |= m_Entries[i].nEvents;
+	}
+
+	////////////////////////////////////////////////////
+	// Compact
+	//
+	// Purpose: Drop the entries removed during a dispatch
+	////////////////////////////////////////////////////
+	void Compact(void)
+	{
+		size_t nNext = 0;
+		for (size_t i = 0; i < m_Entries.size(); i++)
+			if (NULL != m_Entries[i].pListener)
+				m_Entries[nNext++] = m_Entries[i];
+		m_Entries.resize(nNext);
+		m_bRemoved = false;
+	}
+};
+
+#endif //_WR_CLISTENERLIST_H_
\ No newline at end of file
@@ -0,0 +1,263 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CMotionHistory.cpp
+//
+// Purpose: Helper shared by the motion helpers that
+//	keeps a timestamped history of updates and the
+//	statistics over it
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_CMotionHistory.h"
+
+////////////////////////////////////////////////////
+CWR_MotionHistory::CWR_MotionHistory(void)
+{
+	// Set up what each extreme queue tracks
+	for (int i = 0; i < EXTREME_MAX; i++)
+	{
+		m_Extremes[i].nChannel = (EXTREME_MAXGFORCE == i ? CHANNEL_GFORCE : (i % CHANNEL_ACCEL_MAX));
+		m_Extremes[i].bMax = (i >= EXTREME_MAXX);
+	}
+	m_nWindow = WR_MOTION_STATSWINDOW;
+	Clear();
+}
+
+////////////////////////////////////////////////////
+CWR_MotionHistory::~CWR_MotionHistory(void)
+{
+
+}
+
+////////////////////////////////////////////////////
+void CWR_MotionHistory::Clear(void)
+{
+	m_nUpdates = 0;
+	for (int i = 0; i < CHANNEL_MAX; i++)
+		m_dWindowSum[i] = 0.0;
+	for (int i = 0; i < CHANNEL_ACCEL_MAX; i++)
+		m_dWindowSumSq[i] = 0.0;
+	for (int i = 0; i < EXTREME_MAX; i++)
+	{
+		m_Extremes[i].nHead = 0;
+		m_Extremes[i].nCount = 0;
+	}
+	ResetMotion();
+}
+
+////////////////////////////////////////////////////
+void CWR_MotionHistory::Push(SMotionElement const& element, float fRecvTime)
+{
+	const int nIndex = m_nUpdates % WR_MOTION_HISTORYSIZE;
+
+	// Keep time moving forward, even for reports received together
+	float fTime = fRecvTime, fDT = WR_MOTION_REPORTPERIOD;
+	if (m_nUpdates > 0)
+	{
+		const float fPrev = m_fTime[(m_nUpdates-1) % WR_MOTION_HISTORYSIZE];
+		fTime = MAX(fRecvTime, fPrev + WR_MOTION_MINPERIOD);
+		fDT = fTime - fPrev;
+	}
+
+	// Take the update leaving the window out of the sums before it is overwritten
+	if (m_nUpdates >= m_nWindow)
+	{
+		const int nLeaving = (m_nUpdates - m_nWindow) % WR_MOTION_HISTORYSIZE;
+		for (int i = 0; i < CHANNEL_MAX; i++)
+			m_dWindowSum[i] -= m_fValues[i][nLeaving];
+		for (int i = 0; i < CHANNEL_ACCEL_MAX; i++)
+			m_dWindowSumSq[i] -= m_fValues[i][nLeaving]*m_fValues[i][nLeaving];
+	}
+
+	// Store it
+	m_fTime[nIndex] = fTime;
+	m_fValues[CHANNEL_X][nIndex] = element.vAccel.x;
+	m_fValues[CHANNEL_Y][nIndex] = element.vAccel.y;
+	m_fValues[CHANNEL_Z][nIndex] = element.vAccel.z;
+	m_fValues[CHANNEL_GFORCE][nIndex] = element.fGForce;
+	m_fValues[CHANNEL_PITCHSIN][nIndex] = sinf(element.fPitch);
+	m_fValues[CHANNEL_PITCHCOS][nIndex] = cosf(element.fPitch);
+	m_fValues[CHANNEL_ROLLSIN][nIndex] = sinf(element.fRoll);
+	m_fValues[CHANNEL_ROLLCOS][nIndex] = cosf(element.fRoll);
+	m_fValues[CHANNEL_VX][nIndex] = (element.vAccel.x - element.vDir.x) * fDT;
+	m_fValues[CHANNEL_VY][nIndex] = (element.vAccel.y - element.vDir.y) * fDT;
+	m_fValues[CHANNEL_VZ][nIndex] = (element.vAccel.z - element.vDir.z) * fDT;
+	m_nUpdates++;
+
+	// Update window
+	for (int i = 0; i < CHANNEL_MAX; i++)
+		m_dWindowSum[i] += m_fValues[i][nIndex];
+	for (int i = 0; i < CHANNEL_ACCEL_MAX; i++)
+		m_dWindowSumSq[i] += m_fValues[i][nIndex]*m_fValues[i][nIndex];
+	for (int i = 0; i < EXTREME_MAX; i++)
+		PushExtreme(m_Extremes[i], m_nUpdates-1);
+
+	// Update motion
+	if (0 == m_nMotionCount)
+	{
+		m_fMotionStart = fTime;
+		m_vMotionFirst = element.vAccel;
+		m_vMotionMin = element.vAccel;
+		m_vMotionMax = element.vAccel;
+		m_fMotionMaxGForce = element.fGForce;
+	}
+	else
+	{
+		m_vMotionMin.Set(MIN(m_vMotionMin.x, element.vAccel.x), MIN(m_vMotionMin.y, element.vAccel.y), MIN(m_vMotionMin.z, element.vAccel.z));
+		m_vMotionMax.Set(MAX(m_vMotionMax.x, element.vAccel.x), MAX(m_vMotionMax.y, element.vAccel.y), MAX(m_vMotionMax.z, element.vAccel.z));
+		m_fMotionMaxGForce = MAX(m_fMotionMaxGForce, element.fGForce);
+	}
+	for (int i = 0; i < CHANNEL_MAX; i++)
+		m_dMotionSum[i] += m_fValues[i][nIndex];
+	for (int i = 0; i < CHANNEL_ACCEL_MAX; i++)
+		m_dMotionSumSq[i] += m_fValues[i][nIndex]*m_fValues[i][nIndex];
+	m_nMotionCount++;
+}
+
+////////////////////////////////////////////////////
+void CWR_MotionHistory::ResetMotion(void)
+{
+	m_nMotionCount = 0;
+	m_fMotionStart = 0.0f;
+	m_fMotionMaxGForce = 0.0f;
+	for (int i = 0; i < CHANNEL_MAX; i++)
+		m_dMotionSum[i] = 0.0;
+	for (int i = 0; i < CHANNEL_ACCEL_MAX; i++)
+		m_dMotionSumSq[i] = 0.0;
+}
+
+////////////////////////////////////////////////////
+void CWR_MotionHistory::SetWindow(int nSize)
+{
+	m_nWindow = CLAMP(nSize, 2, WR_MOTION_HISTORYSIZE);
+
+	// Rebuild the window from the history
+	for (int i = 0; i < CHANNEL_MAX; i++)
+		m_dWindowSum[i] = 0.0;
+	for (int i = 0; i < CHANNEL_ACCEL_MAX; i++)
+		m_dWindowSumSq[i] = 0.0;
+	for (int i = 0; i < EXTREME_MAX; i++)
+	{
+		m_Extremes[i].nHead = 0;
+		m_Extremes[i].nCount = 0;
+	}
+	for (int nUpdate = MAX(0, m_nUpdates - m_nWindow); nUpdate < m_nUpdates; nUpdate++)
+	{
+		const int nIndex = nUpdate % WR_MOTION_HISTORYSIZE;
+		for (int i = 0; i < CHANNEL_MAX; i++)
+			m_dWindowSum[i] += m_fValues[i][nIndex];
+		for (int i = 0; i < CHANNEL_ACCEL_MAX; i++)
+			m_dWindowSumSq[i] += m_fValues[i][nIndex]*m_fValues[i][nIndex];
+		for (int i = 0; i < EXTREME_MAX; i++)
+			PushExtreme(m_Extremes[i], nUpdate);
+	}
+}
+
+////////////////////////////////////////////////////
+int CWR_MotionHistory::GetWindow(void) const
+{
+	return m_nWindow;
+}
+
+////////////////////////////////////////////////////
+void CWR_MotionHistory::GetWindowStats(SMotionStats &stats) const
+{
+	stats = SMotionStats();
+	const int nCount = MIN(m_nUpdates, m_nWindow);
+	if (0 == nCount) return;
+	FillStats(nCount, m_dWindowSum, m_dWindowSumSq, stats);
+
+	// Extremes
+	stats.vMin.Set(GetExtreme(m_Extremes[EXTREME_MINX]), GetExtreme(m_Extremes[EXTREME_MINY]), GetExtreme(m_Extremes[EXTREME_MINZ]));
+	stats.vMax.Set(GetExtreme(m_Extremes[EXTREME_MAXX]), GetExtreme(m_Extremes[EXTREME_MAXY]), GetExtreme(m_Extremes[EXTREME_MAXZ]));
+	stats.fGForceMax = GetExtreme(m_Extremes[EXTREME_MAXGFORCE]);
+
+	// Change from the oldest to the newest update
+	const int nNewest = (m_nUpdates-1) % WR_MOTION_HISTORYSIZE;
+	const int nOldest = (m_nUpdates-nCount) % WR_MOTION_HISTORYSIZE;
+	stats.fDuration = m_fTime[nNewest] - m_fTime[nOldest];
+	if (stats.fDuration > 0.0f)
+	{
+		const float fInvDuration = 1.0f / stats.fDuration;
+		stats.vJerk.Set((m_fValues[CHANNEL_X][nNewest] - m_fValues[CHANNEL_X][nOldest]) * fInvDuration,
+			(m_fValues[CHANNEL_Y][nNewest] - m_fValues[CHANNEL_Y][nOldest]) * fInvDuration,
+			(m_fValues[CHANNEL_Z][nNewest] - m_fValues[CHANNEL_Z][nOldest]) * fInvDuration);
+	}
+}
+
+////////////////////////////////////////////////////
+void CWR_MotionHistory::GetMotionStats(SMotionStats &stats) const
+{
+	stats = SMotionStats();
+	if (0 == m_nMotionCount) return;
+	FillStats(m_nMotionCount, m_dMotionSum, m_dMotionSumSq, stats);
+
+	// Extremes
+	stats.vMin = m_vMotionMin;
+	stats.vMax = m_vMotionMax;
+	stats.fGForceMax = m_fMotionMaxGForce;
+
+	// Change from the start of the motion to the newest update
+	const int nNewest = (m_nUpdates-1) % WR_MOTION_HISTORYSIZE;
+	stats.fDuration = m_fTime[nNewest] - m_fMotionStart;
+	if (stats.fDuration > 0.0f)
+	{
+		const float fInvDuration = 1.0f / stats.fDuration;
+		stats.vJerk.Set((m_fValues[CHANNEL_X][nNewest] - m_vMotionFirst.x) * fInvDuration,
+			(m_fValues[CHANNEL_Y][nNewest] - m_vMotionFirst.y) * fInvDuration,
+			(m_fValues[CHANNEL_Z][nNewest] - m_vMotionFirst.z) * fInvDuration);
+	}
+}
+
+////////////////////////////////////////////////////
+void CWR_MotionHistory::PushExtreme(SExtremeQueue &queue, int nUpdate)
+{
+	// Drop the ones that left the window
+	while (queue.nCount > 0 && queue.nUpdates[queue.nHead] <= nUpdate - m_nWindow)
+	{
+		queue.nHead = (queue.nHead + 1) % WR_MOTION_HISTORYSIZE;
+		queue.nCount--;
+	}
+
+	// Drop the ones that can no longer be the extreme
+	float const* pValues = m_fValues[queue.nChannel];
+	const float fValue = pValues[nUpdate % WR_MOTION_HISTORYSIZE];
+	while (queue.nCount > 0)
+	{
+		const float fBack = pValues[queue.nUpdates[(queue.nHead + queue.nCount - 1) % WR_MOTION_HISTORYSIZE] % WR_MOTION_HISTORYSIZE];
+		if (true == queue.bMax ? (fBack > fValue) : (fBack < fValue)) break;
+		queue.nCount--;
+	}
+
+	// Add it
+	queue.nUpdates[(queue.nHead + queue.nCount) % WR_MOTION_HISTORYSIZE] = nUpdate;
+	queue.nCount++;
+}
+
+////////////////////////////////////////////////////
+float CWR_MotionHistory::GetExtreme(SExtremeQueue const& queue) const
+{
+	if (0 == queue.nCount) return 0.0f;
+	return m_fValues[queue.nChannel][queue.nUpdates[queue.nHead] % WR_MOTION_HISTORYSIZE];
+}
+
+////////////////////////////////////////////////////
+void CWR_MotionHistory::FillStats(int nCount, double const* dSum, double const* dSumSq, SMotionStats &stats) const
+{
+	const double dInvCount = 1.0 / (double)nCount;
+	stats.nCount = nCount;
+	stats.vMean.Set((float)(dSum[CHANNEL_X] * dInvCount), (float)(dSum[CHANNEL_Y] * dInvCount), (float)(dSum[CHANNEL_Z] * dInvCount));
+	stats.vVariance.Set(MAX(0.0f, (float)(dSumSq[CHANNEL_X] * dInvCount) - stats.vMean.x*stats.vMean.x),
+		MAX(0.0f, (float)(dSumSq[CHANNEL_Y] * dInvCount) - stats.vMean.y*stats.vMean.y),
+		MAX(0.0f, (float)(dSumSq[CHANNEL_Z] * dInvCount) - stats.vMean.z*stats.vMean.z));
+	stats.fGForceMean = (float)(dSum[CHANNEL_GFORCE] * dInvCount);
+	stats.fPitchMean = atan2f((float)dSum[CHANNEL_PITCHSIN], (float)dSum[CHANNEL_PITCHCOS]);
+	stats.fRollMean = atan2f((float)dSum[CHANNEL_ROLLSIN], (float)dSum[CHANNEL_ROLLCOS]);
+	stats.vVelocity.Set((float)dSum[CHANNEL_VX], (float)dSum[CHANNEL_VY], (float)dSum[CHANNEL_VZ]);
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CMotionHistory.h
+//
+// Purpose: Helper shared by the motion helpers that
+//	keeps a timestamped history of updates and the
+//	statistics over it
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CMOTIONHISTORY_H_
+#define _WR_CMOTIONHISTORY_H_
+
+#include "Interfaces\WR_IWiiMotion.h"
+
+class CWR_MotionHistory
+{
+protected:
+	// Values kept per update
+	enum
+	{
+		CHANNEL_X = 0,
+		CHANNEL_Y,
+		CHANNEL_Z,
+		CHANNEL_GFORCE,
+		CHANNEL_PITCHSIN,	// Angles are kept as sine and cosine so
+		CHANNEL_PITCHCOS,	//	their means don't break at the wrap
+		CHANNEL_ROLLSIN,
+		CHANNEL_ROLLCOS,
+		CHANNEL_VX,			// Velocity gained over the update
+		CHANNEL_VY,
+		CHANNEL_VZ,
+		CHANNEL_MAX,
+
+		CHANNEL_ACCEL_MAX = CHANNEL_Z+1,
+	};
+
+	// Queue of update numbers whose values only get more
+	//	extreme towards the front, so the front is always the
+	//	min (or max) of the window
+	struct SExtremeQueue
+	{
+		int nUpdates[WR_MOTION_HISTORYSIZE];
+		int nHead, nCount;
+		int nChannel;
+		bool bMax;
+	};
+	enum
+	{
+		EXTREME_MINX = 0,
+		EXTREME_MINY,
+		EXTREME_MINZ,
+		EXTREME_MAXX,
+		EXTREME_MAXY,
+		EXTREME_MAXZ,
+		EXTREME_MAXGFORCE,
+		EXTREME_MAX,
+	};
+
+	// History, indexed by update number modulo the size
+	float m_fTime[WR_MOTION_HISTORYSIZE];
+	float m_fValues[CHANNEL_MAX][WR_MOTION_HISTORYSIZE];
+	int m_nUpdates;
+
+	// Sliding window
+	int m_nWindow;
+	double m_dWindowSum[CHANNEL_MAX];
+	double m_dWindowSumSq[CHANNEL_ACCEL_MAX];
+	SExtremeQueue m_Extremes[EXTREME_MAX];
+
+	// Current motion
+	int m_nMotionCount;
+	float m_fMotionStart;
+	SMotionVec3F m_vMotionFirst;
+	double m_dMotionSum[CHANNEL_MAX];
+	double m_dMotionSumSq[CHANNEL_ACCEL_MAX];
+	SMotionVec3F m_vMotionMin, m_vMotionMax;
+	float m_fMotionMaxGForce;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_MotionHistory(void);
+private:
+	CWR_MotionHistory(CWR_MotionHistory const&) {}
+	CWR_MotionHistory& operator =(CWR_MotionHistory const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWR_MotionHistory(void);
+
+	////////////////////////////////////////////////////
+	// Clear
+	//
+	// Purpose: Forget all updates
+	////////////////////////////////////////////////////
+	virtual void Clear(void);
+
+	////////////////////////////////////////////////////
+	// Push
+	//
+	// Purpose: Add an update to the history
+	//
+	// In:	element - Motion element
+	//		fRecvTime - Precise time the report was received
+	//			(see GetPreciseTime)
+	////////////////////////////////////////////////////
+	virtual void Push(SMotionElement const& element, float fRecvTime);
+
+	////////////////////////////////////////////////////
+	// ResetMotion
+	//
+	// Purpose: Start the motion statistics over from
+	//	the next update
+	////////////////////////////////////////////////////
+	virtual void ResetMotion(void);
+
+	////////////////////////////////////////////////////
+	// SetWindow
+	//
+	// Purpose: Set the size of the sliding window
+	//
+	// In:	nSize - Size (in number of consecutive updates)
+	//
+	// Note: Size is clamped to [2, WR_MOTION_HISTORYSIZE]
+	////////////////////////////////////////////////////
+	virtual void SetWindow(int nSize);
+
+	////////////////////////////////////////////////////
+	// GetWindow
+	//
+	// Purpose: Get the size of the sliding window
+	////////////////////////////////////////////////////
+	virtual int GetWindow(void) const;
+
+	////////////////////////////////////////////////////
+	// GetWindowStats
+	//
+	// Purpose: Get statistics over the sliding window
+	//
+	// Out:	stats - Statistics
+	////////////////////////////////////////////////////
+	virtual void GetWindowStats(SMotionStats &stats) const;
+
+	////////////////////////////////////////////////////
+	// GetMotionStats
+	//
+	// Purpose: Get statistics since the last ResetMotion
+	//
+	// Out:	stats - Statistics
+	////////////////////////////////////////////////////
+	virtual void GetMotionStats(SMotionStats &stats) const;
+
+protected:
+	////////////////////////////////////////////////////
+	// PushExtreme
+	//
+	// Purpose: Add an update to an extreme queue and
+	//	drop the ones that left the window
+	//
+	// In:	queue - Queue to update
+	//		nUpdate - Update number to add
+	////////////////////////////////////////////////////
+	virtual void PushExtreme(SExtremeQueue &queue, int nUpdate);
+
+	////////////////////////////////////////////////////
+	// GetExtreme
+	//
+	// Purpose: Get the min (or max) value in the window
+	//
+	// In:	queue - Queue to read
+	////////////////////////////////////////////////////
+	virtual float GetExtreme(SExtremeQueue const& queue) const;
+
+	////////////////////////////////////////////////////
+	// FillStats
+	//
+	// Purpose: Fill in the values derived from sums
+	//
+	// In:	nCount - Updates summed
+	//		dSum - Per channel sums
+	//		dSumSq - Per acceleration axis sums of squares
+	//
+	// Out:	stats - Statistics
+	////////////////////////////////////////////////////
+	virtual void FillStats(int nCount, double const* dSum, double const* dSumSq, SMotionStats &stats) const;
+};
+
+#endif //_WR_CMOTIONHISTORY_H_
\ No newline at end of file
@@ -0,0 +1,124 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CStillDetector.cpp
+//
+// Purpose: Helper shared by the motion helpers that
+//	decides when the controller is moving or still
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_CStillDetector.h"
+
+////////////////////////////////////////////////////
+CWR_StillDetector::CWR_StillDetector(void)
+{
+	Reset();
+}
+
+////////////////////////////////////////////////////
+CWR_StillDetector::~CWR_StillDetector(void)
+{
+
+}
+
+////////////////////////////////////////////////////
+void CWR_StillDetector::Reset(bool bKeepMoving)
+{
+	m_nWindowPos = 0;
+	m_nWindowCount = 0;
+	m_bMoving = (true == bKeepMoving && true == m_bMoving);
+	m_nStillCount = 0;
+	m_fNoise = 0.0f;
+}
+
+////////////////////////////////////////////////////
+bool CWR_StillDetector::Update(SMotionVec3F const& vAccel)
+{
+	m_Window[m_nWindowPos] = vAccel;
+	m_nWindowPos = (m_nWindowPos+1) % WR_MOTION_STILLWINDOW;
+
+	// Keep the last state until there is a full window to look at
+	if (m_nWindowCount < WR_MOTION_STILLWINDOW && ++m_nWindowCount < WR_MOTION_STILLWINDOW)
+		return (false == m_bMoving);
+
+	const float fVariance = GetVariance();
+	const float fMove = GetMoveThreshold();
+	if (false == m_bMoving)
+	{
+		if (fVariance < fMove)
+		{
+			// Learn the noise level from still updates
+			m_fNoise = MIN(m_fNoise + (fVariance-m_fNoise)*WR_MOTION_NOISEADAPT, WR_MOTION_MAXNOISE);
+			return true;
+		}
+
+		m_bMoving = true;
+		m_nStillCount = 0;
+		return false;
+	}
+
+	// Must stay quiet for a few updates in a row, so a single
+	//	noisy update does not end it
+	if (fVariance < fMove*WR_MOTION_STILLRATIO)
+	{
+		if (++m_nStillCount >= WR_MOTION_STILLCOUNT)
+		{
+			m_bMoving = false;
+			return true;
+		}
+	}
+	else
+		m_nStillCount = 0;
+
+	return false;
+}
+
+////////////////////////////////////////////////////
+float CWR_StillDetector::GetVariance(void) const
+{
+	float fX = 0.0f, fY = 0.0f, fZ = 0.0f;
+	for (int i = 0; i < WR_MOTION_STILLWINDOW; i++)
+	{
+		fX += m_Window[i].x;
+		fY += m_Window[i].y;
+		fZ += m_Window[i].z;
+	}
+	const float fInvCount = 1.0f / (float)WR_MOTION_STILLWINDOW;
+	fX *= fInvCount;
+	fY *= fInvCount;
+	fZ *= fInvCount;
+
+	float fVariance = 0.0f;
+	for (int i = 0; i < WR_MOTION_STILLWINDOW; i++)
+	{
+		const float fDX = m_Window[i].x-fX;
+		const float fDY = m_Window[i].y-fY;
+		const float fDZ = m_Window[i].z-fZ;
+		fVariance += (fDX*fDX)+(fDY*fDY)+(fDZ*fDZ);
+	}
+	return fVariance * fInvCount;
+}
+
+////////////////////////////////////////////////////
+bool CWR_StillDetector::IsMoving(void) const
+{
+	return m_bMoving;
+}
+
+////////////////////////////////////////////////////
+float CWR_StillDetector::GetNoise(void) const
+{
+	return m_fNoise;
+}
+
+////////////////////////////////////////////////////
+float CWR_StillDetector::GetMoveThreshold(void) const
+{
+	return MAX(m_fNoise*WR_MOTION_NOISERATIO, WR_MOTION_GESTUREEPSILON*WR_MOTION_GESTUREEPSILON);
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_CStillDetector.h
+//
+// Purpose: Helper shared by the motion helpers that
+//	decides when the controller is moving or still
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_CSTILLDETECTOR_H_
+#define _WR_CSTILLDETECTOR_H_
+
+#include "Interfaces\WR_IWiiMotion.h"
+
+class CWR_StillDetector
+{
+protected:
+	// Last updates, oldest is overwritten first
+	SMotionVec3F m_Window[WR_MOTION_STILLWINDOW];
+	int m_nWindowPos;
+	int m_nWindowCount;
+
+	bool m_bMoving;
+	int m_nStillCount;
+
+	// Variance of the acceleration while still
+	float m_fNoise;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CWR_StillDetector(void);
+private:
+	CWR_StillDetector(CWR_StillDetector const&) {}
+	CWR_StillDetector& operator =(CWR_StillDetector const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CWR_StillDetector(void);
+
+	////////////////////////////////////////////////////
+	// Reset
+	//
+	// Purpose: Forget the last updates and noise level
+	//
+	// In:	bKeepMoving - TRUE to stay moving if it was
+	//			(when only the units have changed)
+	//
+	// Note: Reports the state from before the reset until
+	//	the window has filled again
+	////////////////////////////////////////////////////
+	virtual void Reset(bool bKeepMoving = false);
+
+	////////////////////////////////////////////////////
+	// Update
+	//
+	// Purpose: Feed the next acceleration update
+	//
+	// In:	vAccel - Acceleration vector
+	//
+	// Returns TRUE if the controller is still
+	//
+	// Note: Once moving, it takes WR_MOTION_STILLCOUNT
+	//	quiet updates in a row to become still again
+	////////////////////////////////////////////////////
+	virtual bool Update(SMotionVec3F const& vAccel);
+
+	////////////////////////////////////////////////////
+	// IsMoving
+	//
+	// Purpose: Returns TRUE if the controller is moving
+	////////////////////////////////////////////////////
+	virtual bool IsMoving(void) const;
+
+	////////////////////////////////////////////////////
+	// GetNoise
+	//
+	// Purpose: Returns the learned noise level, as the
+	//	variance of the acceleration over the window
+	////////////////////////////////////////////////////
+	virtual float GetNoise(void) const;
+
+	////////////////////////////////////////////////////
+	// GetMoveThreshold
+	//
+	// Purpose: Returns the variance of the acceleration
+	//	needed to start moving
+	////////////////////////////////////////////////////
+	virtual float GetMoveThreshold(void) const;
+
+protected:
+	////////////////////////////////////////////////////
+	// GetVariance
+	//
+	// Purpose: Returns the variance of the acceleration
+	//	over the window, summed over the axes
+	////////////////////////////////////////////////////
+	virtual float GetVariance(void) const;
+};
+
+#endif //_WR_CSTILLDETECTOR_H_
\ No newline at end of file
@@ -15,6 +15,8 @@
 #define _WR_CWIIBUTTONS_H_
 
 #include "Interfaces\WR_IWiiButtons.h"
+#include "WR_CActionTable.h"
+#include "WR_CComboEngine.h"
 
 class CWR_WiiButtons : public IWR_WiiButtons
 {
@@ -25,16 +27,15 @@ protected:
 	bool m_bWasUpdated;
 
 	// Button status
-	unsigned int m_nButtons;
-	int m_pButtonStatus[WR_WIIREMOTE_BUTTONS_MAX];
-	float m_pButtonBufferedTime[WR_WIIREMOTE_BUTTONS_MAX];
+	CWR_ButtonBits m_Buttons;
+	unsigned int m_nChangedButtons; // Since actions were last updated
 
 	// Actions
-	ActionID m_nActionIDSeed;
-	ActionMap m_ActionMap;
+	CWR_ActionTable m_Actions;
+	CWR_ComboEngine m_Combos;
 
 	// Listeners
-	typedef std::list<IWR_WiiButtonsListener*> Listeners;
+	typedef CWR_ListenerList<IWR_WiiButtonsListener> Listeners;
 	Listeners m_Listeners;
 
 public:
@@ -94,6 +95,26 @@ protected:
 	////////////////////////////////////////////////////
 	virtual void OnPostUpdate(void);
 
+	////////////////////////////////////////////////////
+	// SetRelay
+	//
+	// Purpose: Hand listener calls to a relay instead
+	//
+	// In:	pRelay - Relay to use, or NULL to call the
+	//			listeners directly
+	////////////////////////////////////////////////////
+	virtual void SetRelay(CWR_InputRelay *pRelay);
+
+	////////////////////////////////////////////////////
+	// SignalButtons
+	//
+	// Purpose: Signal the listeners of buttons whose
+	//	status changed
+	//
+	// In:	nChanged - Buttons whose status changed
+	////////////////////////////////////////////////////
+	virtual void SignalButtons(unsigned int nChanged);
+
 public:
 	////////////////////////////////////////////////////
 	// AddListener
@@ -101,8 +122,11 @@ public:
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIBUTTONS_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiButtonsListener *pListener);
+	virtual void AddListener(IWR_WiiButtonsListener *pListener, unsigned int nEvents = WR_BUTTONEVENT_DEFAULT);
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -169,6 +193,19 @@ public:
 	////////////////////////////////////////////////////
 	virtual int RegisterAction(char const* szName, unsigned int nButtonMask);
 
+	////////////////////////////////////////////////////
+	// RegisterCombo
+	//
+	// Purpose: Register a combo action
+	//
+	// In:	szName - Name of the combo
+	//		combo - Combo definition (see WR_WIIREMOTE_COMBOS)
+	//			using WR_WIIREMOTE_BUTTONS
+	//
+	// Returns ID of combo or 0 on error
+	////////////////////////////////////////////////////
+	virtual int RegisterCombo(char const* szName, SWR_WiiButton_Combo const& combo);
+
 	////////////////////////////////////////////////////
 	// GetActionStatus
 	//
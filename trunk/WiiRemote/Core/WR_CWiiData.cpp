@@ -60,12 +60,12 @@ void CWR_WiiData::OnDataRead(DataBuffer const& buffer, int nOffset, float fCurrT
 	if (WR_DATAERROR_SUCCESS != nError)
 	{
 		// An error occured
-		for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+		for (Listeners::Dispatch itI(m_Listeners, WR_DATAEVENT_ERROR); itI; ++itI)
 			(*itI)->OnDataError(m_pRemote, this, nAddr, nError);
 	}
 
 	// Send back the data report
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+	for (Listeners::Dispatch itI(m_Listeners, WR_DATAEVENT_READ); itI; ++itI)
 		(*itI)->OnDataRead(m_pRemote, this, nAddr, nSize, (LPWiiIOData)&buffer[nOffset+3]);
 
 	// Pop and call callback routine
@@ -81,6 +81,13 @@ void CWR_WiiData::OnDataRead(DataBuffer const& buffer, int nOffset, float fCurrT
 	}
 }
 
+////////////////////////////////////////////////////
+void CWR_WiiData::SetRelay(CWR_InputRelay *pRelay)
+{
+	m_Listeners.SetRelay(pRelay);
+	if (NULL != pRelay) pRelay->Attach(&m_Listeners);
+}
+
 ////////////////////////////////////////////////////
 void CWR_WiiData::OnPostUpdate(void)
 {
@@ -88,25 +95,15 @@ void CWR_WiiData::OnPostUpdate(void)
 }
 
 ////////////////////////////////////////////////////
-void CWR_WiiData::AddListener(IWR_WiiDataListener *pListener)
+void CWR_WiiData::AddListener(IWR_WiiDataListener *pListener, unsigned int nEvents)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-			return;
-	m_Listeners.push_back(pListener);
+	m_Listeners.Add(pListener, nEvents);
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiData::RemoveListener(IWR_WiiDataListener *pListener)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-		{
-			m_Listeners.erase(itI);
-			return;
-		}
+	m_Listeners.Remove(pListener);
 }
 
 ////////////////////////////////////////////////////
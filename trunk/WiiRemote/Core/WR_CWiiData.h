@@ -28,7 +28,7 @@ protected:
 	WiiIOCallBackMap m_CallBackmap;
 
 	// Listeners
-	typedef std::list<IWR_WiiDataListener*> Listeners;
+	typedef CWR_ListenerList<IWR_WiiDataListener> Listeners;
 	Listeners m_Listeners;
 
 public:
@@ -87,6 +87,16 @@ protected:
 	////////////////////////////////////////////////////
 	virtual void OnPostUpdate(void);
 
+	////////////////////////////////////////////////////
+	// SetRelay
+	//
+	// Purpose: Hand listener calls to a relay instead
+	//
+	// In:	pRelay - Relay to use, or NULL to call the
+	//			listeners directly
+	////////////////////////////////////////////////////
+	virtual void SetRelay(CWR_InputRelay *pRelay);
+
 public:
 	////////////////////////////////////////////////////
 	// AddListener
@@ -94,8 +104,11 @@ public:
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIDATA_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiDataListener *pListener);
+	virtual void AddListener(IWR_WiiDataListener *pListener, unsigned int nEvents = WR_DATAEVENT_DEFAULT);
 
 	////////////////////////////////////////////////////
 	// RemoveListener
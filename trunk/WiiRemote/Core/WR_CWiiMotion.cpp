@@ -26,6 +26,11 @@ CWR_WiiMotion::CWR_WiiMotion(void)
 	SetMotionSize(0);
 	m_nFlags = 0;
 	m_nCurrMotionLifetime = 0;
+	m_nOnsetWindow = WR_MOTION_ONSETWINDOW;
+	m_fOnsetEnergy = WR_MOTION_ONSETENERGY;
+	m_nOnsetCount = 0;
+	m_fOnsetEnergySum = 0.0f;
+	m_nBatchCount = 0;
 }
 
 ////////////////////////////////////////////////////
@@ -41,6 +46,9 @@ bool CWR_WiiMotion::Initialize(IWR_WiiRemote *pRemote)
 	if (NULL == m_pRemote) return false;
 
 	m_nFlags = 0;
+	m_History.Clear();
+	m_StillDetector.Reset();
+	m_nBatchCount = 0;
 
 	return true;
 }
@@ -54,6 +62,14 @@ void CWR_WiiMotion::Shutdown(void)
 ////////////////////////////////////////////////////
 void CWR_WiiMotion::Calibrate(void)
 {
+	// Use the cached calibration until the read verifies it
+	WiiIOData cached[WR_DATAREAD_REMOTE_CALIBRATION_SIZE];
+	if (true == g_pWR->pCalibrationCache->Find(m_pRemote->GetDevicePath(), WR_DATAREAD_REMOTE_CALIBRATION,
+		WR_DATAREAD_REMOTE_CALIBRATION_SIZE, cached))
+	{
+		ApplyCalibration(cached);
+	}
+
 	// Read calibration data
 	m_pRemote->GetDataHelper()->ReadData(WR_DATAREAD_REMOTE_CALIBRATION, WR_DATAREAD_REMOTE_CALIBRATION_SIZE,
 		OnCalibrateData, this);
@@ -71,21 +87,35 @@ void CWR_WiiMotion::OnCalibrateData(int nAddr, int nSize, LPWiiIOData pData, Wii
 	CWR_WiiMotion *pMotion = (CWR_WiiMotion*)pParam;
 	if (WR_DATAREAD_REMOTE_CALIBRATION != nAddr) return;
 
+	// Only apply it if the cached one was missing or stale
+	if (true == g_pWR->pCalibrationCache->Store(pMotion->m_pRemote->GetDevicePath(), WR_DATAREAD_REMOTE_CALIBRATION,
+		WR_DATAREAD_REMOTE_CALIBRATION_SIZE, pData) || false == pMotion->IsCalibrated())
+	{
+		pMotion->ApplyCalibration(pData);
+	}
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiMotion::ApplyCalibration(LPWiiIOData pData)
+{
 	// Extract calibration data
-	pMotion->m_vCalibration_ZeroPoint.x = *(pData+0);
-	pMotion->m_vCalibration_ZeroPoint.y = *(pData+1);
-	pMotion->m_vCalibration_ZeroPoint.z = *(pData+2);
-	pMotion->m_vCalibration_1G.x = *(pData+4);
-	pMotion->m_vCalibration_1G.y = *(pData+5);
-	pMotion->m_vCalibration_1G.z = *(pData+6);
+	m_vCalibration_ZeroPoint.x = *(pData+0);
+	m_vCalibration_ZeroPoint.y = *(pData+1);
+	m_vCalibration_ZeroPoint.z = *(pData+2);
+	m_vCalibration_1G.x = *(pData+4);
+	m_vCalibration_1G.y = *(pData+5);
+	m_vCalibration_1G.z = *(pData+6);
 
 	// Calculate ratio values
-	pMotion->m_vCalibration_Ratio.x = 1.0f / ((float)pMotion->m_vCalibration_1G.x - pMotion->m_vCalibration_ZeroPoint.x);
-	pMotion->m_vCalibration_Ratio.y = 1.0f / ((float)pMotion->m_vCalibration_1G.y - pMotion->m_vCalibration_ZeroPoint.y);
-	pMotion->m_vCalibration_Ratio.z = 1.0f / ((float)pMotion->m_vCalibration_1G.z - pMotion->m_vCalibration_ZeroPoint.z);
+	m_vCalibration_Ratio.x = 1.0f / ((float)m_vCalibration_1G.x - m_vCalibration_ZeroPoint.x);
+	m_vCalibration_Ratio.y = 1.0f / ((float)m_vCalibration_1G.y - m_vCalibration_ZeroPoint.y);
+	m_vCalibration_Ratio.z = 1.0f / ((float)m_vCalibration_1G.z - m_vCalibration_ZeroPoint.z);
 
 	// Set calibrated bit
-	pMotion->m_nFlags = SET_BITS(WMF_ISCALIBRATED,pMotion->m_nFlags);
+	m_nFlags = SET_BITS(WMF_ISCALIBRATED,m_nFlags);
+
+	// Noise level was learned in the old units, a motion going on carries on
+	m_StillDetector.Reset(true);
 }
 
 ////////////////////////////////////////////////////
@@ -129,78 +159,159 @@ void CWR_WiiMotion::OnMotionUpdate(DataBuffer const& buffer, int nOffset, float
 	element.fPitch = m_fPitch;
 	element.fRoll = m_fRoll;
 	element.nLifetime = ++m_nCurrMotionLifetime;
+	const float fRecvTime = (buffer.fRecvTime > 0.0f ? buffer.fRecvTime : g_pWR->pTimer->GetPreciseTime());
+	m_History.Push(element, fRecvTime);
+
+	// Publish the sample
+	SJournalEvent event;
+	event.nType = WR_JOURNAL_MOTION;
+	event.nSource = WR_JOURNAL_REMOTE;
+	event.fTime = fRecvTime;
+	event.data.motion.x = m_vAccel.x;
+	event.data.motion.y = m_vAccel.y;
+	event.data.motion.z = m_vAccel.z;
+	event.data.motion.fPitch = m_fPitch;
+	event.data.motion.fRoll = m_fRoll;
+	m_pRemote->m_Journal.Publish(event);
+
+	// Hold on to it for the batch listeners
+	if (true == m_Listeners.IsListening(WR_MOTIONEVENT_BATCH))
+	{
+		if (WR_MOTION_MAXBATCHSIZE == m_nBatchCount) FlushBatch();
+		m_Batch[m_nBatchCount++] = element;
+	}
 
 	// Report that the motion has been updated
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+	for (Listeners::Dispatch itI(m_Listeners, WR_MOTIONEVENT_SINGLE); itI; ++itI)
 		(*itI)->OnSingleMotion(m_pRemote, this, element);
 
-	// Was there a change?
-	if (fabs(vPrev.x-m_vAccel.x) <= WR_MOTION_GESTUREEPSILON &&
-		fabs(vPrev.y-m_vAccel.y) <= WR_MOTION_GESTUREEPSILON &&
-		fabs(vPrev.z-m_vAccel.z) <= WR_MOTION_GESTUREEPSILON)
+	// Is it still?
+	if (true == m_StillDetector.Update(m_vAccel))
 	{
-		// If there was an active motion, report the end
-		if (true == CHECK_BITS(WMF_ACTIVEMOTION, m_nFlags))
+		// A speculative motion that never passed its test is cancelled instead
+		if (true == CHECK_BITS(WMF_SPECULATIVE, m_nFlags))
+		{
+			CancelMotion(element);
+		}
+		else if (true == CHECK_BITS(WMF_ACTIVEMOTION, m_nFlags))
 		{
 			// Report the end
-			for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+			for (Listeners::Dispatch itI(m_Listeners, WR_MOTIONEVENT_END); itI; ++itI)
 				(*itI)->OnMotionEnd(m_pRemote, this, element);
 		}
 
 		StopMotion();
+		m_nFlags = CLEAR_BITS(WMF_ONSETREJECTED, m_nFlags);
 		return;
 	}
 
-	// If motion is not active, add to queue
+	// If motion is not active, start it
 	if (false == CHECK_BITS(WMF_ACTIVEMOTION, m_nFlags))
 	{
-		// Add to queue and check if we have passed the min
-		m_MotionQueue.push(element);
-		if ((int)m_MotionQueue.size() <= m_nMinMotionSize) return;
-
-		// Report what is in the queue
-		SMotionElement const& front = m_MotionQueue.front(); m_MotionQueue.pop();
-		for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-			(*itI)->OnMotionStart(m_pRemote, this, front);
-		while (false == m_MotionQueue.empty())
+		if (true == CHECK_BITS(WMF_SPECULATIVEONSET, m_nFlags) && false == CHECK_BITS(WMF_ONSETREJECTED, m_nFlags))
 		{
-			SMotionElement const& next = m_MotionQueue.front(); m_MotionQueue.pop();
-			for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-				(*itI)->OnMotionUpdate(m_pRemote, this, next);
+			// Report the start right away, onset test below will confirm or cancel it
+			m_nOnsetCount = 0;
+			m_fOnsetEnergySum = 0.0f;
+			SMotionSpan onset(&element, 1);
+			for (Listeners::Dispatch itI(m_Listeners, WR_MOTIONEVENT_START); itI; ++itI)
+				(*itI)->OnMotionStart(m_pRemote, this, onset);
+
+			// Set flag
+			m_nFlags = SET_BITS(WMF_ACTIVEMOTION|WMF_SPECULATIVE, m_nFlags);
+		}
+		else
+		{
+			// Add to queue and check if we have passed the min
+			m_MotionQueue.Push(element);
+			if (m_MotionQueue.Size() <= m_nMinMotionSize) return;
+
+			// Report the whole onset window at once
+			SMotionSpan onset = m_MotionQueue.GetSpan();
+			for (Listeners::Dispatch itI(m_Listeners, WR_MOTIONEVENT_START); itI; ++itI)
+				(*itI)->OnMotionStart(m_pRemote, this, onset);
+			m_MotionQueue.Clear();
+
+			// Set flag
+			m_nFlags = SET_BITS(WMF_ACTIVEMOTION, m_nFlags);
 		}
-
-		// Set flag
-		m_nFlags = SET_BITS(WMF_ACTIVEMOTION, m_nFlags);
 	}
 	else
 	{
 		// Just report it
-		for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+		for (Listeners::Dispatch itI(m_Listeners, WR_MOTIONEVENT_UPDATE); itI; ++itI)
 			(*itI)->OnMotionUpdate(m_pRemote, this, element);
 	}
+
+	// Test the onset of a speculative motion
+	if (true == CHECK_BITS(WMF_SPECULATIVE, m_nFlags))
+	{
+		SMotionVec3F vDelta = m_vAccel - vPrev;
+		m_fOnsetEnergySum += (vDelta.x*vDelta.x)+(vDelta.y*vDelta.y)+(vDelta.z*vDelta.z);
+		if (++m_nOnsetCount >= m_nOnsetWindow)
+		{
+			// Confirm it if enough energy was put into it
+			if (m_fOnsetEnergySum >= m_fOnsetEnergy*(float)m_nOnsetWindow)
+				m_nFlags = CLEAR_BITS(WMF_SPECULATIVE, m_nFlags);
+			else
+				CancelMotion(element);
+		}
+	}
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiMotion::CancelMotion(SMotionElement const& element)
+{
+	// Report the cancel
+	for (Listeners::Dispatch itI(m_Listeners, WR_MOTIONEVENT_CANCEL); itI; ++itI)
+		(*itI)->OnMotionCancel(m_pRemote, this, element);
+
+	// Fall back to buffered onset until the remote is still again
+	StopMotion();
+	m_nFlags = SET_BITS(WMF_ONSETREJECTED, m_nFlags);
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiMotion::StopMotion(void)
 {
 	// Empty the queue
-	while (false == m_MotionQueue.empty()) m_MotionQueue.pop();
+	m_MotionQueue.Clear();
 	m_nCurrMotionLifetime = 0;
+	m_History.ResetMotion();
 
 	// Set flag
-	m_nFlags = CLEAR_BITS(WMF_ACTIVEMOTION, m_nFlags);
+	m_nFlags = CLEAR_BITS(WMF_ACTIVEMOTION|WMF_SPECULATIVE, m_nFlags);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiMotion::SetRelay(CWR_InputRelay *pRelay)
+{
+	m_Listeners.SetRelay(pRelay);
+	if (NULL != pRelay) pRelay->Attach(&m_Listeners);
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiMotion::OnPostUpdate(void)
 {
+	FlushBatch();
 	m_bWasUpdated = false;
 }
 
+////////////////////////////////////////////////////
+void CWR_WiiMotion::FlushBatch(void)
+{
+	if (0 == m_nBatchCount) return;
+
+	SMotionSpan motions(m_Batch, m_nBatchCount);
+	for (Listeners::Dispatch itI(m_Listeners, WR_MOTIONEVENT_BATCH); itI; ++itI)
+		(*itI)->OnMotionBatch(m_pRemote, this, motions);
+	m_nBatchCount = 0;
+}
+
 ////////////////////////////////////////////////////
 void CWR_WiiMotion::SetMotionSize(int nSize)
 {
-	m_nMinMotionSize = MAX(nSize, 10);
+	m_nMinMotionSize = CLAMP(nSize, 10, WR_MOTION_MAXONSETSIZE-1);
 }
 
 ////////////////////////////////////////////////////
@@ -209,6 +320,27 @@ int CWR_WiiMotion::GetMotionSize(void) const
 	return m_nMinMotionSize;
 }
 
+////////////////////////////////////////////////////
+void CWR_WiiMotion::SetSpeculativeOnset(bool bEnable, int nWindow, float fEnergy)
+{
+	m_nOnsetWindow = MAX(nWindow, 1);
+	m_fOnsetEnergy = MAX(fEnergy, 0.0f);
+	if (true == bEnable) m_nFlags = SET_BITS(WMF_SPECULATIVEONSET, m_nFlags);
+	else m_nFlags = CLEAR_BITS(WMF_SPECULATIVEONSET, m_nFlags);
+}
+
+////////////////////////////////////////////////////
+bool CWR_WiiMotion::IsSpeculativeOnset(void) const
+{
+	return CHECK_BITS(WMF_SPECULATIVEONSET, m_nFlags);
+}
+
+////////////////////////////////////////////////////
+bool CWR_WiiMotion::IsSpeculative(void) const
+{
+	return CHECK_BITS(WMF_SPECULATIVE, m_nFlags);
+}
+
 ////////////////////////////////////////////////////
 bool CWR_WiiMotion::IsMotionActive(void) const
 {
@@ -222,25 +354,39 @@ int CWR_WiiMotion::GetMotionLifetime(void) const
 }
 
 ////////////////////////////////////////////////////
-void CWR_WiiMotion::AddListener(IWR_WiiMotionListener *pListener)
+void CWR_WiiMotion::SetStatsWindow(int nSize)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-			return;
-	m_Listeners.push_back(pListener);
+	m_History.SetWindow(nSize);
+}
+
+////////////////////////////////////////////////////
+int CWR_WiiMotion::GetStatsWindow(void) const
+{
+	return m_History.GetWindow();
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiMotion::GetWindowStats(SMotionStats &stats) const
+{
+	m_History.GetWindowStats(stats);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiMotion::GetMotionStats(SMotionStats &stats) const
+{
+	m_History.GetMotionStats(stats);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiMotion::AddListener(IWR_WiiMotionListener *pListener, unsigned int nEvents)
+{
+	m_Listeners.Add(pListener, nEvents);
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiMotion::RemoveListener(IWR_WiiMotionListener *pListener)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-		{
-			m_Listeners.erase(itI);
-			return;
-		}
+	m_Listeners.Remove(pListener);
 }
 
 ////////////////////////////////////////////////////
@@ -15,6 +15,8 @@
 #define _WR_CWIIMOTION_H_
 
 #include "Interfaces\WR_IWiiMotion.h"
+#include "WR_CMotionHistory.h"
+#include "WR_CStillDetector.h"
 
 class CWR_WiiMotion : public IWR_WiiMotion
 {
@@ -39,9 +41,21 @@ protected:
 	int m_nMinMotionSize;
 	int m_nCurrMotionLifetime;
 	WiiMotionQueue m_MotionQueue;
+	CWR_MotionHistory m_History;
+	CWR_StillDetector m_StillDetector;
+
+	// Elements reported during this update
+	SMotionElement m_Batch[WR_MOTION_MAXBATCHSIZE];
+	int m_nBatchCount;
+
+	// Speculative onset test
+	int m_nOnsetWindow;
+	float m_fOnsetEnergy;
+	int m_nOnsetCount;
+	float m_fOnsetEnergySum;
 
 	// Listeners
-	typedef std::list<IWR_WiiMotionListener*> Listeners;
+	typedef CWR_ListenerList<IWR_WiiMotionListener> Listeners;
 	Listeners m_Listeners;
 
 public:
@@ -101,6 +115,16 @@ protected:
 	////////////////////////////////////////////////////
 	virtual void OnPostUpdate(void);
 
+	////////////////////////////////////////////////////
+	// SetRelay
+	//
+	// Purpose: Hand listener calls to a relay instead
+	//
+	// In:	pRelay - Relay to use, or NULL to call the
+	//			listeners directly
+	////////////////////////////////////////////////////
+	virtual void SetRelay(CWR_InputRelay *pRelay);
+
 	////////////////////////////////////////////////////
 	// OnCalibrateData
 	//
@@ -108,6 +132,16 @@ protected:
 	////////////////////////////////////////////////////
 	static void OnCalibrateData(int nAddr, int nSize, LPWiiIOData pData, WiiIOCallBackParam pParam);
 
+	////////////////////////////////////////////////////
+	// ApplyCalibration
+	//
+	// Purpose: Use a calibration block read from the
+	//	device or the calibration cache
+	//
+	// In:	pData - Calibration block
+	////////////////////////////////////////////////////
+	virtual void ApplyCalibration(LPWiiIOData pData);
+
 	////////////////////////////////////////////////////
 	// StopMotion
 	//
@@ -116,6 +150,24 @@ protected:
 	////////////////////////////////////////////////////
 	virtual void StopMotion(void);
 
+	////////////////////////////////////////////////////
+	// CancelMotion
+	//
+	// Purpose: Report that a speculative motion failed
+	//	its onset test and clean up
+	//
+	// In:	element - Element that failed the test
+	////////////////////////////////////////////////////
+	virtual void CancelMotion(SMotionElement const& element);
+
+	////////////////////////////////////////////////////
+	// FlushBatch
+	//
+	// Purpose: Send the elements batched so far to the
+	//	listeners subscribed to batches
+	////////////////////////////////////////////////////
+	virtual void FlushBatch(void);
+
 public:
 	////////////////////////////////////////////////////
 	// AddListener
@@ -123,8 +175,11 @@ public:
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIMOTION_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiMotionListener *pListener);
+	virtual void AddListener(IWR_WiiMotionListener *pListener, unsigned int nEvents = WR_MOTIONEVENT_DEFAULT);
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -168,6 +223,37 @@ public:
 	////////////////////////////////////////////////////
 	virtual int GetMotionSize(void) const;
 
+	////////////////////////////////////////////////////
+	// SetSpeculativeOnset
+	//
+	// Purpose: Start motions on the first moving update
+	//	instead of waiting for the minimum size. The onset
+	//	is confirmed once the mean energy over the test
+	//	window passes the threshold, otherwise the motion
+	//	is cancelled
+	//
+	// In:	bEnable - TRUE to enable speculative onset
+	//		nWindow - Test window (in consecutive updates)
+	//		fEnergy - Minimum mean energy to confirm
+	////////////////////////////////////////////////////
+	virtual void SetSpeculativeOnset(bool bEnable, int nWindow = WR_MOTION_ONSETWINDOW, float fEnergy = WR_MOTION_ONSETENERGY);
+
+	////////////////////////////////////////////////////
+	// IsSpeculativeOnset
+	//
+	// Purpose: Returns TRUE if speculative onset is enabled
+	////////////////////////////////////////////////////
+	virtual bool IsSpeculativeOnset(void) const;
+
+	////////////////////////////////////////////////////
+	// IsSpeculative
+	//
+	// Purpose: Returns TRUE while the active motion was
+	//	started speculatively and its onset test has not
+	//	confirmed it yet
+	////////////////////////////////////////////////////
+	virtual bool IsSpeculative(void) const;
+
 	////////////////////////////////////////////////////
 	// IsMotionActive
 	//
@@ -183,6 +269,45 @@ public:
 	////////////////////////////////////////////////////
 	virtual int GetMotionLifetime(void) const;
 
+	////////////////////////////////////////////////////
+	// SetStatsWindow
+	//
+	// Purpose: Set the size of the sliding window used
+	//	by GetWindowStats
+	//
+	// In:	nSize - Size (in number of consecutive updates)
+	//
+	// Note: Size is clamped to [2, WR_MOTION_HISTORYSIZE]
+	////////////////////////////////////////////////////
+	virtual void SetStatsWindow(int nSize);
+
+	////////////////////////////////////////////////////
+	// GetStatsWindow
+	//
+	// Purpose: Get the size of the sliding window used
+	//	by GetWindowStats
+	////////////////////////////////////////////////////
+	virtual int GetStatsWindow(void) const;
+
+	////////////////////////////////////////////////////
+	// GetWindowStats
+	//
+	// Purpose: Get statistics over the newest updates
+	//
+	// Out:	stats - Statistics, including the last update
+	////////////////////////////////////////////////////
+	virtual void GetWindowStats(SMotionStats &stats) const;
+
+	////////////////////////////////////////////////////
+	// GetMotionStats
+	//
+	// Purpose: Get statistics over the current motion
+	//
+	// Out:	stats - Statistics since the remote was last
+	//			still, including the last update
+	////////////////////////////////////////////////////
+	virtual void GetMotionStats(SMotionStats &stats) const;
+
 	////////////////////////////////////////////////////
 	// GetAcceleration
 	//
@@ -14,6 +14,7 @@
 #include "stdafx.h"
 #include "WR_Implementation.h"
 #include "WR_CWiiNunchuk.h"
+#include "WR_CWiiRemote.h"
 
 ////////////////////////////////////////////////////
 CWR_WiiNunchuk::CWR_WiiNunchuk(void)
@@ -21,19 +22,22 @@ CWR_WiiNunchuk::CWR_WiiNunchuk(void)
 	m_pRemote = NULL;
 	m_bWasUpdated = false;
 
-	m_nButtons = 0;
-	m_nActionIDSeed = 0;
-	memset(m_pButtonStatus, 0, sizeof(int)*WR_NUNCHUK_BUTTONS_MAX);
-	memset(m_pButtonBufferedTime, 0, sizeof(float)*WR_NUNCHUK_BUTTONS_MAX);
+	m_nChangedButtons = 0;
 
 	m_fPitch = 0.0f;
 	m_fRoll = 0.0f;
 	SetMotionSize(0);
 	m_nFlags = 0;
 	m_nCurrMotionLifetime = 0;
+	m_nOnsetWindow = WR_MOTION_ONSETWINDOW;
+	m_fOnsetEnergy = WR_MOTION_ONSETENERGY;
+	m_nOnsetCount = 0;
+	m_fOnsetEnergySum = 0.0f;
+	m_nBatchCount = 0;
 
 	m_fAnalogX = 0.0f;
 	m_fAnalogY = 0.0f;
+	m_Buttons.SetOrder(WR_NUNCHUK_BUTTONS_INDEX_VALUE, WR_NUNCHUK_BUTTONS_MAX);
 }
 
 ////////////////////////////////////////////////////
@@ -43,25 +47,15 @@ CWR_WiiNunchuk::~CWR_WiiNunchuk(void)
 }
 
 ////////////////////////////////////////////////////
-void CWR_WiiNunchuk::AddListener(IWR_WiiExtensionListener *pListener)
+void CWR_WiiNunchuk::AddListener(IWR_WiiExtensionListener *pListener, unsigned int nEvents)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-			return;
-	m_Listeners.push_back(pListener);
+	m_Listeners.Add(pListener, nEvents);
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiNunchuk::RemoveListener(IWR_WiiExtensionListener *pListener)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-		{
-			m_Listeners.erase(itI);
-			return;
-		}
+	m_Listeners.Remove(pListener);
 }
 
 ////////////////////////////////////////////////////
@@ -83,19 +77,17 @@ bool CWR_WiiNunchuk::Initialize(IWR_WiiRemote *pRemote)
 	if (NULL == m_pRemote) return false;
 
 	m_nFlags = 0;
+	m_History.Clear();
+	m_StillDetector.Reset();
+	m_nBatchCount = 0;
 
 	// TODO Setup analog stick
 
 
 	// Reset status of buttons
-	m_nButtons = 0;
-	for (int i = 0; i < WR_NUNCHUK_BUTTONS_MAX; i++)
-	{
-		m_pButtonStatus[i] = WR_BUTTONSTATUS_UP;
-		m_pButtonBufferedTime[i] = 0;
-	}
-
-	m_nActionIDSeed = ACTIONID_INVALID;
+	m_Buttons.Reset();
+	m_nChangedButtons = 0;
+	m_Combos.Reset();
 	return true;
 }
 
@@ -105,31 +97,45 @@ void CWR_WiiNunchuk::OnCalibrateData(int nAddr, int nSize, LPWiiIOData pData, Wi
 	CWR_WiiNunchuk *pThis = (CWR_WiiNunchuk*)pParam;
 	if (NULL == pThis) return;
 
+	// Only apply it if the cached one was missing or stale
+	if (true == g_pWR->pCalibrationCache->Store(pThis->m_pRemote->GetDevicePath(), WR_NUNCHUK_CALIBRATION_LOC,
+		WR_NUNCHUK_CALIBRATION_SIZE, pData) || false == pThis->IsCalibrated())
+	{
+		pThis->ApplyCalibration(pData);
+	}
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiNunchuk::ApplyCalibration(LPWiiIOData pData)
+{
 	// Extract calibration data
-	pThis->m_vCalibration_ZeroPoint.x = (*(pData+0)^0x17)+0x17;
-	pThis->m_vCalibration_ZeroPoint.y = (*(pData+1)^0x17)+0x17;
-	pThis->m_vCalibration_ZeroPoint.z = (*(pData+2)^0x17)+0x17;
-	pThis->m_vCalibration_1G.x = (*(pData+4)^0x17)+0x17;
-	pThis->m_vCalibration_1G.y = (*(pData+5)^0x17)+0x17;
-	pThis->m_vCalibration_1G.z = (*(pData+6)^0x17)+0x17;
-
-	pThis->m_vAnalogCalibration_Max.x = (*(pData+8)^0x17)+0x17;
-	pThis->m_vAnalogCalibration_Max.y = (*(pData+11)^0x17)+0x17;
-	pThis->m_vAnalogCalibration_Max.z = (*(pData+10)^0x17)+0x17;
-	pThis->m_vAnalogCalibration_Min.x = (*(pData+9)^0x17)+0x17;
-	pThis->m_vAnalogCalibration_Min.y = (*(pData+12)^0x17)+0x17;
-	pThis->m_vAnalogCalibration_Min.z = (*(pData+13)^0x17)+0x17;
+	m_vCalibration_ZeroPoint.x = (*(pData+0)^0x17)+0x17;
+	m_vCalibration_ZeroPoint.y = (*(pData+1)^0x17)+0x17;
+	m_vCalibration_ZeroPoint.z = (*(pData+2)^0x17)+0x17;
+	m_vCalibration_1G.x = (*(pData+4)^0x17)+0x17;
+	m_vCalibration_1G.y = (*(pData+5)^0x17)+0x17;
+	m_vCalibration_1G.z = (*(pData+6)^0x17)+0x17;
+
+	m_vAnalogCalibration_Max.x = (*(pData+8)^0x17)+0x17;
+	m_vAnalogCalibration_Max.y = (*(pData+11)^0x17)+0x17;
+	m_vAnalogCalibration_Max.z = (*(pData+10)^0x17)+0x17;
+	m_vAnalogCalibration_Min.x = (*(pData+9)^0x17)+0x17;
+	m_vAnalogCalibration_Min.y = (*(pData+12)^0x17)+0x17;
+	m_vAnalogCalibration_Min.z = (*(pData+13)^0x17)+0x17;
 
 	// Calculate ratio values
-	pThis->m_vCalibration_Ratio.x = 1.0f / ((float)pThis->m_vCalibration_1G.x - pThis->m_vCalibration_ZeroPoint.x);
-	pThis->m_vCalibration_Ratio.y = 1.0f / ((float)pThis->m_vCalibration_1G.y - pThis->m_vCalibration_ZeroPoint.y);
-	pThis->m_vCalibration_Ratio.z = 1.0f / ((float)pThis->m_vCalibration_1G.z - pThis->m_vCalibration_ZeroPoint.z);
+	m_vCalibration_Ratio.x = 1.0f / ((float)m_vCalibration_1G.x - m_vCalibration_ZeroPoint.x);
+	m_vCalibration_Ratio.y = 1.0f / ((float)m_vCalibration_1G.y - m_vCalibration_ZeroPoint.y);
+	m_vCalibration_Ratio.z = 1.0f / ((float)m_vCalibration_1G.z - m_vCalibration_ZeroPoint.z);
 	
-	pThis->m_vAnalogCalibration_Ratio.x = 2.0f / ((float)pThis->m_vAnalogCalibration_Max.x - pThis->m_vAnalogCalibration_Min.x);
-	pThis->m_vAnalogCalibration_Ratio.y = 2.0f / ((float)pThis->m_vAnalogCalibration_Max.y - pThis->m_vAnalogCalibration_Min.y);
+	m_vAnalogCalibration_Ratio.x = 2.0f / ((float)m_vAnalogCalibration_Max.x - m_vAnalogCalibration_Min.x);
+	m_vAnalogCalibration_Ratio.y = 2.0f / ((float)m_vAnalogCalibration_Max.y - m_vAnalogCalibration_Min.y);
 
 	// Set calibrated bit
-	pThis->m_nFlags = SET_BITS(WMF_ISCALIBRATED,pThis->m_nFlags);
+	m_nFlags = SET_BITS(WMF_ISCALIBRATED,m_nFlags);
+
+	// Noise level was learned in the old units, a motion going on carries on
+	m_StillDetector.Reset(true);
 }
 
 ////////////////////////////////////////////////////
@@ -137,8 +143,9 @@ void CWR_WiiNunchuk::Shutdown(void)
 {
 	m_pRemote = NULL;
 
-	// Clear action map
-	m_ActionMap.clear();
+	// Clear action table
+	m_Actions.Clear();
+	m_Combos.Clear();
 }
 
 ////////////////////////////////////////////////////
@@ -156,91 +163,32 @@ void CWR_WiiNunchuk::OnUpdate(int nID, DataBuffer const& buffer, int nOffset, fl
 	// Decrypt data first
 	DataBuffer decryptBuffer;
 	DecryptBuffer(buffer, decryptBuffer);
+	CWR_EventJournal &journal = ((CWR_WiiRemote*)m_pRemote)->m_Journal;
+	SJournalEvent event;
+	event.nSource = WR_JOURNAL_EXTENSION;
+	event.fTime = (buffer.fRecvTime > 0.0f ? buffer.fRecvTime : g_pWR->pTimer->GetPreciseTime());
 
 	if (WR_EXTENSION_UPDATE_REPORT == nID)
 	{
 		m_bWasUpdated = true;
 
-		// Update input
+		// Update the buttons and look for changes, they read 0 when down
 		assert(m_pRemote);
-		bool bBuffered = IsBufferedInputEnabled();
-		unsigned int nPrevButtons = m_nButtons;
-		int nPrev, nCurr, nUp;
+		const unsigned int nDown = ~(unsigned int)decryptBuffer[nOffset+WR_NCDATA_BUTTONS] & WR_NCBUTTON_ALL;
+		const unsigned int nWasDown = m_Buttons.GetHeld();
+		SignalButtons(m_Buttons.Update(nDown, IsBufferedInputEnabled(), fCurrTick));
 
-		// Update m_nButtons and look for changes
-		m_nButtons = (unsigned int)decryptBuffer[nOffset+WR_NCDATA_BUTTONS];
-		for (int nButton = 0; nButton < WR_NUNCHUK_BUTTONS_MAX; nButton++)
+		if (nDown != nWasDown)
 		{
-			// Get previous and current changes
-			nUp = m_nButtons & WR_NUNCHUK_BUTTONS_INDEX_VALUE[nButton];
-			nPrev = m_pButtonStatus[nButton];
-
-			// Pick new state for it based on previous state
-			switch (m_pButtonStatus[nButton])
-			{
-				case WR_BUTTONSTATUS_UP:
-				{
-					// If the button is now down...
-					if (!nUp)
-					{
-						// Go to pushed on buffered, otherwise go to down
-						m_pButtonStatus[nButton] = (bBuffered?WR_BUTTONSTATUS_PUSHED:WR_BUTTONSTATUS_DOWN);
-						if (true == bBuffered) m_pButtonBufferedTime[nButton] = fCurrTick;
-					}
-				}
-				break;
-				case WR_BUTTONSTATUS_PUSHED:
-				{
-					// If the button is still down...
-					if (!nUp)
-					{
-						// Go to down state
-						m_pButtonStatus[nButton] = WR_BUTTONSTATUS_DOWN;
-					}
-					else
-					{
-						// Otherwise go to up state
-						m_pButtonStatus[nButton] = WR_BUTTONSTATUS_RELEASED;
-					}
-				}
-				break;
-				case WR_BUTTONSTATUS_DOWN:
-				{
-					// If the button is coming back up...
-					if (nUp)
-					{
-						// Go to released on buffered, otherwise go to up
-						m_pButtonStatus[nButton] = (bBuffered?WR_BUTTONSTATUS_RELEASED:WR_BUTTONSTATUS_UP);
-						if (true == bBuffered) m_pButtonBufferedTime[nButton] = fCurrTick;
-					}
-				}
-				break;
-				case WR_BUTTONSTATUS_RELEASED:
-				{
-					// If the button is now down...
-					if (!nUp)
-					{
-						// Go back to down state
-						m_pButtonStatus[nButton] = WR_BUTTONSTATUS_PUSHED;
-					}
-					else
-					{
-						// Otherwise finish going to up state
-						m_pButtonStatus[nButton] = WR_BUTTONSTATUS_UP;
-					}
-				}
-				break;
-			}
-
-			// Did the status change?
-			nCurr = m_pButtonStatus[nButton];
-			if (nPrev != nCurr)
-			{
-				// Signal the button status changed
-				for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-					(*itI)->OnExtensionButton(m_pRemote, this, WR_NUNCHUK_BUTTONS_INDEX_VALUE[nButton],
-						m_pButtonStatus[nButton], (m_pButtonStatus[nButton]==WR_BUTTONSTATUS_UP?false:true));
-			}
+			// Step combos with the edges, at the time the report came in
+			m_Combos.OnButtons(nDown & ~nWasDown, nWasDown & ~nDown, event.fTime);
+
+			// Publish them
+			event.nType = WR_JOURNAL_BUTTON;
+			event.data.button.nPushed = nDown & ~nWasDown;
+			event.data.button.nReleased = nWasDown & ~nDown;
+			event.data.button.nHeld = nDown;
+			journal.Publish(event);
 		}
 
 		// Update motion
@@ -277,56 +225,100 @@ void CWR_WiiNunchuk::OnUpdate(int nID, DataBuffer const& buffer, int nOffset, fl
 		element.fPitch = m_fPitch;
 		element.fRoll = m_fRoll;
 		element.nLifetime = ++m_nCurrMotionLifetime;
+		m_History.Push(element, event.fTime);
+
+		event.nType = WR_JOURNAL_MOTION;
+		event.data.motion.x = m_vAccel.x;
+		event.data.motion.y = m_vAccel.y;
+		event.data.motion.z = m_vAccel.z;
+		event.data.motion.fPitch = m_fPitch;
+		event.data.motion.fRoll = m_fRoll;
+		journal.Publish(event);
+
+		// Hold on to it for the batch listeners
+		if (true == m_Listeners.IsListening(WR_EXTEVENT_MOTIONBATCH))
+		{
+			if (WR_MOTION_MAXBATCHSIZE == m_nBatchCount) FlushBatch();
+			m_Batch[m_nBatchCount++] = element;
+		}
 
-		// Was there a change?
-		if (fabs(vPrev.x-m_vAccel.x) <= WR_MOTION_GESTUREEPSILON &&
-			fabs(vPrev.y-m_vAccel.y) <= WR_MOTION_GESTUREEPSILON &&
-			fabs(vPrev.z-m_vAccel.z) <= WR_MOTION_GESTUREEPSILON)
+		// Is it still?
+		if (true == m_StillDetector.Update(m_vAccel))
 		{
-			// If there was an active motion, report the end
-			if (true == CHECK_BITS(WMF_ACTIVEMOTION, m_nFlags))
+			// A speculative motion that never passed its test is cancelled instead
+			if (true == CHECK_BITS(WMF_SPECULATIVE, m_nFlags))
+			{
+				CancelMotion(element);
+			}
+			else if (true == CHECK_BITS(WMF_ACTIVEMOTION, m_nFlags))
 			{
 				// Report the end
-				for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+				for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_MOTIONEND); itI; ++itI)
 					(*itI)->OnExtensionMotionEnd(m_pRemote, this, element);
 			}
 
 			StopMotion();
+			m_nFlags = CLEAR_BITS(WMF_ONSETREJECTED, m_nFlags);
 		}
 		else
 		{
-			// If motion is not active, add to queue
+			// If motion is not active, start it
 			if (false == CHECK_BITS(WMF_ACTIVEMOTION, m_nFlags))
 			{
-				// Add to queue and check if we have passed the min
-				m_MotionQueue.push(element);
-				if ((int)m_MotionQueue.size() > m_nMinMotionSize)
+				if (true == CHECK_BITS(WMF_SPECULATIVEONSET, m_nFlags) && false == CHECK_BITS(WMF_ONSETREJECTED, m_nFlags))
 				{
-					// Report what is in the queue
-					SMotionElement const& front = m_MotionQueue.front(); m_MotionQueue.pop();
-					for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-						(*itI)->OnExtensionMotionStart(m_pRemote, this, front);
-					while (false == m_MotionQueue.empty())
-					{
-						SMotionElement const& next = m_MotionQueue.front(); m_MotionQueue.pop();
-						for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-							(*itI)->OnExtensionMotionUpdate(m_pRemote, this, next);
-					}
+					// Report the start right away, onset test below will confirm or cancel it
+					m_nOnsetCount = 0;
+					m_fOnsetEnergySum = 0.0f;
+					SMotionSpan onset(&element, 1);
+					for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_MOTIONSTART); itI; ++itI)
+						(*itI)->OnExtensionMotionStart(m_pRemote, this, onset);
 
 					// Set flag
-					m_nFlags = SET_BITS(WMF_ACTIVEMOTION, m_nFlags);
+					m_nFlags = SET_BITS(WMF_ACTIVEMOTION|WMF_SPECULATIVE, m_nFlags);
+				}
+				else
+				{
+					// Add to queue and check if we have passed the min
+					m_MotionQueue.Push(element);
+					if (m_MotionQueue.Size() > m_nMinMotionSize)
+					{
+						// Report the whole onset window at once
+						SMotionSpan onset = m_MotionQueue.GetSpan();
+						for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_MOTIONSTART); itI; ++itI)
+							(*itI)->OnExtensionMotionStart(m_pRemote, this, onset);
+						m_MotionQueue.Clear();
+
+						// Set flag
+						m_nFlags = SET_BITS(WMF_ACTIVEMOTION, m_nFlags);
+					}
 				}
 			}
 			else
 			{
 				// Just report it
-				for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+				for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_MOTIONUPDATE); itI; ++itI)
 					(*itI)->OnExtensionMotionUpdate(m_pRemote, this, element);
 			}
+
+			// Test the onset of a speculative motion
+			if (true == CHECK_BITS(WMF_SPECULATIVE, m_nFlags))
+			{
+				SMotionVec3F vDelta = m_vAccel - vPrev;
+				m_fOnsetEnergySum += (vDelta.x*vDelta.x)+(vDelta.y*vDelta.y)+(vDelta.z*vDelta.z);
+				if (++m_nOnsetCount >= m_nOnsetWindow)
+				{
+					// Confirm it if enough energy was put into it
+					if (m_fOnsetEnergySum >= m_fOnsetEnergy*(float)m_nOnsetWindow)
+						m_nFlags = CLEAR_BITS(WMF_SPECULATIVE, m_nFlags);
+					else
+						CancelMotion(element);
+				}
+			}
 		}
 
 		// Report that the motion has been updated
-		for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+		for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_SINGLEMOTION); itI; ++itI)
 			(*itI)->OnExtensionSingleMotion(m_pRemote, this, element);
 
 		// Update analog sticks
@@ -339,9 +331,14 @@ void CWR_WiiNunchuk::OnUpdate(int nID, DataBuffer const& buffer, int nOffset, fl
 			m_fAnalogX *= m_vAnalogCalibration_Ratio.x;
 			m_fAnalogY *= m_vAnalogCalibration_Ratio.y;
 		}
+		event.nType = WR_JOURNAL_ANALOG;
+		event.data.analog.nStick = 1;
+		event.data.analog.fX = m_fAnalogX;
+		event.data.analog.fY = m_fAnalogY;
+		journal.Publish(event);
 		if (m_fAnalogX != fPrevX || m_fAnalogY != fPrevY)
 		{
-			for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+			for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_ANALOGUPDATE); itI; ++itI)
 				(*itI)->OnExtensionAnalogUpdate(m_pRemote, this, 1, m_fAnalogX, m_fAnalogY);
 		}
 	}
@@ -351,60 +348,92 @@ void CWR_WiiNunchuk::OnUpdate(int nID, DataBuffer const& buffer, int nOffset, fl
 void CWR_WiiNunchuk::StopMotion(void)
 {
 	// Empty the queue
-	while (false == m_MotionQueue.empty()) m_MotionQueue.pop();
+	m_MotionQueue.Clear();
 	m_nCurrMotionLifetime = 0;
+	m_History.ResetMotion();
 
 	// Set flag
-	m_nFlags = CLEAR_BITS(WMF_ACTIVEMOTION, m_nFlags);
+	m_nFlags = CLEAR_BITS(WMF_ACTIVEMOTION|WMF_SPECULATIVE, m_nFlags);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiNunchuk::CancelMotion(SMotionElement const& element)
+{
+	// Report the cancel
+	for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_MOTIONCANCEL); itI; ++itI)
+		(*itI)->OnExtensionMotionCancel(m_pRemote, this, element);
+
+	// Fall back to buffered onset until the nunchuk is still again
+	StopMotion();
+	m_nFlags = SET_BITS(WMF_ONSETREJECTED, m_nFlags);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiNunchuk::SetRelay(CWR_InputRelay *pRelay)
+{
+	m_Listeners.SetRelay(pRelay);
+	if (NULL != pRelay) pRelay->Attach(&m_Listeners);
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiNunchuk::OnPostUpdate(void)
 {
+	// Push buffered input to next stage, to prevent spamming due to lack of
+	//	comm from the remote
 	if (false == m_bWasUpdated)
-	{
-		// Go through and push buffered input to next stage, to prevent spamming due to lack of
-		//	comm from the remote
-		int nPrev, nCurr;
-		for (int nButton = 0; nButton < WR_NUNCHUK_BUTTONS_MAX; nButton++)
-		{
-			nPrev = m_pButtonStatus[nButton];
-			switch (m_pButtonStatus[nButton])
-			{
-				case WR_BUTTONSTATUS_PUSHED: m_pButtonStatus[nButton] = WR_BUTTONSTATUS_DOWN; break;
-				case WR_BUTTONSTATUS_RELEASED: m_pButtonStatus[nButton] = WR_BUTTONSTATUS_UP; break;
-			}
-			nCurr = m_pButtonStatus[nButton];
+		SignalButtons(m_Buttons.Settle());
 
-			// Did the status change?
-			nCurr = m_pButtonStatus[nButton];
-			if (nPrev != nCurr)
-			{
-				// Signal the button status changed
-				for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-					(*itI)->OnExtensionButton(m_pRemote, this, WR_NUNCHUK_BUTTONS_INDEX_VALUE[nButton],
-						m_pButtonStatus[nButton], (m_pButtonStatus[nButton]==WR_BUTTONSTATUS_UP?false:true));
-			}
-		}
+	// Update action status and report the changes
+	const int nChangedActions = m_Actions.Evaluate(m_Buttons, m_nChangedButtons, g_pWR->pTimer->GetDeltaTime());
+	m_nChangedButtons = 0;
+	for (int i = 0; i < nChangedActions; i++)
+	{
+		const ActionID nID = m_Actions.GetChanged(i);
+		const int nStatus = m_Actions.GetLastStatus(nID);
+		for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_ACTION); itI; ++itI)
+			(*itI)->OnExtensionAction(m_pRemote, this, m_Actions.GetName(nID), nID, nStatus, (WR_BUTTONSTATUS_UP == nStatus ? false : true));
 	}
 
-	// Update action status
-	for (ActionMap::iterator itAction = m_ActionMap.begin(); itAction != m_ActionMap.end(); itAction++)
+	// Update combos and report the changes in order
+	const int nComboEvents = m_Combos.Update(g_pWR->pTimer->GetPreciseTime());
+	for (int i = 0; i < nComboEvents; i++)
 	{
-		int nLastStatus = itAction->second.nLastStatus;
-		itAction->second.nLastStatus = GetActionStatus(itAction->first, g_pWR->pTimer->GetDeltaTime());
-		if (itAction->second.nLastStatus != nLastStatus)
-		{
-			// Report the change
-			for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-					(*itI)->OnExtensionAction(m_pRemote, this, itAction->second.szName.c_str(), itAction->first,
-						itAction->second.nLastStatus, (itAction->second.nLastStatus==WR_BUTTONSTATUS_UP?false:true));
-		}
+		CWR_ComboEngine::SEvent const& event = m_Combos.GetEvent(i);
+		for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_ACTION); itI; ++itI)
+			(*itI)->OnExtensionAction(m_pRemote, this, m_Combos.GetName(event.nID), event.nID, event.nStatus, (WR_BUTTONSTATUS_UP == event.nStatus ? false : true));
 	}
+	m_Combos.ClearEvents();
 
+	FlushBatch();
 	m_bWasUpdated = false;
 }
 
+////////////////////////////////////////////////////
+void CWR_WiiNunchuk::FlushBatch(void)
+{
+	if (0 == m_nBatchCount) return;
+
+	SMotionSpan motions(m_Batch, m_nBatchCount);
+	for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_MOTIONBATCH); itI; ++itI)
+		(*itI)->OnExtensionMotionBatch(m_pRemote, this, motions);
+	m_nBatchCount = 0;
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiNunchuk::SignalButtons(unsigned int nChanged)
+{
+	m_nChangedButtons |= nChanged;
+
+	// Only visit the buttons that changed
+	for (; 0 != nChanged; nChanged &= nChanged-1)
+	{
+		const unsigned int nButton = nChanged & (~nChanged+1);
+		const int nStatus = m_Buttons.GetStatus(nButton);
+		for (Listeners::Dispatch itI(m_Listeners, WR_EXTEVENT_BUTTON); itI; ++itI)
+			(*itI)->OnExtensionButton(m_pRemote, this, nButton, nStatus, (WR_BUTTONSTATUS_UP == nStatus ? false : true));
+	}
+}
+
 ////////////////////////////////////////////////////
 void CWR_WiiNunchuk::EnableBufferedInput(bool bEnable)
 {
@@ -423,67 +452,7 @@ bool CWR_WiiNunchuk::IsBufferedInputEnabled(void) const
 ////////////////////////////////////////////////////
 int CWR_WiiNunchuk::GetButtonStatus(unsigned int nButtonMask, float fError) const
 {
-	int nStatus = -1;
-
-	// If it is a pow2 mask (meaning only one button is requested), just return it
-	if (IS_POW2(nButtonMask))
-	{
-		for (int nButton = 0; nButton < WR_NUNCHUK_BUTTONS_MAX; nButton++)
-		{
-			if (nButtonMask == WR_NUNCHUK_BUTTONS_INDEX_VALUE[nButton])
-				return m_pButtonStatus[nButton];
-		}
-		return WR_BUTTONSTATUS_UP;
-	}
-
-	// Check each button in the mask
-	int nButtonValue, nButtonStatus;
-	float fCurrTick = (fError > 0.0f ? g_pWR->pTimer->GetCurrTime() : 0.0f);
-	for (int nButton = 0; nButton < WR_NUNCHUK_BUTTONS_MAX; nButton++)
-	{
-		nButtonValue = WR_NUNCHUK_BUTTONS_INDEX_VALUE[nButton];
-		if (nButtonValue == (nButtonMask&nButtonValue))
-		{
-			nButtonStatus = m_pButtonStatus[nButton];
-
-			// Account for error
-			if (fError > 0.0f &&
-				(WR_BUTTONSTATUS_DOWN == nButtonStatus || WR_BUTTONSTATUS_UP == nButtonStatus))
-			{
-				if (fCurrTick - m_pButtonBufferedTime[nButton] <= fError)
-				{
-					if (WR_BUTTONSTATUS_DOWN == nButtonStatus)
-						nButtonStatus = WR_BUTTONSTATUS_PUSHED;
-					else
-						nButtonStatus = WR_BUTTONSTATUS_RELEASED;
-				}
-			}
-
-			// They want the status of this button...
-			if (-1 == nStatus)
-			{
-				// First request, so just take the value
-				nStatus = nButtonStatus;
-			}
-			else
-			{
-				// Take status based on overall result
-				// Rules:
-				//	1. If a button is up, all are up
-				//	2. Up and down status take presedence over pushed and releasing
-				//  3. If just one button is being released and none others are, all are up
-				if (WR_BUTTONSTATUS_UP == nButtonStatus)
-					nStatus = WR_BUTTONSTATUS_UP;
-				else if (WR_BUTTONSTATUS_PUSHED == nStatus && WR_BUTTONSTATUS_DOWN == nButtonStatus)
-					nStatus = WR_BUTTONSTATUS_DOWN;
-				else if (WR_BUTTONSTATUS_RELEASED == nButtonStatus && WR_BUTTONSTATUS_RELEASED != nStatus)
-					nStatus = WR_BUTTONSTATUS_UP;
-			}
-		}
-	}
-	
-	// Return status
-	return (-1 == nStatus ? WR_BUTTONSTATUS_UP : nStatus);
+	return m_Buttons.GetStatus(nButtonMask, fError);
 }
 
 ////////////////////////////////////////////////////
@@ -496,81 +465,66 @@ bool CWR_WiiNunchuk::IsButtonDown(unsigned int nButtonMask, float fError) const
 ////////////////////////////////////////////////////
 int CWR_WiiNunchuk::RegisterAction(char const* szName, unsigned int nButtonMask)
 {
-	// Check to make sure there isn't already an action named this
-	for (ActionMap::iterator itI = m_ActionMap.begin(); itI != m_ActionMap.end(); itI++)
-	{
-		if (itI->second.szName == szName)
-		{
-			// Update its mask
-			itI->second.nButtonMask = nButtonMask;
-			return itI->first;
-		}
-	}
-
-	// Make a new entry
-	SWR_WiiButton_Action action;
-	action.nID = ++m_nActionIDSeed;
-	action.szName = szName;
-	action.nButtonMask = nButtonMask;
+	return m_Actions.Register(szName, nButtonMask);
+}
 
-	// Return it
-	m_ActionMap[action.nID] = action;
-	return action.nID;
+////////////////////////////////////////////////////
+int CWR_WiiNunchuk::RegisterCombo(char const* szName, SWR_WiiButton_Combo const& combo)
+{
+	return m_Combos.Register(szName, combo);
 }
 
 ////////////////////////////////////////////////////
 int CWR_WiiNunchuk::GetActionStatus(char const* szName, float fError) const
 {
-	// Find the entry
-	for (ActionMap::const_iterator itI = m_ActionMap.begin(); itI != m_ActionMap.end(); itI++)
-	{
-		if (itI->second.szName == szName)
-		{
-			return GetActionStatus(itI->first, fError);
-		}
-	}
-	return WR_BUTTONSTATUS_UP;
+	const ActionID nID = m_Actions.Find(szName);
+	return GetActionStatus((ACTIONID_INVALID == nID ? m_Combos.Find(szName) : nID), fError);
 }
 
 ////////////////////////////////////////////////////
 int CWR_WiiNunchuk::GetActionStatus(int nID, float fError) const
 {
+	if (true == m_Combos.IsCombo(nID)) return m_Combos.GetStatus(nID);
+
 	// Find the entry
-	ActionMap::const_iterator itAction = m_ActionMap.find(nID);
-	if (m_ActionMap.end() == itAction) return WR_BUTTONSTATUS_UP;
+	const unsigned int nButtonMask = m_Actions.GetButtonMask(nID);
+	if (0 == nButtonMask) return WR_BUTTONSTATUS_UP;
 
 	// Check its status
-	return GetButtonStatus(itAction->second.nButtonMask, fError);
+	return GetButtonStatus(nButtonMask, fError);
 }
 
 ////////////////////////////////////////////////////
 bool CWR_WiiNunchuk::IsActionDown(char const* szName, float fError) const
 {
-	// Find the entry
-	for (ActionMap::const_iterator itI = m_ActionMap.begin(); itI != m_ActionMap.end(); itI++)
-	{
-		if (itI->second.szName == szName)
-		{
-			return IsActionDown(itI->first, fError);
-		}
-	}
-	return WR_BUTTONSTATUS_UP;
+	const ActionID nID = m_Actions.Find(szName);
+	return IsActionDown((ACTIONID_INVALID == nID ? m_Combos.Find(szName) : nID), fError);
 }
 
 ////////////////////////////////////////////////////
 bool CWR_WiiNunchuk::IsActionDown(int nID, float fError) const
 {
+	if (true == m_Combos.IsCombo(nID)) return (WR_BUTTONSTATUS_UP != m_Combos.GetStatus(nID));
+
 	// Find the entry
-	ActionMap::const_iterator itAction = m_ActionMap.find(nID);
-	if (m_ActionMap.end() == itAction) return WR_BUTTONSTATUS_UP;
+	const unsigned int nButtonMask = m_Actions.GetButtonMask(nID);
+	if (0 == nButtonMask) return false;
 
 	// Check its status
-	return IsButtonDown(itAction->second.nButtonMask, fError);
+	return IsButtonDown(nButtonMask, fError);
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiNunchuk::Calibrate(void)
 {
+	// Use the cached calibration until the read verifies it
+	WiiIOData cached[WR_NUNCHUK_CALIBRATION_SIZE];
+	if (true == g_pWR->pCalibrationCache->Find(m_pRemote->GetDevicePath(), WR_NUNCHUK_CALIBRATION_LOC,
+		WR_NUNCHUK_CALIBRATION_SIZE, cached))
+	{
+		ApplyCalibration(cached);
+	}
+
 	// Read calibration data
 	m_pRemote->GetDataHelper()->ReadData(WR_NUNCHUK_CALIBRATION_LOC, WR_NUNCHUK_CALIBRATION_SIZE, OnCalibrateData, this);
 }
@@ -584,7 +538,7 @@ bool CWR_WiiNunchuk::IsCalibrated(void) const
 ////////////////////////////////////////////////////
 void CWR_WiiNunchuk::SetMotionSize(int nSize)
 {
-	m_nMinMotionSize = MAX(nSize, 10);
+	m_nMinMotionSize = CLAMP(nSize, 10, WR_MOTION_MAXONSETSIZE-1);
 }
 
 ////////////////////////////////////////////////////
@@ -593,6 +547,27 @@ int CWR_WiiNunchuk::GetMotionSize(void) const
 	return m_nMinMotionSize;
 }
 
+////////////////////////////////////////////////////
+void CWR_WiiNunchuk::SetSpeculativeOnset(bool bEnable, int nWindow, float fEnergy)
+{
+	m_nOnsetWindow = MAX(nWindow, 1);
+	m_fOnsetEnergy = MAX(fEnergy, 0.0f);
+	if (true == bEnable) m_nFlags = SET_BITS(WMF_SPECULATIVEONSET, m_nFlags);
+	else m_nFlags = CLEAR_BITS(WMF_SPECULATIVEONSET, m_nFlags);
+}
+
+////////////////////////////////////////////////////
+bool CWR_WiiNunchuk::IsSpeculativeOnset(void) const
+{
+	return CHECK_BITS(WMF_SPECULATIVEONSET, m_nFlags);
+}
+
+////////////////////////////////////////////////////
+bool CWR_WiiNunchuk::IsSpeculative(void) const
+{
+	return CHECK_BITS(WMF_SPECULATIVE, m_nFlags);
+}
+
 ////////////////////////////////////////////////////
 bool CWR_WiiNunchuk::IsMotionActive(void) const
 {
@@ -605,6 +580,30 @@ int CWR_WiiNunchuk::GetMotionLifetime(void) const
 	return m_nCurrMotionLifetime;
 }
 
+////////////////////////////////////////////////////
+void CWR_WiiNunchuk::SetStatsWindow(int nSize)
+{
+	m_History.SetWindow(nSize);
+}
+
+////////////////////////////////////////////////////
+int CWR_WiiNunchuk::GetStatsWindow(void) const
+{
+	return m_History.GetWindow();
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiNunchuk::GetWindowStats(SMotionStats &stats) const
+{
+	m_History.GetWindowStats(stats);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiNunchuk::GetMotionStats(SMotionStats &stats) const
+{
+	m_History.GetMotionStats(stats);
+}
+
 ////////////////////////////////////////////////////
 void CWR_WiiNunchuk::GetAcceleration(SMotionVec3F &v) const
 {
@@ -15,6 +15,10 @@
 #define _WR_CWIINUNCHUK_H_
 
 #include "Interfaces\WR_IWiiExtension.h"
+#include "WR_CMotionHistory.h"
+#include "WR_CStillDetector.h"
+#include "WR_CActionTable.h"
+#include "WR_CComboEngine.h"
 
 // Location of where calibration data is stored
 #define WR_NUNCHUK_CALIBRATION_LOC (0x04a40020)
@@ -38,6 +42,8 @@ enum WR_NUNCHUK_BUTTONS
 {
 	WR_NCBUTTON_Z = 0x01,			// 'Z' button
 	WR_NCBUTTON_C = 0x02,			// 'C' button
+
+	WR_NCBUTTON_ALL = 0x03,			// Every button
 };
 
 // WR_NUNCHUK_BUTTONS_INDEX
@@ -68,13 +74,12 @@ protected:
 	bool m_bWasUpdated;
 
 	// Button status
-	unsigned int m_nButtons;
-	int m_pButtonStatus[WR_NUNCHUK_BUTTONS_MAX];
-	float m_pButtonBufferedTime[WR_NUNCHUK_BUTTONS_MAX];
+	CWR_ButtonBits m_Buttons;
+	unsigned int m_nChangedButtons; // Since actions were last updated
 
 	// Actions
-	ActionID m_nActionIDSeed;
-	ActionMap m_ActionMap;
+	CWR_ActionTable m_Actions;
+	CWR_ComboEngine m_Combos;
 
 	// Calibration data
 	SMotionVec3 m_vCalibration_ZeroPoint;
@@ -96,9 +101,21 @@ protected:
 	int m_nMinMotionSize;
 	int m_nCurrMotionLifetime;
 	WiiMotionQueue m_MotionQueue;
+	CWR_MotionHistory m_History;
+	CWR_StillDetector m_StillDetector;
+
+	// Elements reported during this update
+	SMotionElement m_Batch[WR_MOTION_MAXBATCHSIZE];
+	int m_nBatchCount;
+
+	// Speculative onset test
+	int m_nOnsetWindow;
+	float m_fOnsetEnergy;
+	int m_nOnsetCount;
+	float m_fOnsetEnergySum;
 
 	// Listeners
-	typedef std::list<IWR_WiiExtensionListener*> Listeners;
+	typedef CWR_ListenerList<IWR_WiiExtensionListener> Listeners;
 	Listeners m_Listeners;
 
 public:
@@ -122,8 +139,11 @@ public:
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIEXTENSION_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiExtensionListener *pListener);
+	virtual void AddListener(IWR_WiiExtensionListener *pListener, unsigned int nEvents = WR_EXTEVENT_DEFAULT);
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -189,6 +209,16 @@ public:
 	////////////////////////////////////////////////////
 	virtual void OnPostUpdate(void);
 
+	////////////////////////////////////////////////////
+	// SetRelay
+	//
+	// Purpose: Hand listener calls to a relay instead
+	//
+	// In:	pRelay - Relay to use, or NULL to call the
+	//			listeners directly
+	////////////////////////////////////////////////////
+	virtual void SetRelay(CWR_InputRelay *pRelay);
+
 public:
 	////////////////////////////////////////////////////
 	// EnableBufferedInput
@@ -246,6 +276,19 @@ public:
 	////////////////////////////////////////////////////
 	virtual int RegisterAction(char const* szName, unsigned int nButtonMask);
 
+	////////////////////////////////////////////////////
+	// RegisterCombo
+	//
+	// Purpose: Register a combo action
+	//
+	// In:	szName - Name of the combo
+	//		combo - Combo definition (see WR_WIIREMOTE_COMBOS)
+	//			using WR_NUNCHUK_BUTTONS
+	//
+	// Returns ID of combo or 0 on error
+	////////////////////////////////////////////////////
+	virtual int RegisterCombo(char const* szName, SWR_WiiButton_Combo const& combo);
+
 	////////////////////////////////////////////////////
 	// GetActionStatus
 	//
@@ -308,6 +351,37 @@ public:
 	////////////////////////////////////////////////////
 	virtual int GetMotionSize(void) const;
 
+	////////////////////////////////////////////////////
+	// SetSpeculativeOnset
+	//
+	// Purpose: Start motions on the first moving update
+	//	instead of waiting for the minimum size. The onset
+	//	is confirmed once the mean energy over the test
+	//	window passes the threshold, otherwise the motion
+	//	is cancelled
+	//
+	// In:	bEnable - TRUE to enable speculative onset
+	//		nWindow - Test window (in consecutive updates)
+	//		fEnergy - Minimum mean energy to confirm
+	////////////////////////////////////////////////////
+	virtual void SetSpeculativeOnset(bool bEnable, int nWindow = WR_MOTION_ONSETWINDOW, float fEnergy = WR_MOTION_ONSETENERGY);
+
+	////////////////////////////////////////////////////
+	// IsSpeculativeOnset
+	//
+	// Purpose: Returns TRUE if speculative onset is enabled
+	////////////////////////////////////////////////////
+	virtual bool IsSpeculativeOnset(void) const;
+
+	////////////////////////////////////////////////////
+	// IsSpeculative
+	//
+	// Purpose: Returns TRUE while the active motion was
+	//	started speculatively and its onset test has not
+	//	confirmed it yet
+	////////////////////////////////////////////////////
+	virtual bool IsSpeculative(void) const;
+
 	////////////////////////////////////////////////////
 	// IsMotionActive
 	//
@@ -323,6 +397,45 @@ public:
 	////////////////////////////////////////////////////
 	virtual int GetMotionLifetime(void) const;
 
+	////////////////////////////////////////////////////
+	// SetStatsWindow
+	//
+	// Purpose: Set the size of the sliding window used
+	//	by GetWindowStats
+	//
+	// In:	nSize - Size (in number of consecutive updates)
+	//
+	// Note: Size is clamped to [2, WR_MOTION_HISTORYSIZE]
+	////////////////////////////////////////////////////
+	virtual void SetStatsWindow(int nSize);
+
+	////////////////////////////////////////////////////
+	// GetStatsWindow
+	//
+	// Purpose: Get the size of the sliding window used
+	//	by GetWindowStats
+	////////////////////////////////////////////////////
+	virtual int GetStatsWindow(void) const;
+
+	////////////////////////////////////////////////////
+	// GetWindowStats
+	//
+	// Purpose: Get statistics over the newest updates
+	//
+	// Out:	stats - Statistics, including the last update
+	////////////////////////////////////////////////////
+	virtual void GetWindowStats(SMotionStats &stats) const;
+
+	////////////////////////////////////////////////////
+	// GetMotionStats
+	//
+	// Purpose: Get statistics over the current motion
+	//
+	// Out:	stats - Statistics since the remote was last
+	//			still, including the last update
+	////////////////////////////////////////////////////
+	virtual void GetMotionStats(SMotionStats &stats) const;
+
 	////////////////////////////////////////////////////
 	// GetAcceleration
 	//
@@ -409,6 +522,16 @@ protected:
 	////////////////////////////////////////////////////
 	static void OnCalibrateData(int nAddr, int nSize, LPWiiIOData pData, WiiIOCallBackParam pParam);
 
+	////////////////////////////////////////////////////
+	// ApplyCalibration
+	//
+	// Purpose: Use a calibration block read from the
+	//	device or the calibration cache
+	//
+	// In:	pData - Calibration block
+	////////////////////////////////////////////////////
+	virtual void ApplyCalibration(LPWiiIOData pData);
+
 	////////////////////////////////////////////////////
 	// DecryptBuffer
 	//
@@ -428,6 +551,34 @@ protected:
 	//	current motion
 	////////////////////////////////////////////////////
 	virtual void StopMotion(void);
+
+	////////////////////////////////////////////////////
+	// CancelMotion
+	//
+	// Purpose: Report that a speculative motion failed
+	//	its onset test and clean up
+	//
+	// In:	element - Element that failed the test
+	////////////////////////////////////////////////////
+	virtual void CancelMotion(SMotionElement const& element);
+
+	////////////////////////////////////////////////////
+	// FlushBatch
+	//
+	// Purpose: Send the elements batched so far to the
+	//	listeners subscribed to batches
+	////////////////////////////////////////////////////
+	virtual void FlushBatch(void);
+
+	////////////////////////////////////////////////////
+	// SignalButtons
+	//
+	// Purpose: Signal the listeners of buttons whose
+	//	status changed
+	//
+	// In:	nChanged - Buttons whose status changed
+	////////////////////////////////////////////////////
+	virtual void SignalButtons(unsigned int nChanged);
 };
 
 #endif //_WR_CWIINUNCHUK_H_
\ No newline at end of file
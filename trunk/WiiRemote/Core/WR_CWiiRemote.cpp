@@ -90,6 +90,11 @@ CWR_WiiRemote::CWR_WiiRemote(void)
 	m_fStatusUpdateFreq = 0.0f;
 	m_fNextStatusUpdate = 0.0f;
 
+	memset(&m_Snapshot, 0, sizeof(SInputSnapshot));
+	m_nSnapshotStamp = 0;
+	m_fLastRecvTime = 0.0f;
+	m_pRelay = NULL;
+
 	InitializeCriticalSection(&_WROCS);
 	InitializeCriticalSection(&_WRICS);
 }
@@ -98,6 +103,7 @@ CWR_WiiRemote::CWR_WiiRemote(void)
 CWR_WiiRemote::~CWR_WiiRemote(void)
 {
 	Shutdown();
+	SetDeferredListeners(false);
 	DeleteCriticalSection(&_WROCS);
 	DeleteCriticalSection(&_WRICS);
 }
@@ -133,25 +139,69 @@ IWR_WiiSensor* CWR_WiiRemote::GetSensorHelper(void) const
 }
 
 ////////////////////////////////////////////////////
-void CWR_WiiRemote::AddListener(IWR_WiiRemoteListener *pListener)
+IWR_EventJournal const* CWR_WiiRemote::GetJournal(void) const
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-			return;
-	m_Listeners.push_back(pListener);
+	return &m_Journal;
 }
 
 ////////////////////////////////////////////////////
-void CWR_WiiRemote::RemoveListener(IWR_WiiRemoteListener *pListener)
+bool CWR_WiiRemote::GetSnapshot(SInputSnapshot &snapshot) const
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
+	while (true)
+	{
+		// Copy it, then make sure it wasn't rewritten while copying
+		const LONG nStamp = m_nSnapshotStamp;
+		if (0 == (nStamp&1))
 		{
-			m_Listeners.erase(itI);
-			return;
+			snapshot = m_Snapshot;
+			MemoryBarrier();
+			if (m_nSnapshotStamp == nStamp)
+				return (0 != nStamp);
 		}
+		YieldProcessor();
+	}
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiRemote::SetDeferredListeners(bool bDefer)
+{
+	if (bDefer == IsDeferredListeners()) return;
+	if (true == bDefer)
+	{
+		m_pRelay = new CWR_InputRelay;
+		AttachRelay(m_pRelay);
+	}
+	else
+	{
+		// Make what is still waiting before calling directly again
+		AttachRelay(NULL);
+		m_pRelay->Replay();
+		SAFE_DELETE(m_pRelay);
+	}
+}
+
+////////////////////////////////////////////////////
+bool CWR_WiiRemote::IsDeferredListeners(void) const
+{
+	return (NULL != m_pRelay);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiRemote::DispatchDeferred(void)
+{
+	if (NULL != m_pRelay) m_pRelay->Replay();
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiRemote::AddListener(IWR_WiiRemoteListener *pListener, unsigned int nEvents)
+{
+	m_Listeners.Add(pListener, nEvents);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiRemote::RemoveListener(IWR_WiiRemoteListener *pListener)
+{
+	m_Listeners.Remove(pListener);
 }
 
 ////////////////////////////////////////////////////
@@ -160,6 +210,7 @@ int CWR_WiiRemote::Initialize(char const* szDevicePath, RemoteID const& nID)
 	if (REMOTEID_INVALID != m_nID || REMOTEID_INVALID == nID)
 		WR_RAISEERROR(WR_WIIREMOTE_BADINIT);
 	m_nID = nID;
+	m_szDevicePath = szDevicePath;
 
 	// Create helpers
 	m_pButtons = (CWR_WiiButtons*)CreateButtonHelper();
@@ -174,6 +225,7 @@ int CWR_WiiRemote::Initialize(char const* szDevicePath, RemoteID const& nID)
 	m_pSensor = (CWR_WiiSensor*)CreateSensorHelper();
 	if (NULL == m_pSensor || false == m_pSensor->Initialize(this))
 		WR_RAISEERROR(WR_WIIREMOTE_BADSENSOR);
+	if (NULL != m_pRelay) AttachRelay(m_pRelay);
 
 	// Create handle to device
 	m_hHandle = CreateFile(szDevicePath, (GENERIC_READ|GENERIC_WRITE),
@@ -211,7 +263,7 @@ void CWR_WiiRemote::Reconnect(bool bKeepReport)
 	SetReport_Connect(bKeepReport?m_nReportMode:WR_REPORT_DEFAULT);
 
 	// Report we are trying to connect
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+	for (Listeners::Dispatch itI(m_Listeners, WR_REMOTEEVENT_CONNECTING); itI; ++itI)
 		(*itI)->OnConnecting(this);
 }
 
@@ -266,6 +318,9 @@ void CWR_WiiRemote::Shutdown(void)
 	// Kill flags
 	m_nFlags = 0;
 
+	// Make the deferred calls while the helpers they came from are still around
+	if (NULL != m_pRelay) m_pRelay->Replay();
+
 	// Kill helpers
 	if (NULL != m_pButtons)
 	{
@@ -294,7 +349,7 @@ void CWR_WiiRemote::Shutdown(void)
 	}
 
 	// Report we disconnected
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+	for (Listeners::Dispatch itI(m_Listeners, WR_REMOTEEVENT_DISCONNECT); itI; ++itI)
 		(*itI)->OnDisconnect(this, false);
 }
 
@@ -319,6 +374,12 @@ RemoteID const& CWR_WiiRemote::GetID(void) const
 	return m_nID;
 }
 
+////////////////////////////////////////////////////
+char const* CWR_WiiRemote::GetDevicePath(void) const
+{
+	return m_szDevicePath.c_str();
+}
+
 ////////////////////////////////////////////////////
 void CWR_WiiRemote::SetReport(int nReport, bool bContinuous)
 {
@@ -336,7 +397,7 @@ void CWR_WiiRemote::SetReport(int nReport, bool bContinuous)
 	if (m_nReportMode != nPrevReport || bContinuous != bPrevContinuous)
 	{
 		// Changed
-		for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+		for (Listeners::Dispatch itI(m_Listeners, WR_REMOTEEVENT_REPORTCHANGED); itI; ++itI)
 			(*itI)->OnReportChanged(this, m_nReportMode, bContinuous);
 	}
 
@@ -380,6 +441,9 @@ bool CWR_WiiRemote::IsContinuousReport(void) const
 ////////////////////////////////////////////////////
 void CWR_WiiRemote::SetStatusUpdate(float fFreq)
 {
+	// Input thread may be changing the flags
+	g_pWR->LockInput();
+
 	m_fStatusUpdateFreq = fFreq;
 	if (fFreq > 0.0f)
 	{
@@ -390,54 +454,70 @@ void CWR_WiiRemote::SetStatusUpdate(float fFreq)
 	{
 		SetFlags(WRF_UPDATESTATUS, false);
 	}
+
+	g_pWR->UnlockInput();
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiRemote::RequestStatusUpdate(void)
 {
+	// Input thread may be writing too
+	g_pWR->LockInput();
+
 	// Must be connected
-	if (false == CheckFlags(WRF_CONNECTED))
-		return;
+	if (true == CheckFlags(WRF_CONNECTED))
+	{
+		DataBuffer buffer;
+		buffer[0] = WR_OUT_STATUS;
+		buffer[1] = GetRumbleBit();
+		WriteData(buffer);
+	}
 
-	DataBuffer buffer;
-	buffer[0] = WR_OUT_STATUS;
-	buffer[1] = GetRumbleBit();
-	WriteData(buffer);
+	g_pWR->UnlockInput();
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiRemote::SetLEDs(int nOnLEDs)
 {
+	// Input thread may be writing too
+	g_pWR->LockInput();
+
 	// Must be connected
-	if (false == CheckFlags(WRF_CONNECTED))
-		return;
+	if (true == CheckFlags(WRF_CONNECTED))
+	{
+		DataBuffer buffer;
+		buffer[0] = WR_OUT_LED;
+		buffer[1] = (nOnLEDs&0xF0) | GetRumbleBit();
+		WriteData(buffer);
+	}
 
-	DataBuffer buffer;
-	buffer[0] = WR_OUT_LED;
-	buffer[1] = (nOnLEDs&0xF0) | GetRumbleBit();
-	WriteData(buffer);
+	g_pWR->UnlockInput();
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiRemote::SetRumble(bool bOn)
 {
+	// Input thread may be changing the flags and journal
+	g_pWR->LockInput();
+
 	// Must be connected
-	if (false == CheckFlags(WRF_CONNECTED))
-		return;
+	if (true == CheckFlags(WRF_CONNECTED))
+	{
+		// Set flag
+		SetFlags(WRF_RUMBLEON, bOn);
+		SetFlags(WRF_STATUS_RUMBLE, bOn);
 
-	// Set flag
-	SetFlags(WRF_RUMBLEON, bOn);
-	SetFlags(WRF_STATUS_RUMBLE, bOn);
+		// Send packet through IR channel now
+		DataBuffer buffer;
+		buffer[0] = WR_OUT_SPEAKER;
+		buffer[1] = GetRumbleBit();
+		WriteData(buffer);
 
-	// Send packet through IR channel now
-	DataBuffer buffer;
-	buffer[0] = WR_OUT_SPEAKER;
-	buffer[1] = GetRumbleBit();
-	WriteData(buffer);
+		// Signal a change
+		SignalStatus();
+	}
 
-	// Signal a change
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		(*itI)->OnStatusUpdate(this, m_nFlags, m_nBattery);
+	g_pWR->UnlockInput();
 }
 
 ////////////////////////////////////////////////////
@@ -476,6 +556,7 @@ void CWR_WiiRemote::Update(void)
 		if (true == bParse)
 		{
 			m_fLastRecv = fCurrTick;
+			m_fLastRecvTime = buffer.fRecvTime;
 
 			// If we were attempting a connection, we succedded
 			if (true == CheckFlags(WRF_ATTEMPTCONNECT))
@@ -488,7 +569,7 @@ void CWR_WiiRemote::Update(void)
 				Reset();
 
 				// Report we connected
-				for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+				for (Listeners::Dispatch itI(m_Listeners, WR_REMOTEEVENT_CONNECT); itI; ++itI)
 					(*itI)->OnConnect(this);
 			}
 
@@ -523,7 +604,7 @@ void CWR_WiiRemote::Update(void)
 				if (WR_REPORT_IR == (nOpCode&WR_REPORT_IR) && NULL != m_pSensor)
 				{
 					m_pSensor->OnSensorUpdate(buffer, nOffset, fCurrTick);
-					nOffset += 10; // 10 bytes used for IR data
+					nOffset += m_pSensor->GetDataSize(); // IR data size depends on sensor mode
 				}
 				if (WR_REPORT_EXTENSION == (nOpCode&WR_REPORT_EXTENSION) && NULL != m_pExtension)
 				{
@@ -567,16 +648,17 @@ void CWR_WiiRemote::Update(void)
 			if (NULL != m_pExtension)
 			{
 				// Report extension destroyed
-				for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+				for (Listeners::Dispatch itI(m_Listeners, WR_REMOTEEVENT_EXTENSIONUNPLUGGED); itI; ++itI)
 					(*itI)->OnExtensionUnplugged(this, m_pExtension);
 
 				m_pExtension->Shutdown();
-				SAFE_DELETE(m_pExtension);
+				RetireExtension();
 			}
 
 			// Report we failed to connect
-			for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+			for (Listeners::Dispatch itI(m_Listeners, WR_REMOTEEVENT_DISCONNECT); itI; ++itI)
 				(*itI)->OnDisconnect(this, true);
+			PublishSnapshot();
 			return;
 		}
 	}
@@ -587,6 +669,8 @@ void CWR_WiiRemote::Update(void)
 		RequestStatusUpdate();
 		m_fNextStatusUpdate = fCurrTick + m_fStatusUpdateFreq;
 	}
+
+	PublishSnapshot();
 }
 
 ////////////////////////////////////////////////////
@@ -612,8 +696,7 @@ void CWR_WiiRemote::UpdateStatus(DataBuffer const& buffer)
 	if (nPrevFlags != nCurrFlags || m_nBattery != nPrevBattery)
 	{
 		// Signal a change
-		for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-			(*itI)->OnStatusUpdate(this, m_nFlags, m_nBattery);
+		SignalStatus();
 	}
 
 	// Extension status updated?
@@ -632,11 +715,11 @@ void CWR_WiiRemote::UpdateStatus(DataBuffer const& buffer)
 	else if (false == CheckFlags(WRF_STATUS_EXPANSION) && NULL != m_pExtension)
 	{
 		// Report extension destroyed
-		for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+		for (Listeners::Dispatch itI(m_Listeners, WR_REMOTEEVENT_EXTENSIONUNPLUGGED); itI; ++itI)
 			(*itI)->OnExtensionUnplugged(this, m_pExtension);
 
 		// Destroy the extension
-		SAFE_DELETE(m_pExtension);
+		RetireExtension();
 		SetFlags(WRF_CHECKEDEXT, false);
 	}
 }
@@ -655,9 +738,10 @@ void CWR_WiiRemote::OnDataRead(DataBuffer const& buffer)
 		{
 			SetFlags(WRF_CHECKEDEXT, true);
 			m_pExtension->Initialize(this);
+			if (NULL != m_pRelay) m_pExtension->SetRelay(m_pRelay);
 
 			// Report extension created
-			for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+			for (Listeners::Dispatch itI(m_Listeners, WR_REMOTEEVENT_EXTENSIONPLUGGEDIN); itI; ++itI)
 				(*itI)->OnExtensionPluggedIn(this, m_pExtension);
 		}
 	}
@@ -672,6 +756,99 @@ void CWR_WiiRemote::SetFlags(unsigned int nFlags, bool bOn)
 		m_nFlags = CLEAR_BITS(nFlags,m_nFlags);
 }
 
+////////////////////////////////////////////////////
+void CWR_WiiRemote::SignalStatus(void)
+{
+	SJournalEvent event;
+	event.nType = WR_JOURNAL_STATUS;
+	event.nSource = WR_JOURNAL_REMOTE;
+	event.fTime = g_pWR->pTimer->GetPreciseTime();
+	event.data.status.nFlags = (int)m_nFlags;
+	event.data.status.nBattery = (int)m_nBattery;
+	m_Journal.Publish(event);
+
+	for (Listeners::Dispatch itI(m_Listeners, WR_REMOTEEVENT_STATUSUPDATE); itI; ++itI)
+		(*itI)->OnStatusUpdate(this, m_nFlags, m_nBattery);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiRemote::PublishSnapshot(void)
+{
+	SInputSnapshot snapshot;
+	memset(&snapshot, 0, sizeof(SInputSnapshot));
+	snapshot.nSeq = m_Snapshot.nSeq+1;
+	snapshot.fTime = m_fLastRecvTime;
+	snapshot.nFlags = m_nFlags;
+	snapshot.nBattery = m_nBattery;
+
+	// Remote input
+	if (NULL != m_pButtons)
+		snapshot.nButtons = m_pButtons->m_Buttons.GetHeld()|m_pButtons->m_Buttons.GetReleased();
+	if (NULL != m_pMotion)
+	{
+		snapshot.fPitch = m_pMotion->GetPitch();
+		snapshot.fRoll = m_pMotion->GetRoll();
+		snapshot.fAccelX = m_pMotion->GetAccelerationX();
+		snapshot.fAccelY = m_pMotion->GetAccelerationY();
+		snapshot.fAccelZ = m_pMotion->GetAccelerationZ();
+		snapshot.nMotionLifetime = m_pMotion->GetMotionLifetime();
+	}
+	if (NULL != m_pSensor)
+	{
+		snapshot.bOnScreen = m_pSensor->m_bOnScreen;
+		snapshot.fCursorX = m_pSensor->m_fX;
+		snapshot.fCursorY = m_pSensor->m_fY;
+	}
+
+	// Extension input
+	if (NULL != m_pExtension)
+	{
+		snapshot.bExtension = true;
+		snapshot.nExtensionType = m_pExtension->GetType();
+		if (CWR_WiiNunchuk::TYPE == snapshot.nExtensionType)
+		{
+			CWR_WiiNunchuk *pNunchuk = (CWR_WiiNunchuk*)m_pExtension;
+			for (unsigned int nButton = WR_NCBUTTON_Z; nButton <= WR_NCBUTTON_C; nButton <<= 1)
+				if (true == pNunchuk->IsButtonDown(nButton)) snapshot.nExtButtons |= nButton;
+			snapshot.fExtPitch = pNunchuk->GetPitch();
+			snapshot.fExtRoll = pNunchuk->GetRoll();
+			snapshot.fAnalogX = pNunchuk->GetAnalogX();
+			snapshot.fAnalogY = pNunchuk->GetAnalogY();
+			snapshot.nExtMotionLifetime = pNunchuk->GetMotionLifetime();
+		}
+	}
+
+	// Only the updating thread writes, so mark it as being written,
+	//	fill it in and publish it
+	InterlockedIncrement(&m_nSnapshotStamp);
+	m_Snapshot = snapshot;
+	InterlockedIncrement(&m_nSnapshotStamp);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiRemote::AttachRelay(CWR_InputRelay *pRelay)
+{
+	m_Listeners.SetRelay(pRelay);
+	if (NULL != pRelay) pRelay->Attach(&m_Listeners);
+	if (NULL != m_pButtons) m_pButtons->SetRelay(pRelay);
+	if (NULL != m_pMotion) m_pMotion->SetRelay(pRelay);
+	if (NULL != m_pData) m_pData->SetRelay(pRelay);
+	if (NULL != m_pSensor) m_pSensor->SetRelay(pRelay);
+	if (NULL != m_pExtension) m_pExtension->SetRelay(pRelay);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiRemote::RetireExtension(void)
+{
+	if (NULL != m_pRelay)
+	{
+		m_pRelay->Retire(m_pExtension);
+		m_pExtension = NULL;
+	}
+	else
+		SAFE_DELETE(m_pExtension);
+}
+
 ////////////////////////////////////////////////////
 unsigned char CWR_WiiRemote::GetRumbleBit(void) const
 {
@@ -780,9 +957,11 @@ unsigned int __stdcall CWR_WiiRemote::WRIThreadProc(void *pThis)
 		if (TRUE == ReadFile(pRemote->m_hHandle, buffer, buffer, &dwReadSize, pOverlapped))
 		{
 			// Read the data into the read buffer
+			buffer.fRecvTime = g_pWR->pTimer->GetPreciseTime();
 			EnterCriticalSection(&pRemote->_WRICS);
 			pRemote->_ReadQueue.push(buffer);
 			LeaveCriticalSection(&pRemote->_WRICS);
+			g_pWR->SignalInput();
 		}
 		else
 		{
@@ -800,9 +979,11 @@ unsigned int __stdcall CWR_WiiRemote::WRIThreadProc(void *pThis)
 				}
 
 				// Read the data into the read buffer
+				buffer.fRecvTime = g_pWR->pTimer->GetPreciseTime();
 				EnterCriticalSection(&pRemote->_WRICS);
 				pRemote->_ReadQueue.push(buffer);
 				LeaveCriticalSection(&pRemote->_WRICS);
+				g_pWR->SignalInput();
 			}
 		}
 	}
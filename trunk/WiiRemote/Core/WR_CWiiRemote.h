@@ -14,6 +14,9 @@
 #define _WR_CWIIREMOTE_H_
 
 #include "Interfaces\WR_IWiiRemote.h"
+#include "WR_CEventJournal.h"
+#include "WR_CInputRelay.h"
+
 class CWR_WiiRemote : public IWR_WiiRemote
 {
 	SETUP_WR_MODULE();
@@ -22,12 +25,14 @@ class CWR_WiiRemote : public IWR_WiiRemote
 	friend class CWR_WiiMotion;
 	friend class CWR_WiiData;
 	friend class CWR_WiiSensor;
+	friend class CWR_WiiNunchuk;
 
 protected:
 	unsigned int m_nBattery;		// Last known battery life
 	unsigned int m_nReportMode;		// Current report mode
 	unsigned int m_nFlags;			// Status flags (see WR_WIIREMOTE_FLAGS)
 	RemoteID m_nID;					// remote ID
+	std::string m_szDevicePath;		// Device path
 	HANDLE m_hHandle;				// Remote handle
 
 	// Helpers
@@ -39,6 +44,18 @@ protected:
 	// Extension helpder
 	IWR_WiiExtension *m_pExtension;
 
+	// Input events published by the helpers
+	CWR_EventJournal m_Journal;
+
+	// Input state published at the end of each update. The
+	//	stamp is odd while it is being written
+	SInputSnapshot m_Snapshot;
+	volatile LONG m_nSnapshotStamp;
+	float m_fLastRecvTime;
+
+	// Records listener calls while they are deferred
+	CWR_InputRelay *m_pRelay;
+
 	// Connection values
 	float m_fAttemptConnectStart;
 	float m_fLastRecv;
@@ -57,7 +74,7 @@ protected:
 	unsigned int m_dwWRIThreadID;
 
 	// Listeners
-	typedef std::list<IWR_WiiRemoteListener*> Listeners;
+	typedef CWR_ListenerList<IWR_WiiRemoteListener> Listeners;
 	Listeners m_Listeners;
 
 protected:
@@ -176,14 +193,63 @@ public:
 	////////////////////////////////////////////////////
 	virtual IWR_WiiSensor* GetSensorHelper(void) const;
 
+	////////////////////////////////////////////////////
+	// GetJournal
+	//
+	// Purpose: Return the journal of input events
+	//
+	// Note: See IWR_EventJournal
+	////////////////////////////////////////////////////
+	virtual IWR_EventJournal const* GetJournal(void) const;
+
+	////////////////////////////////////////////////////
+	// GetSnapshot
+	//
+	// Purpose: Copy out the input state published at the
+	//	end of the last update
+	//
+	// Out:	snapshot - Input state
+	//
+	// Returns TRUE if an update has published one yet
+	////////////////////////////////////////////////////
+	virtual bool GetSnapshot(SInputSnapshot &snapshot) const;
+
+	////////////////////////////////////////////////////
+	// SetDeferredListeners
+	//
+	// Purpose: Hold on to listener calls made during
+	//	updates until DispatchDeferred is called
+	//
+	// In:	bDefer - TRUE to defer, FALSE to call listeners
+	//			directly again
+	////////////////////////////////////////////////////
+	virtual void SetDeferredListeners(bool bDefer);
+
+	////////////////////////////////////////////////////
+	// IsDeferredListeners
+	//
+	// Purpose: Returns TRUE if listener calls are deferred
+	////////////////////////////////////////////////////
+	virtual bool IsDeferredListeners(void) const;
+
+	////////////////////////////////////////////////////
+	// DispatchDeferred
+	//
+	// Purpose: Make the listener calls deferred so far
+	////////////////////////////////////////////////////
+	virtual void DispatchDeferred(void);
+
 	////////////////////////////////////////////////////
 	// AddListener
 	//
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIIREMOTE_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiRemoteListener *pListener);
+	virtual void AddListener(IWR_WiiRemoteListener *pListener, unsigned int nEvents = WR_REMOTEEVENT_DEFAULT);
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -311,6 +377,9 @@ public:
 	// RequestStatusUpdate
 	//
 	// Purpose: Request a status update now
+	//
+	// Note: Holds LockInput, safe to call from the game
+	//	thread while input is threaded
 	////////////////////////////////////////////////////
 	virtual void RequestStatusUpdate(void);
 
@@ -320,6 +389,8 @@ public:
 	// Purpose: Turn on/off LED lights
 	//
 	// In:	nOnLEDs - Lights to turn on (see WR_LED)
+	//
+	// Note: Holds LockInput, see RequestStatusUpdate
 	////////////////////////////////////////////////////
 	virtual void SetLEDs(int nOnLEDs);
 
@@ -329,6 +400,8 @@ public:
 	// Purpose: Turn on/off the Rumble feature
 	//
 	// In:	bOn - TRUE to turn on, FALSE to turn off
+	//
+	// Note: Holds LockInput, see RequestStatusUpdate
 	////////////////////////////////////////////////////
 	virtual void SetRumble(bool bOn);
 
@@ -353,6 +426,14 @@ public:
 	////////////////////////////////////////////////////
 	virtual RemoteID const& GetID(void) const;
 
+	////////////////////////////////////////////////////
+	// GetDevicePath
+	//
+	// Purpose: Returns the device path the remote was
+	//	initialized with
+	////////////////////////////////////////////////////
+	virtual char const* GetDevicePath(void) const;
+
 	////////////////////////////////////////////////////
 	// CheckFlags
 	//
@@ -387,6 +468,46 @@ protected:
 	////////////////////////////////////////////////////
 	virtual void SetFlags(unsigned int nFlags, bool bOn = true);
 
+	////////////////////////////////////////////////////
+	// SignalStatus
+	//
+	// Purpose: Publish the status and signal the listeners
+	//	that it changed
+	////////////////////////////////////////////////////
+	virtual void SignalStatus(void);
+
+	////////////////////////////////////////////////////
+	// PublishSnapshot
+	//
+	// Purpose: Publish the input state at the end of an
+	//	update
+	//
+	// Note: Only the thread updating the remote may publish
+	////////////////////////////////////////////////////
+	virtual void PublishSnapshot(void);
+
+	////////////////////////////////////////////////////
+	// AttachRelay
+	//
+	// Purpose: Hand the listener calls of the remote and
+	//	its helpers to a relay
+	//
+	// In:	pRelay - Relay to use, or NULL to call the
+	//			listeners directly
+	////////////////////////////////////////////////////
+	virtual void AttachRelay(CWR_InputRelay *pRelay);
+
+	////////////////////////////////////////////////////
+	// RetireExtension
+	//
+	// Purpose: Let go of the extension helper once it
+	//	is unplugged
+	//
+	// Note: Deferred listeners may still be handed the
+	//	extension, so it is kept until they have been
+	////////////////////////////////////////////////////
+	virtual void RetireExtension(void);
+
 	////////////////////////////////////////////////////
 	// GetRumbleBit
 	//
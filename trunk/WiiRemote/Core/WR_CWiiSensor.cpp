@@ -22,17 +22,14 @@ CWR_WiiSensor::CWR_WiiSensor(void)
 	m_pRemote = NULL;
 	m_bWasUpdated = false;
 	m_bEnabled = false;
-	for (int i = 0; i < 4; i++)
-	{
-		m_SensorDots[i].bTargeted = false;
-		m_SensorDots[i].nRawX = 0x3FF;
-		m_SensorDots[i].nRawY = 0x3FF;
-	}
+	m_nMode = WR_SENSORMODE_POS;
+	ResetDots();
 
 	m_bOnScreen = false;
 	m_fLastOnScreenTime = 0.0f;
 	m_fX = 0.0f;
 	m_fY = 0.0f;
+	m_bFilterCursor = true;
 }
 
 ////////////////////////////////////////////////////
@@ -49,17 +46,14 @@ bool CWR_WiiSensor::Initialize(IWR_WiiRemote *pRemote)
 
 	// Reset data
 	m_bEnabled = false;
-	for (int i = 0; i < 4; i++)
-	{
-		m_SensorDots[i].bTargeted = false;
-		m_SensorDots[i].nRawX = 0x3FF;
-		m_SensorDots[i].nRawY = 0x3FF;
-	}
+	m_nMode = WR_SENSORMODE_POS;
+	ResetDots();
 
 	m_bOnScreen = false;
 	m_fLastOnScreenTime = 0.0f;
 	m_fX = 0.0f;
 	m_fY = 0.0f;
+	m_bFilterCursor = true;
 
 	return true;
 }
@@ -70,59 +64,271 @@ void CWR_WiiSensor::Shutdown(void)
 	m_pRemote = NULL;
 }
 
+////////////////////////////////////////////////////
+void CWR_WiiSensor::ResetDots(void)
+{
+	for (int i = 0; i < WR_WIISENSOR_DOTS; i++)
+	{
+		m_SensorDots[i].bTargeted = false;
+		m_SensorDots[i].nRawX = WR_WIISENSOR_NODOT;
+		m_SensorDots[i].nRawY = WR_WIISENSOR_NODOT;
+		m_SensorDots[i].nSize = 0;
+	}
+	memset(&m_FullDots, 0, sizeof(SSensorDots));
+
+	memset(&m_Bar, 0, sizeof(SSensorBar));
+	m_nBarDots[0] = m_nBarDots[1] = -1;
+	memset(m_fBarOffset, 0, sizeof(m_fBarOffset));
+	m_CursorFilter.Reset();
+	m_nHistoryHead = 0;
+	m_nHistoryCount = 0;
+}
+
+////////////////////////////////////////////////////
+int CWR_WiiSensor::GetDataSize(void) const
+{
+	switch (m_nMode)
+	{
+		case WR_SENSORMODE_POSSIZE: return 12;
+		case WR_SENSORMODE_ALL: return 18; // Half of the dots per report
+	}
+	return 10;
+}
+
 ////////////////////////////////////////////////////
 void CWR_WiiSensor::OnSensorUpdate(struct DataBuffer const& buffer, int nOffset, float fCurrTick)
 {
-	m_SensorDots[0].bTargeted = false;
-	m_SensorDots[1].bTargeted = false;
-	m_SensorDots[2].bTargeted = false;
-	m_SensorDots[3].bTargeted = false;
+	// Filter against when the report came in, not when it was parsed
+	const float fTime = (buffer.fRecvTime > 0.0f ? buffer.fRecvTime : g_pWR->pTimer->GetPreciseTime());
 
-	// Parse each dot in the data
-	if (buffer[nOffset+0] != 0xFF || buffer[nOffset+1] != 0xFF)
+	if (WR_SENSORMODE_ALL == m_nMode)
+	{
+		// First report holds dots 0 and 1, second holds 2 and 3
+		const int nHalf = (buffer[0]&0x01);
+		WR_UnpackSensorDots(&buffer[nOffset], m_nMode, m_FullDots, nHalf*2);
+		if (1 == nHalf)
+		{
+			TrackDots(m_FullDots);
+			UpdateCursor(fTime);
+		}
+	}
+	else
 	{
-		m_SensorDots[0].bTargeted = true;
-		m_SensorDots[0].nRawX = buffer[nOffset+0] | (((buffer[nOffset+2]>>4)&0x3) << 8);
-		m_SensorDots[0].nRawY = buffer[nOffset+1] | (((buffer[nOffset+2]>>6)&0x3) << 8);
+		SSensorDots dots;
+		WR_UnpackSensorDots(&buffer[nOffset], m_nMode, dots);
+		TrackDots(dots);
+		UpdateCursor(fTime);
 	}
-	if (buffer[nOffset+3] != 0xFF || buffer[nOffset+4] != 0xFF)
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiSensor::TrackDots(SSensorDots const& dots)
+{
+	bool bMatchedNew[WR_WIISENSOR_DOTS] = {false};
+	bool bMatchedOld[WR_WIISENSOR_DOTS] = {false};
+
+	// Match the closest pair left each pass, so two dots
+	//	crossing over do not steal each other
+	while (true)
 	{
-		m_SensorDots[1].bTargeted = true;
-		m_SensorDots[1].nRawX = buffer[nOffset+3] | (((buffer[nOffset+2]>>0)&0x3) << 8);
-		m_SensorDots[1].nRawY = buffer[nOffset+4] | (((buffer[nOffset+2]>>2)&0x3) << 8);
+		float fBest = WR_WIISENSOR_TRACKDIST*WR_WIISENSOR_TRACKDIST;
+		int nOld = -1, nNew = -1;
+		for (int i = 0; i < WR_WIISENSOR_DOTS; i++)
+		{
+			if (false == m_SensorDots[i].bTargeted || true == bMatchedOld[i]) continue;
+			for (int j = 0; j < WR_WIISENSOR_DOTS; j++)
+			{
+				if (0 == (dots.nFound&(1<<j)) || true == bMatchedNew[j]) continue;
+				const float fX = float(dots.nX[j]-m_SensorDots[i].nRawX);
+				const float fY = float(dots.nY[j]-m_SensorDots[i].nRawY);
+				const float fDist = (fX*fX)+(fY*fY);
+				if (fDist < fBest)
+				{
+					fBest = fDist;
+					nOld = i;
+					nNew = j;
+				}
+			}
+		}
+		if (nOld < 0) break;
+
+		m_SensorDots[nOld].nRawX = dots.nX[nNew];
+		m_SensorDots[nOld].nRawY = dots.nY[nNew];
+		m_SensorDots[nOld].nSize = dots.nSize[nNew];
+		bMatchedOld[nOld] = true;
+		bMatchedNew[nNew] = true;
 	}
-	/*if (buffer[nOffset+5] != 0xFF || buffer[nOffset+6] != 0xFF)
+
+	// Dots no longer seen give up their identity
+	for (int i = 0; i < WR_WIISENSOR_DOTS; i++)
 	{
-		m_SensorDots[2].bTargeted = true;
-		m_SensorDots[2].nRawX = buffer[nOffset+5] | (((buffer[nOffset+7]>>4)&0x3) << 8);
-		m_SensorDots[2].nRawY = buffer[nOffset+6] | (((buffer[nOffset+7]>>6)&0x3) << 8);
+		if (false == bMatchedOld[i])
+			m_SensorDots[i].bTargeted = false;
 	}
-	if (buffer[nOffset+8] != 0xFF || buffer[nOffset+9] != 0xFF)
+
+	// New dots take over a free identity
+	for (int j = 0; j < WR_WIISENSOR_DOTS; j++)
 	{
-		m_SensorDots[3].bTargeted = true;
-		m_SensorDots[3].nRawX = buffer[nOffset+8] | (((buffer[nOffset+7]>>0)&0x3) << 8);
-		m_SensorDots[3].nRawY = buffer[nOffset+9] | (((buffer[nOffset+7]>>2)&0x3) << 8);
-	}*/
+		if (0 == (dots.nFound&(1<<j)) || true == bMatchedNew[j]) continue;
+		for (int i = 0; i < WR_WIISENSOR_DOTS; i++)
+		{
+			if (false == m_SensorDots[i].bTargeted)
+			{
+				m_SensorDots[i].bTargeted = true;
+				m_SensorDots[i].nRawX = dots.nX[j];
+				m_SensorDots[i].nRawY = dots.nY[j];
+				m_SensorDots[i].nSize = dots.nSize[j];
+				break;
+			}
+		}
+	}
+
+	UpdateBar();
 }
 
 ////////////////////////////////////////////////////
-void CWR_WiiSensor::OnPostUpdate(void)
+void CWR_WiiSensor::UpdateBar(void)
 {
-	if (m_SensorDots[0].bTargeted || m_SensorDots[1].bTargeted || 
-		m_SensorDots[2].bTargeted || m_SensorDots[3].bTargeted)
+	m_Bar.nDots = 0;
+	for (int i = 0; i < WR_WIISENSOR_DOTS; i++)
+	{
+		if (true == m_SensorDots[i].bTargeted)
+			m_Bar.nDots++;
+	}
+
+	int nA = m_nBarDots[0], nB = m_nBarDots[1];
+	bool bA = (nA >= 0 && true == m_SensorDots[nA].bTargeted);
+	bool bB = (nB >= 0 && true == m_SensorDots[nB].bTargeted);
+
+	// Keep the same ends while both are seen, otherwise use the widest
+	//	pair so stray reflections between them are ignored
+	if ((false == bA || false == bB) && m_Bar.nDots >= 2)
 	{
-		// Determine cursor point based on raw data
-		m_fX = 1.0f - float(m_SensorDots[0].nRawX)/WR_WIISENSOR_MAX_X;
-		m_fY = float(m_SensorDots[0].nRawY)/WR_WIISENSOR_MAX_Y;
-		for (int i = 1; i < 4; i++)
+		float fBest = -1.0f;
+		for (int i = 0; i < WR_WIISENSOR_DOTS; i++)
 		{
-			// Convert to camera zone
-			if (m_SensorDots[i].nRawX != 0x3FF)
-				m_fX = (m_fX + 1.0f - float(m_SensorDots[i].nRawX)/WR_WIISENSOR_MAX_X) * 0.5f;
-			if (m_SensorDots[i].nRawY != 0x3FF)
-				m_fY = (m_fY + float(m_SensorDots[i].nRawY)/WR_WIISENSOR_MAX_Y) * 0.5f;
+			if (false == m_SensorDots[i].bTargeted) continue;
+			for (int j = i+1; j < WR_WIISENSOR_DOTS; j++)
+			{
+				if (false == m_SensorDots[j].bTargeted) continue;
+				const float fX = float(m_SensorDots[j].nRawX-m_SensorDots[i].nRawX);
+				const float fY = float(m_SensorDots[j].nRawY-m_SensorDots[i].nRawY);
+				const float fDist = (fX*fX)+(fY*fY);
+				if (fDist > fBest)
+				{
+					fBest = fDist;
+					nA = i;
+					nB = j;
+				}
+			}
 		}
 
+		// Left end first, so the roll starts out level
+		if (m_SensorDots[nA].nRawX > m_SensorDots[nB].nRawX)
+		{
+			const int nTemp = nA;
+			nA = nB;
+			nB = nTemp;
+		}
+		bA = bB = true;
+	}
+	else if (false == bA && false == bB && 1 == m_Bar.nDots)
+	{
+		// Only one dot and no bar to carry on from
+		for (nA = 0; false == m_SensorDots[nA].bTargeted; nA++);
+		nB = -1;
+		bA = true;
+		m_fBarOffset[0][0] = m_fBarOffset[0][1] = 0.0f;
+		m_Bar.fSeparation = 0.0f;
+		m_Bar.fRoll = 0.0f;
+	}
+	m_nBarDots[0] = nA;
+	m_nBarDots[1] = nB;
+
+	if (true == bA && true == bB)
+	{
+		const float fX = float(m_SensorDots[nB].nRawX-m_SensorDots[nA].nRawX);
+		const float fY = float(m_SensorDots[nB].nRawY-m_SensorDots[nA].nRawY);
+		m_Bar.fX = float(m_SensorDots[nA].nRawX) + fX*0.5f;
+		m_Bar.fY = float(m_SensorDots[nA].nRawY) + fY*0.5f;
+		m_Bar.fSeparation = sqrtf((fX*fX)+(fY*fY));
+		m_Bar.fRoll = atan2f(fY, fX);
+		m_fBarOffset[0][0] = fX*0.5f;
+		m_fBarOffset[0][1] = fY*0.5f;
+		m_fBarOffset[1][0] = -fX*0.5f;
+		m_fBarOffset[1][1] = -fY*0.5f;
+		m_Bar.bValid = true;
+	}
+	else if (true == bA || true == bB)
+	{
+		// Carry the midpoint on from the end still in view
+		const int nEnd = (true == bA ? 0 : 1);
+		const int nDot = m_nBarDots[nEnd];
+		m_Bar.fX = float(m_SensorDots[nDot].nRawX) + m_fBarOffset[nEnd][0];
+		m_Bar.fY = float(m_SensorDots[nDot].nRawY) + m_fBarOffset[nEnd][1];
+		m_Bar.bValid = true;
+	}
+	else
+	{
+		m_nBarDots[0] = m_nBarDots[1] = -1;
+		m_Bar.bValid = false;
+	}
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiSensor::UpdateCursor(float fTime)
+{
+	SJournalEvent event;
+	event.nType = WR_JOURNAL_SENSOR;
+	event.nSource = WR_JOURNAL_REMOTE;
+	event.fTime = fTime;
+	event.data.sensor.nDots = m_Bar.nDots;
+	event.data.sensor.bValid = m_Bar.bValid;
+
+	if (false == m_Bar.bValid)
+	{
+		// Start over when it comes back
+		m_CursorFilter.Reset();
+		m_nHistoryCount = 0;
+
+		event.data.sensor.fX = event.data.sensor.fY = 0.0f;
+		m_pRemote->m_Journal.Publish(event);
+		return;
+	}
+
+	// Determine cursor point from the bar midpoint
+	float fX = CLAMP(1.0f - m_Bar.fX/WR_WIISENSOR_MAX_X, 0.0f, 1.0f);
+	float fY = CLAMP(m_Bar.fY/WR_WIISENSOR_MAX_Y, 0.0f, 1.0f);
+	if (true == m_bFilterCursor)
+		m_CursorFilter.Filter(fX, fY, fTime);
+	m_fX = fX;
+	m_fY = fY;
+
+	// Remember it for prediction
+	m_nHistoryHead = (m_nHistoryHead+1) % WR_WIISENSOR_HISTORY;
+	m_CursorHistory[m_nHistoryHead].fX = fX;
+	m_CursorHistory[m_nHistoryHead].fY = fY;
+	m_CursorHistory[m_nHistoryHead].fTime = fTime;
+	m_nHistoryCount = MIN(m_nHistoryCount+1, WR_WIISENSOR_HISTORY);
+
+	// Publish the sample
+	event.data.sensor.fX = fX;
+	event.data.sensor.fY = fY;
+	m_pRemote->m_Journal.Publish(event);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiSensor::SetRelay(CWR_InputRelay *pRelay)
+{
+	m_Listeners.SetRelay(pRelay);
+	if (NULL != pRelay) pRelay->Attach(&m_Listeners);
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiSensor::OnPostUpdate(void)
+{
+	if (true == m_Bar.bValid)
+	{
 		// Remember data
 		bool bFirstOn = !m_bOnScreen;
 		m_bOnScreen = true;
@@ -130,13 +336,13 @@ void CWR_WiiSensor::OnPostUpdate(void)
 		// Did we just enter the screen?
 		if (true == bFirstOn)
 		{
-			for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+			for (Listeners::Dispatch itI(m_Listeners, WR_SENSOREVENT_ENTERSCREEN); itI; ++itI)
 				(*itI)->OnEnterScreen(m_pRemote, this, m_fX, m_fY);
 		}
 		else
 		{
 			// Send update report
-			for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+			for (Listeners::Dispatch itI(m_Listeners, WR_SENSOREVENT_CURSORUPDATE); itI; ++itI)
 				(*itI)->OnCursorUpdate(m_pRemote, this, m_fX, m_fY);
 		}
 
@@ -144,14 +350,10 @@ void CWR_WiiSensor::OnPostUpdate(void)
 	}
 	else
 	{
-		// Reset outter point data
-		m_SensorDots[2].nRawX = m_SensorDots[2].nRawY = 0x3FF;
-		m_SensorDots[3].nRawX = m_SensorDots[3].nRawY = 0x3FF;
-
 		// Did we just leave the screen
 		if (true == m_bOnScreen)
 		{
-			for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
+			for (Listeners::Dispatch itI(m_Listeners, WR_SENSOREVENT_LEAVESCREEN); itI; ++itI)
 				(*itI)->OnLeaveScreen(m_pRemote, this, m_fX, m_fY);
 		}
 
@@ -163,25 +365,15 @@ void CWR_WiiSensor::OnPostUpdate(void)
 }
 
 ////////////////////////////////////////////////////
-void CWR_WiiSensor::AddListener(IWR_WiiSensorListener *pListener)
+void CWR_WiiSensor::AddListener(IWR_WiiSensorListener *pListener, unsigned int nEvents)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-			return;
-	m_Listeners.push_back(pListener);
+	m_Listeners.Add(pListener, nEvents);
 }
 
 ////////////////////////////////////////////////////
 void CWR_WiiSensor::RemoveListener(IWR_WiiSensorListener *pListener)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_Listeners.begin(); itI != m_Listeners.end(); itI++)
-		if (*itI == pListener)
-		{
-			m_Listeners.erase(itI);
-			return;
-		}
+	m_Listeners.Remove(pListener);
 }
 
 ////////////////////////////////////////////////////
@@ -190,6 +382,82 @@ bool CWR_WiiSensor::IsEnabled(void) const
 	return m_bEnabled;
 }
 
+////////////////////////////////////////////////////
+bool CWR_WiiSensor::GetSensorBar(SSensorBar &bar) const
+{
+	bar = m_Bar;
+	return m_Bar.bValid;
+}
+
+////////////////////////////////////////////////////
+bool CWR_WiiSensor::GetDot(int nDot, int &nRawX, int &nRawY) const
+{
+	if (nDot < 0 || nDot >= WR_WIISENSOR_DOTS) return false;
+	nRawX = m_SensorDots[nDot].nRawX;
+	nRawY = m_SensorDots[nDot].nRawY;
+	return m_SensorDots[nDot].bTargeted;
+}
+
+////////////////////////////////////////////////////
+void CWR_WiiSensor::SetCursorFilter(bool bEnable, float fMinCutoff, float fBeta)
+{
+	m_bFilterCursor = bEnable;
+	m_CursorFilter.SetParams(fMinCutoff, fBeta, WR_WIISENSOR_FILTERSPEEDCUTOFF);
+	m_CursorFilter.Reset();
+}
+
+////////////////////////////////////////////////////
+bool CWR_WiiSensor::IsCursorFilter(void) const
+{
+	return m_bFilterCursor;
+}
+
+////////////////////////////////////////////////////
+bool CWR_WiiSensor::PredictCursor(float fTime, float &fX, float &fY) const
+{
+	if (false == m_Bar.bValid || 0 == m_nHistoryCount)
+		return false;
+
+	// Average the samples in the window
+	tCursorSample const& newest = m_CursorHistory[m_nHistoryHead];
+	float fMeanT = 0.0f, fMeanX = 0.0f, fMeanY = 0.0f;
+	int nCount = 0;
+	for (nCount = 0; nCount < m_nHistoryCount; nCount++)
+	{
+		tCursorSample const& sample = m_CursorHistory[(m_nHistoryHead-nCount+WR_WIISENSOR_HISTORY) % WR_WIISENSOR_HISTORY];
+		if (newest.fTime - sample.fTime > WR_WIISENSOR_PREDICTWINDOW) break;
+		fMeanT += sample.fTime;
+		fMeanX += sample.fX;
+		fMeanY += sample.fY;
+	}
+	fMeanT /= float(nCount);
+	fMeanX /= float(nCount);
+	fMeanY /= float(nCount);
+
+	// Fit a line through them for the speed
+	float fVarT = 0.0f, fCoX = 0.0f, fCoY = 0.0f;
+	for (int i = 0; i < nCount; i++)
+	{
+		tCursorSample const& sample = m_CursorHistory[(m_nHistoryHead-i+WR_WIISENSOR_HISTORY) % WR_WIISENSOR_HISTORY];
+		const float fT = sample.fTime - fMeanT;
+		fVarT += fT*fT;
+		fCoX += fT*(sample.fX - fMeanX);
+		fCoY += fT*(sample.fY - fMeanY);
+	}
+	if (fVarT <= 0.0f)
+	{
+		fX = newest.fX;
+		fY = newest.fY;
+		return true;
+	}
+
+	// Follow the line from the newest sample
+	const float fAhead = CLAMP(fTime - newest.fTime, 0.0f, WR_WIISENSOR_MAXPREDICT);
+	fX = CLAMP(newest.fX + (fCoX/fVarT)*fAhead, 0.0f, 1.0f);
+	fY = CLAMP(newest.fY + (fCoY/fVarT)*fAhead, 0.0f, 1.0f);
+	return true;
+}
+
 ////////////////////////////////////////////////////
 void CWR_WiiSensor::OnSetReport(int nMode)
 {
@@ -209,12 +477,16 @@ void CWR_WiiSensor::OnSetReport(int nMode)
 	m_pRemote->GetDataHelper()->WriteData(WR_SENSORREG_SENSITIVITY_1, sizeof(IR_SENSITIVITY_1), IR_SENSITIVITY_1);
 	m_pRemote->GetDataHelper()->WriteData(WR_SENSORREG_SENSITIVITY_2, sizeof(IR_SENSITIVITY_2), IR_SENSITIVITY_2);
 
-	// Set mode
-	static WiiIOData IR_MODE[] = {0x01};
+	// Set mode, sizes are picked up when the extension shares the report
+	m_nMode = (WR_REPORT_EXTENSION == (nMode&WR_REPORT_EXTENSION) ? WR_SENSORMODE_POS : WR_SENSORMODE_POSSIZE);
+	WiiIOData IR_MODE[] = {(WiiIOData)m_nMode};
 	static WiiIOData IR_MASTER_FIN[] = {0x08};
 	m_pRemote->GetDataHelper()->WriteData(WR_SENSORREG_MODE, sizeof(IR_MODE), IR_MODE);
 	//m_pRemote->GetDataHelper()->WriteData(WR_SENSORREG_MASTER, sizeof(IR_MASTER_FIN), IR_MASTER_FIN);
 
+	// Identities from the old mode no longer line up
+	ResetDots();
+
 	m_bEnabled = true;
 	m_fLastOnScreenTime = g_pWR->pTimer->GetCurrTime();
 }
\ No newline at end of file
@@ -15,6 +15,8 @@
 #define _WR_CWIISENSOR_H_
 
 #include "Interfaces\WR_IWiiSensor.h"
+#include "WR_SensorUnpack.h"
+#include "WR_CCursorFilter.h"
 
 class CWR_WiiSensor : public IWR_WiiSensor
 {
@@ -25,22 +27,43 @@ protected:
 	bool m_bWasUpdated;
 	bool m_bEnabled;
 
-	// Raw dot data
+	int m_nMode;
+
+	// Raw dot data, indexed by tracked identity
 	struct tSensorDot
 	{
 		bool bTargeted;
 		int nRawX;
 		int nRawY;
-	} m_SensorDots[4];
+		int nSize;
+	} m_SensorDots[WR_WIISENSOR_DOTS];
+	SSensorDots m_FullDots; // Full mode dots waiting on the second report
 	float m_fLastOnScreenTime;
 
+	// Sensor bar
+	SSensorBar m_Bar;
+	int m_nBarDots[2];			// Tracked dots at each end of the bar, -1 if none
+	float m_fBarOffset[2][2];	// Offset from each end to the midpoint when both were last seen
+
 	// Cursor data
 	bool m_bOnScreen;
 	float m_fX;
 	float m_fY;
+	bool m_bFilterCursor;
+	CWR_CursorFilter m_CursorFilter;
+
+	// Newest cursor samples, for prediction
+	struct tCursorSample
+	{
+		float fX;
+		float fY;
+		float fTime;
+	} m_CursorHistory[WR_WIISENSOR_HISTORY];
+	int m_nHistoryHead;
+	int m_nHistoryCount;
 
 	// Listeners
-	typedef std::list<IWR_WiiSensorListener*> Listeners;
+	typedef CWR_ListenerList<IWR_WiiSensorListener> Listeners;
 	Listeners m_Listeners;
 
 public:
@@ -110,6 +133,63 @@ protected:
 	////////////////////////////////////////////////////
 	virtual void OnPostUpdate(void);
 
+	////////////////////////////////////////////////////
+	// SetRelay
+	//
+	// Purpose: Hand listener calls to a relay instead
+	//
+	// In:	pRelay - Relay to use, or NULL to call the
+	//			listeners directly
+	////////////////////////////////////////////////////
+	virtual void SetRelay(CWR_InputRelay *pRelay);
+
+	////////////////////////////////////////////////////
+	// GetDataSize
+	//
+	// Purpose: Returns how many bytes of each report are
+	//	used for sensor data in the current mode
+	////////////////////////////////////////////////////
+	virtual int GetDataSize(void) const;
+
+	////////////////////////////////////////////////////
+	// ResetDots
+	//
+	// Purpose: Forget all tracked dots and the sensor bar
+	////////////////////////////////////////////////////
+	virtual void ResetDots(void);
+
+	////////////////////////////////////////////////////
+	// TrackDots
+	//
+	// Purpose: Match the dots of a report to the tracked
+	//	dots so each keeps its identity
+	//
+	// In:	dots - Dots unpacked from the report, in the
+	//			order the camera reported them
+	//
+	// Note: Dots are matched nearest first. New dots take
+	//	over identities no longer in use
+	////////////////////////////////////////////////////
+	virtual void TrackDots(SSensorDots const& dots);
+
+	////////////////////////////////////////////////////
+	// UpdateBar
+	//
+	// Purpose: Estimate the sensor bar from the tracked
+	//	dots
+	////////////////////////////////////////////////////
+	virtual void UpdateBar(void);
+
+	////////////////////////////////////////////////////
+	// UpdateCursor
+	//
+	// Purpose: Move the cursor to the sensor bar and
+	//	filter it
+	//
+	// In:	fTime - Time the report was received
+	////////////////////////////////////////////////////
+	virtual void UpdateCursor(float fTime);
+
 public:
 	////////////////////////////////////////////////////
 	// AddListener
@@ -117,8 +197,11 @@ public:
 	// Purpose: Add a listener
 	//
 	// In:	pListener - Listener to add
+	//		nEvents - Events to subscribe to (see WR_WIISENSOR_EVENTS)
+	//
+	// Note: Adding a listener again changes its events
 	////////////////////////////////////////////////////
-	virtual void AddListener(IWR_WiiSensorListener *pListener);
+	virtual void AddListener(IWR_WiiSensorListener *pListener, unsigned int nEvents = WR_SENSOREVENT_DEFAULT);
 
 	////////////////////////////////////////////////////
 	// RemoveListener
@@ -135,6 +218,81 @@ public:
 	// Purpose: Returns TRUE if enabled, FALSE on error
 	////////////////////////////////////////////////////
 	virtual bool IsEnabled(void) const;
+
+	////////////////////////////////////////////////////
+	// GetSensorBar
+	//
+	// Purpose: Get the current sensor bar estimate
+	//
+	// Out:	bar - Sensor bar estimate
+	//
+	// Returns TRUE if the bar is in view
+	//
+	// Note: If one end of the bar drops out, the midpoint
+	//	is carried on from the end still in view
+	////////////////////////////////////////////////////
+	virtual bool GetSensorBar(SSensorBar &bar) const;
+
+	////////////////////////////////////////////////////
+	// GetDot
+	//
+	// Purpose: Get a tracked dot
+	//
+	// In:	nDot - Dot identity (0 to WR_WIISENSOR_DOTS-1)
+	//
+	// Out:	nRawX - Raw X position
+	//		nRawY - Raw Y position
+	//
+	// Returns TRUE if the dot is tracked
+	//
+	// Note: A dot keeps its identity for as long as it
+	//	stays in view
+	////////////////////////////////////////////////////
+	virtual bool GetDot(int nDot, int &nRawX, int &nRawY) const;
+
+	////////////////////////////////////////////////////
+	// SetCursorFilter
+	//
+	// Purpose: Set up the filter used to smooth the
+	//	cursor
+	//
+	// In:	bEnable - TRUE to filter the cursor
+	//		fMinCutoff - Cutoff frequency (Hz) while still,
+	//			lower is smoother
+	//		fBeta - How much the cutoff rises with speed,
+	//			higher has less lag
+	//
+	// Note: The filter runs once per report using the
+	//	time the report was received
+	////////////////////////////////////////////////////
+	virtual void SetCursorFilter(bool bEnable, float fMinCutoff = WR_WIISENSOR_FILTERMINCUTOFF, float fBeta = WR_WIISENSOR_FILTERBETA);
+
+	////////////////////////////////////////////////////
+	// IsCursorFilter
+	//
+	// Purpose: Returns TRUE if the cursor is filtered
+	////////////////////////////////////////////////////
+	virtual bool IsCursorFilter(void) const;
+
+	////////////////////////////////////////////////////
+	// PredictCursor
+	//
+	// Purpose: Predict where the cursor will be at a
+	//	given time
+	//
+	// In:	fTime - Time to predict for, on the timer's
+	//			precise time (see GetPreciseTime)
+	//
+	// Out:	fX - Cursor X position
+	//		fY - Cursor Y position
+	//
+	// Returns TRUE if the cursor is on the screen
+	//
+	// Note: Extrapolates from the speed of the newest
+	//	samples, at most WR_WIISENSOR_MAXPREDICT ahead of
+	//	the newest one
+	////////////////////////////////////////////////////
+	virtual bool PredictCursor(float fTime, float &fX, float &fY) const;
 };
 
 #endif //_WR_CWIISENSOR_H_
\ No newline at end of file
@@ -17,6 +17,7 @@
 // Include implementation files
 #include "WR_CHIDController.h"
 #include "WR_CTimer.h"
+#include "WR_CCalibrationCache.h"
 
 CWR_GlobalInstance CWR_GlobalInstance::m_Instance;
 CWR_GlobalInstance *g_pWR = GetWiiRemoteSystem();
@@ -33,14 +34,22 @@ CWR_GlobalInstance::CWR_GlobalInstance(void)
 	m_ErrorDef.nModule = m_ErrorDef.nError = 0;
 	m_ErrorDef.szErrorMsgs = NULL;
 
+	m_hInputThread = INVALID_HANDLE_VALUE;
+	m_hInputEvent = INVALID_HANDLE_VALUE;
+	m_dwInputThreadID = 0;
+	_bInputThreadProcTerminate = false;
+	InitializeCriticalSection(&m_csInput);
+
 	pHIDController = new CWR_HIDController;
 	pTimer = new CWR_Timer;
+	pCalibrationCache = new CWR_CalibrationCache;
 }
 
 ////////////////////////////////////////////////////
 CWR_GlobalInstance::~CWR_GlobalInstance(void)
 {
 	Shutdown();
+	DeleteCriticalSection(&m_csInput);
 }
 
 ////////////////////////////////////////////////////
@@ -78,7 +87,7 @@ void CWR_GlobalInstance::RaiseError(int nModule, int nError, char const** szErro
 	m_ErrorDef.szErrorMsgs = szErrorMsgs;
 
 	// Signal
-	for (Listeners::iterator itI = m_ErrorListeners.begin(); itI != m_ErrorListeners.end(); itI++)
+	for (Listeners::Dispatch itI(m_ErrorListeners, WR_ERROREVENT_ERROR); itI; ++itI)
 		(*itI)->OnError(nModule, nError, szErrorMsgs[nError]);
 }
 
@@ -91,30 +100,20 @@ void CWR_GlobalInstance::RaiseManualError(char const* szError, int nError)
 	m_ErrorDef.szErrorMsgs = NULL;
 
 	// Signal
-	for (Listeners::iterator itI = m_ErrorListeners.begin(); itI != m_ErrorListeners.end(); itI++)
+	for (Listeners::Dispatch itI(m_ErrorListeners, WR_ERROREVENT_ERROR); itI; ++itI)
 		(*itI)->OnError(0, nError, szError);
 }
 
 ////////////////////////////////////////////////////
 void CWR_GlobalInstance::AddErrorListener(IWR_ErrorListener *pListener)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_ErrorListeners.begin(); itI != m_ErrorListeners.end(); itI++)
-		if (*itI == pListener)
-			return;
-	m_ErrorListeners.push_back(pListener);
+	m_ErrorListeners.Add(pListener, WR_ERROREVENT_ERROR);
 }
 
 ////////////////////////////////////////////////////
 void CWR_GlobalInstance::RemoveErrorListener(IWR_ErrorListener *pListener)
 {
-	if (NULL == pListener) return;
-	for (Listeners::iterator itI = m_ErrorListeners.begin(); itI != m_ErrorListeners.end(); itI++)
-		if (*itI == pListener)
-		{
-			m_ErrorListeners.erase(itI);
-			return;
-		}
+	m_ErrorListeners.Remove(pListener);
 }
 
 ////////////////////////////////////////////////////
@@ -134,6 +133,9 @@ bool CWR_GlobalInstance::Initialize(void)
 ////////////////////////////////////////////////////
 void CWR_GlobalInstance::Shutdown(void)
 {
+	// Stop the input thread before the remotes go away
+	SetThreadedInput(false);
+
 	// Destroy the HID controller
 	if (NULL != pHIDController)
 	{
@@ -148,18 +150,144 @@ void CWR_GlobalInstance::Shutdown(void)
 		SAFE_DELETE(pTimer);
 	}
 
+	// Destroy the calibration cache
+	SAFE_DELETE(pCalibrationCache);
+
 	// Clean out listeners
-	m_ErrorListeners.clear();
+	m_ErrorListeners.Clear();
 }
 
 ////////////////////////////////////////////////////
 void CWR_GlobalInstance::Update(void)
 {
+	LockInput();
+
 	// Update timer
 	assert(pTimer);
 	pTimer->Update();
 
-	// Update HID controller
 	assert(pHIDController);
-	pHIDController->UpdateRemotes();
+	if (true == IsThreadedInput())
+	{
+		// Input thread parses the reports, make the calls it deferred
+		RemoteMap remotes;
+		pHIDController->GetRemotes(remotes);
+		for (int i = 0; i < MAX_REMOTES; i++)
+		{
+			if (NULL != remotes[i])
+				remotes[i]->DispatchDeferred();
+		}
+	}
+	else
+	{
+		// Update HID controller
+		pHIDController->UpdateRemotes();
+	}
+
+	UnlockInput();
+}
+
+////////////////////////////////////////////////////
+bool CWR_GlobalInstance::SetThreadedInput(bool bThreaded)
+{
+	if (bThreaded == IsThreadedInput()) return true;
+	if (NULL == pHIDController) return false;
+
+	if (true == bThreaded)
+	{
+		// Create wake event and the thread
+		m_hInputEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+		if (NULL == m_hInputEvent)
+		{
+			m_hInputEvent = INVALID_HANDLE_VALUE;
+			return false;
+		}
+		_bInputThreadProcTerminate = false;
+		m_hInputThread = (HANDLE)_beginthreadex(NULL, 0, InputThreadProc, this, CREATE_SUSPENDED, &m_dwInputThreadID);
+		if (NULL == m_hInputThread)
+		{
+			m_hInputThread = INVALID_HANDLE_VALUE;
+			CloseHandle(m_hInputEvent);
+			m_hInputEvent = INVALID_HANDLE_VALUE;
+			return false;
+		}
+	}
+	else
+	{
+		// Close the thread
+		_bInputThreadProcTerminate = true;
+		SetEvent(m_hInputEvent);
+		WaitForSingleObject(m_hInputThread, INFINITE);
+		CloseHandle(m_hInputThread);
+		m_hInputThread = INVALID_HANDLE_VALUE;
+		CloseHandle(m_hInputEvent);
+		m_hInputEvent = INVALID_HANDLE_VALUE;
+	}
+
+	// Listeners run on this thread either way
+	RemoteMap remotes;
+	pHIDController->GetRemotes(remotes);
+	for (int i = 0; i < MAX_REMOTES; i++)
+	{
+		if (NULL != remotes[i])
+			remotes[i]->SetDeferredListeners(bThreaded);
+	}
+
+	if (true == bThreaded)
+		ResumeThread(m_hInputThread);
+	return true;
+}
+
+////////////////////////////////////////////////////
+bool CWR_GlobalInstance::IsThreadedInput(void) const
+{
+	return (INVALID_HANDLE_VALUE != m_hInputThread);
+}
+
+////////////////////////////////////////////////////
+void CWR_GlobalInstance::LockInput(void)
+{
+	EnterCriticalSection(&m_csInput);
+}
+
+////////////////////////////////////////////////////
+void CWR_GlobalInstance::UnlockInput(void)
+{
+	LeaveCriticalSection(&m_csInput);
+}
+
+////////////////////////////////////////////////////
+void CWR_GlobalInstance::SignalInput(void)
+{
+	if (INVALID_HANDLE_VALUE != m_hInputEvent)
+		SetEvent(m_hInputEvent);
+}
+
+////////////////////////////////////////////////////
+// Input thread procedure
+////////////////////////////////////////////////////
+unsigned int __stdcall CWR_GlobalInstance::InputThreadProc(void *pThis)
+{
+	CWR_GlobalInstance *pWR = (CWR_GlobalInstance*)pThis;
+	if (NULL == pWR)
+	{
+		_endthreadex(1);
+		return 1;
+	}
+
+	while (false == pWR->_bInputThreadProcTerminate)
+	{
+		// Wait for a report, or long enough that timeouts still happen
+		WaitForSingleObject(pWR->m_hInputEvent, WR_INPUTTHREAD_WAIT);
+		if (true == pWR->_bInputThreadProcTerminate)
+			break;
+
+		// Parse everything that came in
+		pWR->LockInput();
+		pWR->pHIDController->UpdateRemotes();
+		pWR->UnlockInput();
+	}
+
+	_endthreadex(0);
+	return 0;
 }
\ No newline at end of file
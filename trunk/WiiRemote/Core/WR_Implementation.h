@@ -18,6 +18,11 @@
 #define WR_VENDORID		(0x057e)
 #define WR_PRODUCTID	(0x0306)
 
+// How long the input thread waits for a report before
+//	updating anyway, so timeouts and status requests still
+//	happen (milliseconds)
+#define WR_INPUTTHREAD_WAIT (10)
+
 // Success code used by all modules
 #define WR_ERROR_SUCCESS (0)
 #define WR_SUCCESS(s) (WR_ERROR_SUCCESS == (s))
@@ -32,6 +37,7 @@
 #include <list>
 #include <queue>
 #include <map>
+#include <vector>
 
 // Core files
 #include "Interfaces\WR_ITimer.h"
@@ -42,6 +48,11 @@
 #include "Interfaces\WR_IWiiData.h"
 #include "Interfaces\WR_IWiiExtension.h"
 #include "Interfaces\WR_IWiiSensor.h"
+#include "Interfaces\WR_IEventJournal.h"
+#include "Interfaces\WR_ICalibrationCache.h"
+
+// Listener storage
+#include "WR_CListenerList.h"
 
 // Extension files
 #include "WR_CWiiNunchuk.h"
@@ -163,6 +174,12 @@ static char const* szModules[] =
 ////////////////////////////////////////////////////
 ////////////////////////////////////////////////////
 
+// Error listener events
+enum WR_ERROR_EVENTS
+{
+	WR_ERROREVENT_ERROR = 0x01,		// OnError
+};
+
 // Error listener
 struct IWR_ErrorListener
 {
@@ -202,9 +219,18 @@ private:
 	} m_ErrorDef;
 
 	// Listeners
-	typedef std::list<IWR_ErrorListener*> Listeners;
+	typedef CWR_ListenerList<IWR_ErrorListener> Listeners;
 	Listeners m_ErrorListeners;
 
+	// Input thread information
+	HANDLE m_hInputThread;
+	HANDLE m_hInputEvent;
+	unsigned int m_dwInputThreadID;
+	CRITICAL_SECTION m_csInput;
+
+	static unsigned int __stdcall InputThreadProc(void *pThis);
+	volatile bool _bInputThreadProcTerminate;
+
 public:
 	////////////////////////////////////////////////////
 	// Destructor
@@ -303,13 +329,67 @@ public:
 	// Update
 	//
 	// Purpose: Update the core objects
+	//
+	// Note: With threaded input, only makes the listener
+	//	calls the input thread deferred
 	////////////////////////////////////////////////////
 	virtual void Update(void);
 
+	////////////////////////////////////////////////////
+	// SetThreadedInput
+	//
+	// Purpose: Update the remotes on an input thread as
+	//	reports come in, instead of in Update
+	//
+	// In:	bThreaded - TRUE to start the input thread,
+	//			FALSE to stop it
+	//
+	// Returns TRUE on success, FALSE on error
+	//
+	// Note: Listeners are still called from Update, in the
+	//	order the input thread made the calls. Read the
+	//	remotes' snapshots (see IWR_WiiRemote::GetSnapshot)
+	//	or hold LockInput to look at them in between
+	////////////////////////////////////////////////////
+	virtual bool SetThreadedInput(bool bThreaded);
+
+	////////////////////////////////////////////////////
+	// IsThreadedInput
+	//
+	// Purpose: Returns TRUE if the input thread is running
+	////////////////////////////////////////////////////
+	virtual bool IsThreadedInput(void) const;
+
+	////////////////////////////////////////////////////
+	// LockInput
+	//
+	// Purpose: Keep the input thread from updating the
+	//	remotes until UnlockInput is called
+	//
+	// Note: Calls may be nested
+	////////////////////////////////////////////////////
+	virtual void LockInput(void);
+
+	////////////////////////////////////////////////////
+	// UnlockInput
+	//
+	// Purpose: Let the input thread update the remotes
+	//	again
+	////////////////////////////////////////////////////
+	virtual void UnlockInput(void);
+
+	////////////////////////////////////////////////////
+	// SignalInput
+	//
+	// Purpose: Wake the input thread when a report comes in
+	////////////////////////////////////////////////////
+	virtual void SignalInput(void);
+
 public:
 	// Core files
 	IWR_HIDController *pHIDController;
 	IWR_Timer *pTimer;
+	IWR_CalibrationCache *pCalibrationCache;
 };
 
 #define SETUP_WR_MODULE() \
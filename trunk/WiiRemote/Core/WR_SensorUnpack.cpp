@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_SensorUnpack.cpp
+//
+// Purpose: Unpacks the IR dots of a sensor report
+//	into SSensorDots in one pass
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "WR_Implementation.h"
+#include "WR_SensorUnpack.h"
+
+////////////////////////////////////////////////////
+void WR_UnpackSensorDots(unsigned char const* pData, int nMode, SSensorDots &dots, int nFirst)
+{
+#ifdef WR_SENSOR_USE_SSE
+	// Full mode only holds two dots per report
+	if (WR_SENSORMODE_ALL == nMode)
+	{
+		WR_UnpackSensorDots_Scalar(pData, nMode, dots, nFirst);
+		return;
+	}
+
+	// Gather one dot per lane. In basic mode the odd dots keep their high
+	//	bits in the low half of the shared byte, so move them up to line
+	//	up with the even dots
+	__m128i vLoX, vLoY, vHigh;
+	if (WR_SENSORMODE_POS == nMode)
+	{
+		vLoX = _mm_set_epi32(pData[8], pData[5], pData[3], pData[0]);
+		vLoY = _mm_set_epi32(pData[9], pData[6], pData[4], pData[1]);
+		vHigh = _mm_set_epi32(pData[7]<<4, pData[7], pData[2]<<4, pData[2]);
+	}
+	else
+	{
+		vLoX = _mm_set_epi32(pData[9], pData[6], pData[3], pData[0]);
+		vLoY = _mm_set_epi32(pData[10], pData[7], pData[4], pData[1]);
+		vHigh = _mm_set_epi32(pData[11], pData[8], pData[5], pData[2]);
+	}
+
+	const __m128i vTwoBits = _mm_set1_epi32(0x3);
+	const __m128i vX = _mm_or_si128(vLoX, _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(vHigh, 4), vTwoBits), 8));
+	const __m128i vY = _mm_or_si128(vLoY, _mm_slli_epi32(_mm_and_si128(_mm_srli_epi32(vHigh, 6), vTwoBits), 8));
+	const __m128i vSize = (WR_SENSORMODE_POS == nMode ? _mm_setzero_si128() : _mm_and_si128(vHigh, _mm_set1_epi32(0x0F)));
+	_mm_storeu_si128((__m128i*)dots.nX, vX);
+	_mm_storeu_si128((__m128i*)dots.nY, vY);
+	_mm_storeu_si128((__m128i*)dots.nSize, vSize);
+	_mm_storeu_si128((__m128i*)dots.nIntensity, _mm_setzero_si128());
+
+	// A dot is missing when both X and Y are all ones
+	const __m128i vNoDot = _mm_set1_epi32(WR_WIISENSOR_NODOT);
+	const int nMissing = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi32(vX, vNoDot), _mm_cmpeq_epi32(vY, vNoDot)));
+	dots.nFound = (~((nMissing&0x1)|((nMissing>>3)&0x2)|((nMissing>>6)&0x4)|((nMissing>>9)&0x8)))&0xF;
+#else
+	WR_UnpackSensorDots_Scalar(pData, nMode, dots, nFirst);
+#endif //WR_SENSOR_USE_SSE
+}
+
+////////////////////////////////////////////////////
+void WR_UnpackSensorDots_Scalar(unsigned char const* pData, int nMode, SSensorDots &dots, int nFirst)
+{
+	int nCount = WR_WIISENSOR_DOTS;
+	if (WR_SENSORMODE_ALL == nMode)
+	{
+		nCount = WR_WIISENSOR_DOTS/2;
+		dots.nFound &= ~(0x3<<nFirst);
+	}
+	else
+	{
+		nFirst = 0;
+		dots.nFound = 0;
+	}
+
+	for (int i = 0; i < nCount; i++)
+	{
+		int nLoX = 0, nLoY = 0, nHigh = 0;
+		const int nDot = nFirst+i;
+		if (WR_SENSORMODE_POS == nMode)
+		{
+			// Two groups of 5 bytes, each holding two dots that share a byte
+			//	for their high bits
+			unsigned char const* pGroup = pData + (i/2)*5;
+			nLoX = pGroup[(i&1)*3+0];
+			nLoY = pGroup[(i&1)*3+1];
+			nHigh = (pGroup[2] << ((i&1)*4)) & 0xF0;
+		}
+		else
+		{
+			// 3 bytes per dot, or 9 in full mode where the first 3 are the same
+			//	as in extended mode and the rest are bounds and intensity
+			unsigned char const* pDot = pData + i*(WR_SENSORMODE_ALL == nMode ? 9 : 3);
+			nLoX = pDot[0];
+			nLoY = pDot[1];
+			nHigh = pDot[2];
+			dots.nIntensity[nDot] = (WR_SENSORMODE_ALL == nMode ? pDot[8] : 0);
+		}
+
+		dots.nX[nDot] = nLoX | (((nHigh>>4)&0x3) << 8);
+		dots.nY[nDot] = nLoY | (((nHigh>>6)&0x3) << 8);
+		if (WR_SENSORMODE_POS == nMode)
+		{
+			dots.nSize[nDot] = 0;
+			dots.nIntensity[nDot] = 0;
+		}
+		else
+			dots.nSize[nDot] = (nHigh&0x0F);
+
+		if (WR_WIISENSOR_NODOT != dots.nX[nDot] || WR_WIISENSOR_NODOT != dots.nY[nDot])
+			dots.nFound |= (1<<nDot);
+	}
+}
\ No newline at end of file
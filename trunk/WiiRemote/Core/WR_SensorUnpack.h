@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////
+// Wii Remote Core File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// WR_SensorUnpack.h
+//
+// Purpose: Unpacks the IR dots of a sensor report
+//	into SSensorDots in one pass
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _WR_SENSORUNPACK_H_
+#define _WR_SENSORUNPACK_H_
+
+#include "Interfaces\WR_IWiiSensor.h"
+
+// Use SSE2 to unpack all four dots at once when available
+#if defined(_M_IX86) || defined(_M_X64)
+	#define WR_SENSOR_USE_SSE
+	#include <emmintrin.h>
+#endif
+
+////////////////////////////////////////////////////
+// WR_UnpackSensorDots
+//
+// Purpose: Unpack the dots held in the sensor part
+//	of a report
+//
+// In:	pData - Start of the sensor data
+//		nMode - Sensor mode the data was sent in (see
+//			WR_WIISENSOR_MODE)
+//		nFirst - First dot held in the data. Full mode
+//			sends dots 0-1 and 2-3 in separate reports
+//
+// Out:	dots - Unpacked dots
+//
+// Note: Only the dots held in the data are written
+////////////////////////////////////////////////////
+void WR_UnpackSensorDots(unsigned char const* pData, int nMode, SSensorDots &dots, int nFirst = 0);
+
+////////////////////////////////////////////////////
+// WR_UnpackSensorDots_Scalar
+//
+// Purpose: Same as WR_UnpackSensorDots without SSE
+////////////////////////////////////////////////////
+void WR_UnpackSensorDots_Scalar(unsigned char const* pData, int nMode, SSensorDots &dots, int nFirst = 0);
+
+#endif //_WR_SENSORUNPACK_H_
\ No newline at end of file
@@ -839,6 +839,11 @@ void CHUD::SwitchToModalHUD(CGameFlashAnimation* pModalHUD,bool bNeedMouse)
 			CursorDecrementCounter();
 	}
 	m_pModalHUD = pModalHUD;
+
+	// [WR] Opened menu decides the remote's state
+	if (IWiiRemoteManager *pM = g_pGame->GetWiiRemoteManager())
+		pM->InvalidateState();
+	// [/WR]
 }
 
 //-----------------------------------------------------------------------------------------------------
@@ -24,6 +24,10 @@ History:
 #include "Weapon.h"
 #include "OffHand.h"
 
+// [WR]
+#include "WiiRemote/Interfaces/IWiiRemoteManager.h"
+// [/WR]
+
 //-----------------------------------------------------------------------------------------------------
 
 CHUDCrosshair::CHUDCrosshair(CHUD* pHUD) : g_pHUD(pHUD), m_bUsable(false)
@@ -156,8 +160,14 @@ void CHUDCrosshair::Update(float fDeltaTime)
 
 		// Position cursor to match where IR is pointing
 		// Note: If IR is disabled, crosshair will always be in center position
-		float fIRX = m_vIRPos.x*fWidth - fWidth*0.5f;
-		float fIRY = m_vIRPos.y*fHeight - fHeight*0.5f;
+		Vec3 vIRPos = m_vIRPos;
+		if (true == m_bIREnabled)
+		{
+			if (IWiiRemoteManager *pM = g_pGame->GetWiiRemoteManager())
+				pM->PredictCursor(vIRPos);
+		}
+		float fIRX = vIRPos.x*fWidth - fWidth*0.5f;
+		float fIRY = vIRPos.y*fHeight - fHeight*0.5f;
 		m_animCrossHair.SetVariable("_x", fIRX);
 		m_animCrossHair.SetVariable("_y", fIRY);
 
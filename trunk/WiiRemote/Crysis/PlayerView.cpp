@@ -556,6 +556,8 @@ void CPlayerView::ViewFirstPerson(SViewParams &viewParams)
 			if (CHUDCrosshair *pCH = pHud->GetCrosshair())
 			{
 				Vec3 vCursorPos; pCH->IRGetCursorPos(vCursorPos);
+				if (IWiiRemoteManager *pM = g_pGame->GetWiiRemoteManager())
+					pM->PredictCursor(vCursorPos);
 				const float fMoveHoriz = g_pGameCVars->cl_fov;
 				const float fMoveVert = g_pGameCVars->cl_fov;
 				weaponAngleOffset.z = -(vCursorPos.x * fMoveHoriz - fMoveHoriz*0.5f);
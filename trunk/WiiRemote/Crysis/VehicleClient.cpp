@@ -22,6 +22,10 @@ History:
 #include "Player.h"
 #include "HUD/HUD.h"
 
+// [WR]
+#include "WiiRemote\Interfaces\IWiiRemoteManager.h"
+// [/WR]
+
 //------------------------------------------------------------------------
 bool CVehicleClient::Init()
 {
@@ -350,6 +354,11 @@ void CVehicleClient::OnEnterVehicleSeat(IVehicleSeat* pSeat)
 	pMapManager->EnableActionMap("seavehicle", false);
 	pMapManager->EnableActionMap("helicopter", false);
 	pMapManager->EnableActionMap("vtol", false);
+
+	// [WR] Vehicle type decides the remote's state
+	if (IWiiRemoteManager *pM = g_pGame->GetWiiRemoteManager())
+		pM->InvalidateState();
+	// [/WR]
 }
 
 //------------------------------------------------------------------------
@@ -370,6 +379,11 @@ void CVehicleClient::OnExitVehicleSeat(IVehicleSeat* pSeat)
     
     pSeat->SetView(InvalidVehicleViewId);
   }
+
+	// [WR] Vehicle type decides the remote's state
+	if (IWiiRemoteManager *pM = g_pGame->GetWiiRemoteManager())
+		pM->InvalidateState();
+	// [/WR]
 }
 
 
@@ -32,6 +32,14 @@ struct IMotion
 	////////////////////////////////////////////////////
 	virtual bool IsFired(void) const = 0;
 
+	////////////////////////////////////////////////////
+	// IsCommitted
+	//
+	// Purpose: Returns TRUE if motion is certain enough
+	//	to fire before the gesture has ended
+	////////////////////////////////////////////////////
+	virtual bool IsCommitted(void) const = 0;
+
 	////////////////////////////////////////////////////
 	// SetPassMask
 	//
@@ -86,6 +94,17 @@ struct IMotion
 	////////////////////////////////////////////////////
 	virtual void OnEnd(SMotionElement const& motion, int nState) = 0;
 
+	////////////////////////////////////////////////////
+	// OnCancel
+	//
+	// Purpose: Called when a speculatively started gesture
+	//	turned out not to be one. Roll back to the state
+	//	before OnBegin.
+	//
+	// In:	nState - Current active state
+	////////////////////////////////////////////////////
+	virtual void OnCancel(int nState) = 0;
+
 	////////////////////////////////////////////////////
 	// Execute
 	//
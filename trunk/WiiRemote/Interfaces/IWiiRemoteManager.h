@@ -14,6 +14,25 @@
 #ifndef _IWIIREMOTEMANAGER_H_
 #define _IWIIREMOTEMANAGER_H_
 
+struct IWiiRemoteStateListener
+{
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~IWiiRemoteStateListener(void) {}
+
+	////////////////////////////////////////////////////
+	// OnStateChanged
+	//
+	// Purpose: Called when the game state the remote is
+	//	mapped for changes, i.e. entering a vehicle
+	//
+	// In:	nOldState - State that was active
+	//		nNewState - State now active
+	////////////////////////////////////////////////////
+	virtual void OnStateChanged(int nOldState, int nNewState) = 0;
+};
+
 struct IWiiRemoteManager
 {
 	////////////////////////////////////////////////////
@@ -89,6 +108,19 @@ struct IWiiRemoteManager
 	////////////////////////////////////////////////////
 	virtual struct IRenderNode* GetLockedEntity(Vec3 &vOffset) const = 0;
 
+	////////////////////////////////////////////////////
+	// PredictCursor
+	//
+	// Purpose: Get where the IR cursor is expected to be
+	//	when the current frame is shown
+	//
+	// Out:	vPos - Predicted cursor position
+	//
+	// Returns TRUE if the crosshair is following the
+	//	IR cursor, otherwise vPos is untouched
+	////////////////////////////////////////////////////
+	virtual bool PredictCursor(Vec3 &vPos) const = 0;
+
 	////////////////////////////////////////////////////
 	// FreezeMovement
 	//
@@ -157,6 +189,42 @@ struct IWiiRemoteManager
 	// In:	nShooterId - Id of shooter
 	////////////////////////////////////////////////////
 	virtual void OnWeaponShoot(unsigned int nShooterId) = 0;
+
+	////////////////////////////////////////////////////
+	// InvalidateState
+	//
+	// Purpose: Call when something the game state is
+	//	derived from changes, i.e. a HUD menu opening or
+	//	the player entering a vehicle
+	//
+	// Note: The state is detected again on the next update
+	////////////////////////////////////////////////////
+	virtual void InvalidateState(void) = 0;
+
+	////////////////////////////////////////////////////
+	// GetState
+	//
+	// Purpose: Return the current game state
+	////////////////////////////////////////////////////
+	virtual int GetState(void) const = 0;
+
+	////////////////////////////////////////////////////
+	// AddStateListener
+	//
+	// Purpose: Add a listener for game state changes
+	//
+	// In:	pListener - Listener to add
+	////////////////////////////////////////////////////
+	virtual void AddStateListener(IWiiRemoteStateListener *pListener) = 0;
+
+	////////////////////////////////////////////////////
+	// RemoveStateListener
+	//
+	// Purpose: Remove a listener for game state changes
+	//
+	// In:	pListener - Listener to remove
+	////////////////////////////////////////////////////
+	virtual void RemoveStateListener(IWiiRemoteStateListener *pListener) = 0;
 };
 
 #endif //_IWIIREMOTEMANAGER_H_
\ No newline at end of file
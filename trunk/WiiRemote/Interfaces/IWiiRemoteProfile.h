@@ -86,6 +86,16 @@ struct IWiiRemoteProfileVariable
 	////////////////////////////////////////////////////
 	virtual void SetRange(float min = FLT_MIN, float max = FLT_MAX) = 0;
 
+	////////////////////////////////////////////////////
+	// GetRange
+	//
+	// Purpose: Get the range of the variable (for floats)
+	//
+	// Out:	min - Minimum value
+	//		max - Maximum value
+	////////////////////////////////////////////////////
+	virtual void GetRange(float &min, float &max) const = 0;
+
 	////////////////////////////////////////////////////
 	// GetName
 	//
@@ -146,6 +156,26 @@ struct IWiiRemoteProfileVariable
 	// In:	pNode - Config file node
 	////////////////////////////////////////////////////
 	virtual void ReadFromConfig(XmlNodeRef pNode) = 0;
+
+	////////////////////////////////////////////////////
+	// WriteToEntry
+	//
+	// Purpose: Write the value to the variable's own
+	//	entry node in the config
+	//
+	// In:	pEntry - Entry node of the variable
+	////////////////////////////////////////////////////
+	virtual void WriteToEntry(XmlNodeRef &pEntry) const = 0;
+
+	////////////////////////////////////////////////////
+	// ReadFromEntry
+	//
+	// Purpose: Read the value from the variable's own
+	//	entry node in the config
+	//
+	// In:	pEntry - Entry node of the variable
+	////////////////////////////////////////////////////
+	virtual void ReadFromEntry(XmlNodeRef pEntry) = 0;
 };
 
 ////////////////////////////////////////////////////
@@ -219,7 +249,32 @@ struct IWiiRemoteProfile
 	//
 	// Returns TRUE if it was saved
 	////////////////////////////////////////////////////
-	virtual bool SaveCFG(void) const = 0;
+	virtual bool SaveCFG(void) = 0;
+
+	////////////////////////////////////////////////////
+	// StartWatching
+	//
+	// Purpose: Start watching the CFG file for changes
+	//	so it is reloaded while playing
+	////////////////////////////////////////////////////
+	virtual void StartWatching(void) = 0;
+
+	////////////////////////////////////////////////////
+	// StopWatching
+	//
+	// Purpose: Stop watching the CFG file
+	////////////////////////////////////////////////////
+	virtual void StopWatching(void) = 0;
+
+	////////////////////////////////////////////////////
+	// Update
+	//
+	// Purpose: Apply a reloaded CFG file, if one is
+	//	ready
+	//
+	// Note: Call once per frame from the game thread
+	////////////////////////////////////////////////////
+	virtual void Update(void) = 0;
 
 	////////////////////////////////////////////////////
 	// RegisterConsoleCommands
@@ -45,6 +45,12 @@ bool CBaseMotion::IsFired(void) const
 	return ((m_nMotionState & PASSED_MASK) == PASSED_MASK);
 }
 
+////////////////////////////////////////////////////
+bool CBaseMotion::IsCommitted(void) const
+{
+	return false;
+}
+
 ////////////////////////////////////////////////////
 void CBaseMotion::SetPassMask(int nMask)
 {
@@ -81,6 +87,13 @@ void CBaseMotion::OnEnd(SMotionElement const& motion, int nState)
 
 }
 
+////////////////////////////////////////////////////
+void CBaseMotion::OnCancel(int nState)
+{
+	m_nMotionState = 0;
+	m_bFired = false;
+}
+
 ////////////////////////////////////////////////////
 void CBaseMotion::Execute(void)
 {
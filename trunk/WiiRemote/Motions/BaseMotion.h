@@ -118,6 +118,16 @@ public:
 	////////////////////////////////////////////////////
 	virtual bool IsFired(void) const;
 
+	////////////////////////////////////////////////////
+	// IsCommitted
+	//
+	// Purpose: Returns TRUE if motion is certain enough
+	//	to fire before the gesture has ended
+	//
+	// Note: Motions only fire at the end by default
+	////////////////////////////////////////////////////
+	virtual bool IsCommitted(void) const;
+
 	////////////////////////////////////////////////////
 	// SetPassMask
 	//
@@ -169,6 +179,16 @@ public:
 	////////////////////////////////////////////////////
 	virtual void OnEnd(SMotionElement const& motion, int nState);
 
+	////////////////////////////////////////////////////
+	// OnCancel
+	//
+	// Purpose: Called when a speculatively started gesture
+	//	turned out not to be one
+	//
+	// In:	nState - Current active state
+	////////////////////////////////////////////////////
+	virtual void OnCancel(int nState);
+
 	////////////////////////////////////////////////////
 	// Execute
 	//
@@ -19,6 +19,7 @@
 #include "PlayerInput.h"
 
 #include "BaseMotion.h"
+#include "TemplateMotion.h"
 
 class CDropMotion : public CBaseMotion
 {
@@ -153,4 +154,5 @@ public:
 	}
 };
 
-REGISTER_MOTION(WIIMOTE, CDropMotion, CDropMotion::PASSED, 0.1f)
\ No newline at end of file
+REGISTER_MOTION(WIIMOTE, CDropMotion, CDropMotion::PASSED, 0.1f)
+REGISTER_TEMPLATE_MOTION(WIIMOTE, CDropMotion, "Drop", 0.1f)
\ No newline at end of file
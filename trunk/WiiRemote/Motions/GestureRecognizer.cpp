@@ -0,0 +1,329 @@
+////////////////////////////////////////////////////
+// Wii Remote Game File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// GestureRecognizer.cpp
+//
+// Purpose: Data-driven gesture recognition
+//	Matches recorded acceleration traces against the
+//	active motion using dynamic time warping
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#include "stdafx.h"
+#include "BaseMotion.h"
+#include "GestureRecognizer.h"
+
+CGestureRecognizer CGestureRecognizer::m_Instances[GESTURE_CONTROLLERS];
+
+////////////////////////////////////////////////////
+CGestureRecognizer::CGestureRecognizer(void)
+{
+	m_nController = WIIMOTE;
+	m_pTemplates = NULL;
+	m_nTemplates = 0;
+	m_nFed = 0;
+	m_nActive = 0;
+	m_fLastGForce = 0.0f;
+	m_bPastPeak = false;
+	m_fCommitConfidence = GESTURE_COMMIT_CONFIDENCE;
+	m_fCommitMargin = GESTURE_COMMIT_MARGIN;
+}
+
+////////////////////////////////////////////////////
+CGestureRecognizer::~CGestureRecognizer(void)
+{
+	ClearTemplates();
+}
+
+////////////////////////////////////////////////////
+CGestureRecognizer* CGestureRecognizer::GetInstance(int nController)
+{
+	if (nController < 0 || nController >= GESTURE_CONTROLLERS) return NULL;
+	m_Instances[nController].m_nController = nController;
+	return &m_Instances[nController];
+}
+
+////////////////////////////////////////////////////
+bool CGestureRecognizer::LoadTemplates(char const* szFile)
+{
+	ClearTemplates();
+
+	// Open file for reading
+	XmlNodeRef rootNode = gEnv->pSystem->LoadXmlFile(szFile);
+	if (NULL == rootNode) return false;
+
+	// Count the gestures recorded on this controller
+	char const* szController = (NUNCHUK == m_nController ? "Nunchuk" : "Wiimote");
+	int nGestureCount = rootNode->getChildCount();
+	int nCount = 0;
+	for (int nGesture = 0; nGesture < nGestureCount; nGesture++)
+	{
+		XmlNodeRef pGesture = rootNode->getChild(nGesture);
+		if (false == pGesture->isTag("Gesture")) continue;
+		if (0 != stricmp(pGesture->getAttr("controller"), szController)) continue;
+		nCount++;
+	}
+	if (0 == nCount) return true;
+	m_pTemplates = new SGestureTemplate[nCount];
+	assert(m_pTemplates);
+
+	// Read them in
+	for (int nGesture = 0; nGesture < nGestureCount; nGesture++)
+	{
+		XmlNodeRef pGesture = rootNode->getChild(nGesture);
+		if (false == pGesture->isTag("Gesture")) continue;
+		if (0 != stricmp(pGesture->getAttr("controller"), szController)) continue;
+
+		// Slot may hold a template that was rejected
+		SGestureTemplate &t = m_pTemplates[m_nTemplates];
+		t = SGestureTemplate();
+		t.szName = pGesture->getAttr("name");
+		pGesture->getAttr("state", t.nState);
+		pGesture->getAttr("threshold", t.fThreshold);
+
+		// Collect samples, decimating long recordings down to the max trace size
+		int nSampleCount = 0;
+		int nChildCount = pGesture->getChildCount();
+		for (int nChild = 0; nChild < nChildCount; nChild++)
+		{
+			if (true == pGesture->getChild(nChild)->isTag("Sample"))
+				nSampleCount++;
+		}
+		const int nSamples = MIN(nSampleCount, GESTURE_MAX_SAMPLES);
+		int nSample = 0;
+		t.nSamples = 0;
+		for (int nChild = 0; nChild < nChildCount && t.nSamples < nSamples; nChild++)
+		{
+			XmlNodeRef pSample = pGesture->getChild(nChild);
+			if (false == pSample->isTag("Sample")) continue;
+			if (nSample++ != (t.nSamples * nSampleCount) / nSamples) continue;
+			pSample->getAttr("x", t.fX[t.nSamples]);
+			pSample->getAttr("y", t.fY[t.nSamples]);
+			pSample->getAttr("z", t.fZ[t.nSamples]);
+			t.nSamples++;
+		}
+
+		if (t.nSamples < 2 || t.fThreshold <= 0.0f)
+		{
+			CryWarning(VALIDATOR_MODULE_GAME, VALIDATOR_WARNING, "Ignoring bad Wii Remote gesture \"%s\"", t.szName.c_str());
+			continue;
+		}
+		m_nTemplates++;
+	}
+
+	CryLogAlways("[WiiRemoteManager] Loaded %d %s gesture(s)", m_nTemplates, szController);
+	return true;
+}
+
+////////////////////////////////////////////////////
+void CGestureRecognizer::ClearTemplates(void)
+{
+	SAFE_DELETE_ARRAY(m_pTemplates);
+	m_nTemplates = 0;
+	m_nFed = 0;
+	m_nActive = 0;
+}
+
+////////////////////////////////////////////////////
+int CGestureRecognizer::GetGestureCount(void) const
+{
+	return m_nTemplates;
+}
+
+////////////////////////////////////////////////////
+int CGestureRecognizer::FindGesture(char const* szName) const
+{
+	for (int i = 0; i < m_nTemplates; i++)
+	{
+		if (0 == stricmp(m_pTemplates[i].szName.c_str(), szName))
+			return i;
+	}
+	return -1;
+}
+
+////////////////////////////////////////////////////
+char const* CGestureRecognizer::GetGestureName(int nID) const
+{
+	if (nID < 0 || nID >= m_nTemplates) return NULL;
+	return m_pTemplates[nID].szName.c_str();
+}
+
+////////////////////////////////////////////////////
+int CGestureRecognizer::GetGestureState(int nID) const
+{
+	if (nID < 0 || nID >= m_nTemplates) return -1;
+	return m_pTemplates[nID].nState;
+}
+
+////////////////////////////////////////////////////
+void CGestureRecognizer::Begin(void)
+{
+	for (int i = 0; i < m_nTemplates; i++)
+	{
+		m_pTemplates[i].bAbandoned = false;
+		m_pTemplates[i].fConfidence = 0.0f;
+	}
+	m_nActive = m_nTemplates;
+	m_nFed = 0;
+	m_fLastGForce = 0.0f;
+	m_bPastPeak = false;
+}
+
+////////////////////////////////////////////////////
+void CGestureRecognizer::Feed(SMotionElement const& motion)
+{
+	if (0 == m_nActive) return;
+
+	for (int i = 0; i < m_nTemplates; i++)
+	{
+		SGestureTemplate &t = m_pTemplates[i];
+		if (true == t.bAbandoned) continue;
+		ComputeLocalCost(t, motion.vAccel.x, motion.vAccel.y, motion.vAccel.z);
+
+		// Advance the cost column by one motion sample. The path is
+		//	anchored to the start of both the motion and the template
+		float fBest;
+		if (0 == m_nFed)
+		{
+			t.fCost[0] = m_fLocal[0];
+			for (int j = 1; j < t.nSamples; j++)
+				t.fCost[j] = t.fCost[j-1] + m_fLocal[j];
+			fBest = t.fCost[0];
+		}
+		else
+		{
+			float fDiag = t.fCost[0];
+			t.fCost[0] += m_fLocal[0];
+			fBest = t.fCost[0];
+			for (int j = 1; j < t.nSamples; j++)
+			{
+				const float fUp = t.fCost[j];
+				t.fCost[j] = m_fLocal[j] + MIN(MIN(fUp, fDiag), t.fCost[j-1]);
+				fDiag = fUp;
+				if (t.fCost[j] < fBest) fBest = t.fCost[j];
+			}
+		}
+
+		// Costs only grow along a path, so once every cell is past the
+		//	threshold the template can never match this motion
+		if (fBest > t.fThreshold * t.nSamples)
+		{
+			t.bAbandoned = true;
+			t.fConfidence = 0.0f;
+			m_nActive--;
+			continue;
+		}
+		t.fConfidence = MAX(0.0f, 1.0f - t.fCost[t.nSamples-1] / (t.fThreshold * t.nSamples));
+	}
+
+	// Strike lands once the acceleration starts to fall off
+	m_bPastPeak = (m_nFed > 0 && motion.fGForce < m_fLastGForce);
+	m_fLastGForce = motion.fGForce;
+	m_nFed++;
+}
+
+////////////////////////////////////////////////////
+void CGestureRecognizer::End(void)
+{
+	for (int i = 0; i < m_nTemplates; i++)
+	{
+		SGestureTemplate &t = m_pTemplates[i];
+		if (true == t.bAbandoned || 0 == m_nFed)
+		{
+			t.fConfidence = 0.0f;
+			continue;
+		}
+		t.fConfidence = MAX(0.0f, 1.0f - t.fCost[t.nSamples-1] / (t.fThreshold * t.nSamples));
+	}
+	m_nActive = 0;
+}
+
+////////////////////////////////////////////////////
+float CGestureRecognizer::GetConfidence(int nID) const
+{
+	if (nID < 0 || nID >= m_nTemplates) return 0.0f;
+	return m_pTemplates[nID].fConfidence;
+}
+
+////////////////////////////////////////////////////
+int CGestureRecognizer::GetBestGesture(int nState, float &fConfidence) const
+{
+	int nBest = -1;
+	fConfidence = 0.0f;
+	for (int i = 0; i < m_nTemplates; i++)
+	{
+		if (-1 != m_pTemplates[i].nState && nState != m_pTemplates[i].nState) continue;
+		if (m_pTemplates[i].fConfidence > fConfidence)
+		{
+			fConfidence = m_pTemplates[i].fConfidence;
+			nBest = i;
+		}
+	}
+	return nBest;
+}
+
+////////////////////////////////////////////////////
+void CGestureRecognizer::SetCommitThreshold(float fConfidence, float fMargin)
+{
+	m_fCommitConfidence = CLAMP(fConfidence, 0.0f, 1.0f);
+	m_fCommitMargin = CLAMP(fMargin, 0.0f, 1.0f);
+}
+
+////////////////////////////////////////////////////
+int CGestureRecognizer::GetCommittedGesture(int nState) const
+{
+	if (false == m_bPastPeak || 0 == m_nActive) return -1;
+
+	// Find best and runner up
+	int nBest = -1;
+	float fBest = 0.0f, fNext = 0.0f;
+	for (int i = 0; i < m_nTemplates; i++)
+	{
+		SGestureTemplate const& t = m_pTemplates[i];
+		if (true == t.bAbandoned) continue;
+		if (-1 != t.nState && nState != t.nState) continue;
+		if (t.fConfidence > fBest)
+		{
+			fNext = fBest;
+			fBest = t.fConfidence;
+			nBest = i;
+		}
+		else if (t.fConfidence > fNext)
+			fNext = t.fConfidence;
+	}
+
+	if (fBest < m_fCommitConfidence || fBest - fNext < m_fCommitMargin) return -1;
+	return nBest;
+}
+
+////////////////////////////////////////////////////
+void CGestureRecognizer::ComputeLocalCost(SGestureTemplate const& t, float fX, float fY, float fZ)
+{
+	int j = 0;
+#ifdef GESTURE_USE_SSE
+	// Four template samples at a time
+	const __m128 vX = _mm_set1_ps(fX);
+	const __m128 vY = _mm_set1_ps(fY);
+	const __m128 vZ = _mm_set1_ps(fZ);
+	for (; j + 4 <= t.nSamples; j += 4)
+	{
+		const __m128 vDX = _mm_sub_ps(_mm_loadu_ps(&t.fX[j]), vX);
+		const __m128 vDY = _mm_sub_ps(_mm_loadu_ps(&t.fY[j]), vY);
+		const __m128 vDZ = _mm_sub_ps(_mm_loadu_ps(&t.fZ[j]), vZ);
+		const __m128 vSum = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vDX,vDX), _mm_mul_ps(vDY,vDY)), _mm_mul_ps(vDZ,vDZ));
+		_mm_storeu_ps(&m_fLocal[j], vSum);
+	}
+#endif //GESTURE_USE_SSE
+
+	// Remainder
+	for (; j < t.nSamples; j++)
+	{
+		const float fDX = t.fX[j] - fX;
+		const float fDY = t.fY[j] - fY;
+		const float fDZ = t.fZ[j] - fZ;
+		m_fLocal[j] = fDX*fDX + fDY*fDY + fDZ*fDZ;
+	}
+}
\ No newline at end of file
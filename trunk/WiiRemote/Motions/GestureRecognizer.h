@@ -0,0 +1,269 @@
+////////////////////////////////////////////////////
+// Wii Remote Game File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// GestureRecognizer.h
+//
+// Purpose: Data-driven gesture recognition
+//	Matches recorded acceleration traces against the
+//	active motion using dynamic time warping
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _GESTURERECOGNIZER_H_
+#define _GESTURERECOGNIZER_H_
+
+// Use SSE for the distance computation when available
+#if defined(_M_IX86) || defined(_M_X64)
+	#define GESTURE_USE_SSE
+	#include <xmmintrin.h>
+#endif
+
+// Gesture template file
+#define GESTURE_TEMPLATE_FILE ("%USER%/wiigestures.xml")
+
+// Longest trace (in motion updates) a template can hold
+#define GESTURE_MAX_SAMPLES (64)
+
+// Default mean squared distance per sample at which a template no longer matches
+#define GESTURE_DEFAULT_THRESHOLD (0.5f)
+
+// Confidence a gesture must reach, and lead the next best by, to fire before the motion ends
+#define GESTURE_COMMIT_CONFIDENCE (0.75f)
+#define GESTURE_COMMIT_MARGIN (0.25f)
+
+// Confidence the best match must reach to fire when the motion ends
+#define GESTURE_FIRE_CONFIDENCE (0.25f)
+
+// Controllers gestures can be recorded on (see WIIMOTE and NUNCHUK)
+#define GESTURE_CONTROLLERS (2)
+
+struct SMotionElement;
+
+////////////////////////////////////////////////////
+// Gesture template
+//	Trace is stored as structure of arrays so the
+//	distance to a new sample can be taken four
+//	template samples at a time
+////////////////////////////////////////////////////
+struct SGestureTemplate
+{
+	string szName;
+	int nState;				// State the gesture is valid in, or -1 for any
+	int nSamples;			// Samples in the trace
+	float fThreshold;		// Mean squared distance per sample where confidence reaches 0
+
+	// Trace
+	float fX[GESTURE_MAX_SAMPLES];
+	float fY[GESTURE_MAX_SAMPLES];
+	float fZ[GESTURE_MAX_SAMPLES];
+
+	// Matching state for the current motion
+	float fCost[GESTURE_MAX_SAMPLES];
+	bool bAbandoned;
+	float fConfidence;
+
+	SGestureTemplate(void) : nState(-1),nSamples(0),fThreshold(GESTURE_DEFAULT_THRESHOLD),bAbandoned(true),fConfidence(0.0f) {}
+};
+
+////////////////////////////////////////////////////
+class CGestureRecognizer
+{
+protected:
+	int m_nController;
+
+	// Templates
+	SGestureTemplate *m_pTemplates;
+	int m_nTemplates;
+
+	// Current motion
+	int m_nFed;
+	int m_nActive;
+	float m_fLocal[GESTURE_MAX_SAMPLES];
+	float m_fLastGForce;
+	bool m_bPastPeak;
+
+	// Early firing
+	float m_fCommitConfidence;
+	float m_fCommitMargin;
+
+	// One per controller
+	static CGestureRecognizer m_Instances[GESTURE_CONTROLLERS];
+
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CGestureRecognizer(void);
+private:
+	CGestureRecognizer(CGestureRecognizer const&) {}
+	CGestureRecognizer& operator =(CGestureRecognizer const&) {return *this;}
+
+public:
+	////////////////////////////////////////////////////
+	// Destructor
+	////////////////////////////////////////////////////
+	virtual ~CGestureRecognizer(void);
+
+	////////////////////////////////////////////////////
+	// GetInstance
+	//
+	// Purpose: Return the recognizer for a controller
+	//
+	// In:	nController - WIIMOTE or NUNCHUK
+	////////////////////////////////////////////////////
+	static CGestureRecognizer* GetInstance(int nController);
+
+	////////////////////////////////////////////////////
+	// LoadTemplates
+	//
+	// Purpose: Load the gesture templates recorded for
+	//	this recognizer's controller
+	//
+	// In:	szFile - Template file to load
+	//
+	// Returns TRUE if the file was loaded
+	////////////////////////////////////////////////////
+	virtual bool LoadTemplates(char const* szFile);
+
+	////////////////////////////////////////////////////
+	// ClearTemplates
+	//
+	// Purpose: Remove all loaded templates
+	////////////////////////////////////////////////////
+	virtual void ClearTemplates(void);
+
+	////////////////////////////////////////////////////
+	// GetGestureCount
+	//
+	// Purpose: Returns how many templates are loaded
+	////////////////////////////////////////////////////
+	virtual int GetGestureCount(void) const;
+
+	////////////////////////////////////////////////////
+	// FindGesture
+	//
+	// Purpose: Find a gesture by name
+	//
+	// In:	szName - Name of the gesture
+	//
+	// Returns the gesture ID or -1 if not loaded
+	////////////////////////////////////////////////////
+	virtual int FindGesture(char const* szName) const;
+
+	////////////////////////////////////////////////////
+	// GetGestureName
+	//
+	// Purpose: Get the name of a gesture
+	//
+	// In:	nID - Gesture ID
+	////////////////////////////////////////////////////
+	virtual char const* GetGestureName(int nID) const;
+
+	////////////////////////////////////////////////////
+	// GetGestureState
+	//
+	// Purpose: Get the state a gesture is valid in
+	//
+	// In:	nID - Gesture ID
+	//
+	// Returns the state or -1 if valid in any state
+	////////////////////////////////////////////////////
+	virtual int GetGestureState(int nID) const;
+
+	////////////////////////////////////////////////////
+	// Begin
+	//
+	// Purpose: Reset matching for a new motion
+	////////////////////////////////////////////////////
+	virtual void Begin(void);
+
+	////////////////////////////////////////////////////
+	// Feed
+	//
+	// Purpose: Match the next motion element against
+	//	every template in a single pass
+	//
+	// In:	motion - Motion element
+	////////////////////////////////////////////////////
+	virtual void Feed(SMotionElement const& motion);
+
+	////////////////////////////////////////////////////
+	// End
+	//
+	// Purpose: Finalize the confidence of each template
+	//	for the motion that just ended
+	//
+	// Note: Until then, confidence is what the template
+	//	would score if the motion ended on the last sample
+	////////////////////////////////////////////////////
+	virtual void End(void);
+
+	////////////////////////////////////////////////////
+	// GetConfidence
+	//
+	// Purpose: Get how well a gesture matched the
+	//	current motion
+	//
+	// In:	nID - Gesture ID
+	//
+	// Returns value between 0 (no match) and 1
+	////////////////////////////////////////////////////
+	virtual float GetConfidence(int nID) const;
+
+	////////////////////////////////////////////////////
+	// GetBestGesture
+	//
+	// Purpose: Get the gesture that best matched the
+	//	current motion
+	//
+	// In:	nState - Current active state
+	//
+	// Out:	fConfidence - Confidence of the match
+	//
+	// Returns the gesture ID or -1 if none matched
+	////////////////////////////////////////////////////
+	virtual int GetBestGesture(int nState, float &fConfidence) const;
+
+	////////////////////////////////////////////////////
+	// SetCommitThreshold
+	//
+	// Purpose: Set how certain a gesture must be to fire
+	//	before the motion has ended
+	//
+	// In:	fConfidence - Confidence the gesture must reach
+	//		fMargin - Amount it must beat all others by
+	////////////////////////////////////////////////////
+	virtual void SetCommitThreshold(float fConfidence = GESTURE_COMMIT_CONFIDENCE, float fMargin = GESTURE_COMMIT_MARGIN);
+
+	////////////////////////////////////////////////////
+	// GetCommittedGesture
+	//
+	// Purpose: Get the gesture the current motion can
+	//	already be committed to
+	//
+	// In:	nState - Current active state
+	//
+	// Returns the gesture ID or -1 if not certain yet
+	//
+	// Note: Only commits once acceleration has peaked
+	////////////////////////////////////////////////////
+	virtual int GetCommittedGesture(int nState) const;
+
+protected:
+	////////////////////////////////////////////////////
+	// ComputeLocalCost
+	//
+	// Purpose: Squared distance from a sample to every
+	//	sample in a template's trace
+	//
+	// In:	t - Template
+	//		fX,fY,fZ - Sample
+	//
+	// Note: Result is stored in m_fLocal
+	////////////////////////////////////////////////////
+	virtual void ComputeLocalCost(SGestureTemplate const& t, float fX, float fY, float fZ);
+};
+
+#endif //_GESTURERECOGNIZER_H_
\ No newline at end of file
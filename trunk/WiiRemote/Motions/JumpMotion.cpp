@@ -15,6 +15,7 @@
 #include "stdafx.h"
 #include "Game.h"
 #include "BaseMotion.h"
+#include "TemplateMotion.h"
 
 class CJumpMotion : public CBaseMotion
 {
@@ -41,8 +42,8 @@ public:
 		if (nState != STATE_PLAYER && nState != STATE_BINOCULARS) return;
 
 		// Pitch must be between crouch tilt
-		float fCrouchTilt = CHECK_PROFILE_FLOAT(CrouchTilt);
-		if (motion.fPitch >= DEG2RAD(-fCrouchTilt) && motion.fPitch <= DEG2RAD(fCrouchTilt))
+		float fCrouchTilt = CHECK_PROFILE_RADIANS(CrouchTilt);
+		if (motion.fPitch >= -fCrouchTilt && motion.fPitch <= fCrouchTilt)
 			m_nMotionState |= STATE_BEGIN;
 	}
 
@@ -98,4 +99,5 @@ public:
 	}
 };
 
-REGISTER_MOTION(NUNCHUK, CJumpMotion, CJumpMotion::PASSED, 1.0f)
\ No newline at end of file
+REGISTER_MOTION(NUNCHUK, CJumpMotion, CJumpMotion::PASSED, 1.0f)
+REGISTER_TEMPLATE_MOTION(NUNCHUK, CJumpMotion, "Jump", 1.0f)
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "Item.h"
 
 #include "BaseMotion.h"
+#include "TemplateMotion.h"
 
 class CMeleeMotion : public CBaseMotion
 {
@@ -138,4 +139,5 @@ public:
 	}
 };
 
-REGISTER_MOTION(WIIMOTE, CMeleeMotion, CMeleeMotion::PASSED, 2.5f)
\ No newline at end of file
+REGISTER_MOTION(WIIMOTE, CMeleeMotion, CMeleeMotion::PASSED, 2.5f)
+REGISTER_TEMPLATE_MOTION(WIIMOTE, CMeleeMotion, "Melee", 2.5f)
\ No newline at end of file
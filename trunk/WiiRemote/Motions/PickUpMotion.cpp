@@ -18,6 +18,7 @@
 #include "Fists.h"
 
 #include "BaseMotion.h"
+#include "TemplateMotion.h"
 
 class CPickUpMotion : public CBaseMotion
 {
@@ -116,4 +117,5 @@ public:
 	}
 };
 
-REGISTER_MOTION(WIIMOTE, CPickUpMotion, CPickUpMotion::PASSED, 2.0f)
\ No newline at end of file
+REGISTER_MOTION(WIIMOTE, CPickUpMotion, CPickUpMotion::PASSED, 2.0f)
+REGISTER_TEMPLATE_MOTION(WIIMOTE, CPickUpMotion, "PickUp", 2.0f)
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "Fists.h"
 
 #include "BaseMotion.h"
+#include "TemplateMotion.h"
 
 class CPunchMotion : public CBaseMotion
 {
@@ -96,7 +97,24 @@ public:
 				m_nMotionState |= STATE_HITNG;
 		}
 		else if (motion.vAccel.y >= CHECK_PROFILE_FLOAT(PunchSensitivity))
+		{
 			m_nMotionState |= STATE_HITG;
+
+			// Fist is at full extension, check roll now so it can land here
+			if (true == CHECK_PROFILE_BOOL(EarlyMotion) && motion.fRoll > DEG2RAD(-45.0f) && motion.fRoll < DEG2RAD(45.0f))
+				m_nMotionState |= STATE_END;
+		}
+	}
+
+	////////////////////////////////////////////////////
+	// IsCommitted
+	//
+	// Purpose: Returns TRUE if motion is certain enough
+	//	to fire before the gesture has ended
+	////////////////////////////////////////////////////
+	virtual bool IsCommitted(void) const
+	{
+		return IsFired();
 	}
 
 	////////////////////////////////////////////////////
@@ -151,4 +169,5 @@ public:
 	}
 };
 
-REGISTER_MOTION(WIIMOTE, CPunchMotion, CPunchMotion::PASSED, 1.0f)
\ No newline at end of file
+REGISTER_MOTION(WIIMOTE, CPunchMotion, CPunchMotion::PASSED, 1.0f)
+REGISTER_TEMPLATE_MOTION(WIIMOTE, CPunchMotion, "Punch", 1.0f)
\ No newline at end of file
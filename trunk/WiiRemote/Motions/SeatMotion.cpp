@@ -18,6 +18,7 @@
 #include "IVehicleSystem.h"
 
 #include "BaseMotion.h"
+#include "TemplateMotion.h"
 
 class CSeatNextMotion : public CBaseMotion
 {
@@ -308,4 +309,6 @@ public:
 };
 
 REGISTER_MOTION(WIIMOTE, CSeatNextMotion, CSeatNextMotion::PASSED, 0.50f)
-REGISTER_MOTION(WIIMOTE, CSeatPrevMotion, CSeatPrevMotion::PASSED, 0.51f)
\ No newline at end of file
+REGISTER_MOTION(WIIMOTE, CSeatPrevMotion, CSeatPrevMotion::PASSED, 0.51f)
+REGISTER_TEMPLATE_MOTION(WIIMOTE, CSeatNextMotion, "SeatNext", 0.50f)
+REGISTER_TEMPLATE_MOTION(WIIMOTE, CSeatPrevMotion, "SeatPrev", 0.51f)
\ No newline at end of file
@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////
+// Wii Remote Game File
+// Copyright (C), RenEvo Software & Designs, 2007
+//
+// TemplateMotion.h
+//
+// Purpose: Motion fired by the gesture recognizer
+//	Reuses the behavior of a coded motion, but is
+//	matched against a recorded gesture template
+//
+// History:
+//	- 10/19/26 : File created - KAK
+////////////////////////////////////////////////////
+
+#ifndef _TEMPLATEMOTION_H_
+#define _TEMPLATEMOTION_H_
+
+#include "BaseMotion.h"
+#include "GestureRecognizer.h"
+
+////////////////////////////////////////////////////
+template <class T>
+class CTemplateMotion : public T
+{
+protected:
+	string m_szGesture;
+	int m_nController;
+	int m_nGesture;
+	int m_nState;
+
+public:
+	////////////////////////////////////////////////////
+	// Constructor
+	////////////////////////////////////////////////////
+	CTemplateMotion(void) : m_nController(WIIMOTE),m_nGesture(-1),m_nState(STATE_PLAYER) {}
+
+	////////////////////////////////////////////////////
+	// SetGesture
+	//
+	// Purpose: Set the gesture template this motion
+	//	is matched against
+	//
+	// In:	nController - WIIMOTE or NUNCHUK
+	//		szGesture - Name of the gesture
+	////////////////////////////////////////////////////
+	virtual void SetGesture(int nController, char const* szGesture)
+	{
+		m_nController = nController;
+		m_szGesture = szGesture;
+		m_nGesture = -1;
+	}
+
+	////////////////////////////////////////////////////
+	// IsFired
+	//
+	// Purpose: Returns TRUE if motion has fired
+	//
+	// Note: Fired when this motion's gesture is the
+	//	best match for the motion that just ended, and
+	//	is confident enough
+	////////////////////////////////////////////////////
+	virtual bool IsFired(void) const
+	{
+		if (-1 == m_nGesture) return false;
+		float fConfidence = 0.0f;
+		return (m_nGesture == CGestureRecognizer::GetInstance(m_nController)->GetBestGesture(m_nState, fConfidence) &&
+			fConfidence >= GESTURE_FIRE_CONFIDENCE);
+	}
+
+	////////////////////////////////////////////////////
+	// IsCommitted
+	//
+	// Purpose: Returns TRUE if motion is certain enough
+	//	to fire before the gesture has ended
+	////////////////////////////////////////////////////
+	virtual bool IsCommitted(void) const
+	{
+		if (-1 == m_nGesture) return false;
+		return (m_nGesture == CGestureRecognizer::GetInstance(m_nController)->GetCommittedGesture(m_nState));
+	}
+
+	////////////////////////////////////////////////////
+	// OnBegin
+	//
+	// Purpose: Called when a gesture is starting
+	//
+	// In:	motion - Motion params
+	////////////////////////////////////////////////////
+	virtual void OnBegin(SMotionElement const& motion, int nState)
+	{
+		T::OnBegin(motion, nState);
+		m_nState = nState;
+
+		// Only match when the motion itself could start here, i.e. fists are out
+		if (T::STATE_BEGIN != (T::m_nMotionState & T::STATE_BEGIN))
+		{
+			m_nGesture = -1;
+			return;
+		}
+
+		// Templates can be reloaded, so look it up each time
+		m_nGesture = CGestureRecognizer::GetInstance(m_nController)->FindGesture(m_szGesture.c_str());
+	}
+
+	////////////////////////////////////////////////////
+	// OnUpdate
+	//
+	// Purpose: Called when a gesture is updated
+	//
+	// In:	motion - Motion params
+	////////////////////////////////////////////////////
+	virtual void OnUpdate(SMotionElement const& motion, int nState)
+	{
+		T::OnUpdate(motion, nState);
+		m_nState = nState;
+	}
+
+	////////////////////////////////////////////////////
+	// OnEnd
+	//
+	// Purpose: Called when a gesture has ended
+	//
+	// In:	motion - Motion params
+	////////////////////////////////////////////////////
+	virtual void OnEnd(SMotionElement const& motion, int nState)
+	{
+		T::OnEnd(motion, nState);
+		m_nState = nState;
+	}
+
+	////////////////////////////////////////////////////
+	// OnCancel
+	//
+	// Purpose: Called when a speculatively started gesture
+	//	turned out not to be one
+	//
+	// In:	nState - Current active state
+	////////////////////////////////////////////////////
+	virtual void OnCancel(int nState)
+	{
+		T::OnCancel(nState);
+		m_nGesture = -1;
+	}
+};
+
+////////////////////////////////////////////////////
+template <class T>
+class CTemplateMotionAutoRegEntry : public CMotionAutoReg
+{
+	string m_szGesture;
+public:
+	CTemplateMotionAutoRegEntry(int nController,char const* szGesture,float fPriority) : CMotionAutoReg(nController,0,fPriority),m_szGesture(szGesture) {}
+	virtual IMotion* Create(void)
+	{
+		CTemplateMotion<T>* ret = new CTemplateMotion<T>();
+		assert(ret);
+		ret->SetGesture(m_nController, m_szGesture.c_str());
+		ret->SetPriority(m_fPriority);
+		return ret;
+	}
+};
+
+////////////////////////////////////////////////////
+// Use this define to register a motion that fires
+// from a recorded gesture instead of its own checks
+// Ex. REGISTER_TEMPLATE_MOTION(NUNCHUK, CJumpMotion, "Jump", 1.0f)
+////////////////////////////////////////////////////
+#define REGISTER_TEMPLATE_MOTION(Controller, MotionClass, Gesture, Priority) \
+	CTemplateMotionAutoRegEntry<MotionClass> g_TemplateMotionReg##MotionClass(Controller,Gesture,Priority);
+
+#endif //_TEMPLATEMOTION_H_
\ No newline at end of file
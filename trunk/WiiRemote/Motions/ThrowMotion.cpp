@@ -18,6 +18,7 @@
 #include "Fists.h"
 
 #include "BaseMotion.h"
+#include "TemplateMotion.h"
 
 class CThrowMotion : public CBaseMotion
 {
@@ -150,4 +151,5 @@ public:
 	}
 };
 
-REGISTER_MOTION(WIIMOTE, CThrowMotion, CThrowMotion::PASSED, 3.0f)
\ No newline at end of file
+REGISTER_MOTION(WIIMOTE, CThrowMotion, CThrowMotion::PASSED, 3.0f)
+REGISTER_TEMPLATE_MOTION(WIIMOTE, CThrowMotion, "Throw", 3.0f)
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "IVehicleSystem.h"
 
 #include "BaseMotion.h"
+#include "TemplateMotion.h"
 
 class CZoomInMotion : public CBaseMotion
 {
@@ -363,4 +364,6 @@ public:
 };
 
 REGISTER_MOTION(WIIMOTE, CZoomInMotion, CZoomInMotion::PASSED, 0.40f)
-REGISTER_MOTION(WIIMOTE, CZoomOutMotion, CZoomOutMotion::PASSED, 0.41f)
\ No newline at end of file
+REGISTER_MOTION(WIIMOTE, CZoomOutMotion, CZoomOutMotion::PASSED, 0.41f)
+REGISTER_TEMPLATE_MOTION(WIIMOTE, CZoomInMotion, "ZoomIn", 0.40f)
+REGISTER_TEMPLATE_MOTION(WIIMOTE, CZoomOutMotion, "ZoomOut", 0.41f)
\ No newline at end of file